@@ -35,6 +35,8 @@
 #define SSD1306_SEND_COMMAND                   0x00
 #define SSD1306_SEND_DATA                      0x40
 
+#define SSD1306_CMD_SETLOWCOLUMN               0x00
+#define SSD1306_CMD_SETHIGHCOLUMN              0x10
 #define SSD1306_CMD_SETADDRESSINGMODE          0x20
 #define SSD1306_CMD_SETCOLUMNADDRESS           0x21
 #define SSD1306_CMD_SETPAGEADDRESS             0x22
@@ -52,6 +54,7 @@
 #define SSD1306_CMD_SETIREF                    0xAD
 #define SSD1306_CMD_DISPLAYOFF                 0xAE
 #define SSD1306_CMD_DISPLAYON                  0xAF
+#define SSD1306_CMD_SETPAGESTART               0xB0
 #define SSD1306_CMD_COMSCANDIRECTIONUP         0xC0
 #define SSD1306_CMD_COMSCANDIRECTIONDOWN       0xC8
 #define SSD1306_CMD_SETDISPLAYOFFSET           0xD3
@@ -75,9 +78,69 @@
 #define SSD1306_CMD_SETIREF_INTERNAL           0x10
 #define SSD1306_CMD_SETIREF_EXTERNAL           0x00
 
+#define SSD1306_RAM_ROWS                       64
+
+#define SSD1306_PLAN_DIMENSION                 8
+
+#define SSD1306_DEFAULT_FONT_HEIGHT            8
+
+#define SSD1306_OUTCODE_LEFT                   0x01
+#define SSD1306_OUTCODE_RIGHT                  0x02
+#define SSD1306_OUTCODE_TOP                    0x04
+#define SSD1306_OUTCODE_BOTTOM                 0x08
+
+/*!
+ * Bayer matrix 8x8 for ordered dithering.
+ */
+static const uint8_t mBayerMatrix[8][8] =
+{
+    {  0, 32,  8, 40,  2, 34, 10, 42 },
+    { 48, 16, 56, 24, 50, 18, 58, 26 },
+    { 12, 44,  4, 36, 14, 46,  6, 38 },
+    { 60, 28, 52, 20, 62, 30, 54, 22 },
+    {  3, 35, 11, 43,  1, 33,  9, 41 },
+    { 51, 19, 59, 27, 49, 17, 57, 25 },
+    { 15, 47,  7, 39, 13, 45,  5, 37 },
+    { 63, 31, 55, 23, 61, 29, 53, 21 },
+};
+
+/*!
+ * A block of display RAM to be sent, pages and columns are inclusive.
+ */
+typedef struct _SSD1306_Block_t
+{
+    uint8_t pageStart;
+    uint8_t pageEnd;
+    uint8_t colStart;
+    uint8_t colEnd;
+} SSD1306_Block_t;
+
+/*!
+ * This function updates the bus statistics, when they are enabled.
+ *
+ * \param[in]       dev: The handle of the device.
+ * \param[in] isCommand: The transaction sends commands.
+ * \param[in]    length: The number of bytes of the transaction.
+ */
+static inline void countTransaction (SSD1306_DeviceHandle_t dev, bool isCommand, uint8_t length)
+{
+#if defined (SSD1306_STATISTICS)
+    dev->statistics.transactions++;
+    if (isCommand)
+        dev->statistics.commandBytes += length;
+    else
+        dev->statistics.dataBytes += length;
+#else
+    (void)dev;
+    (void)isCommand;
+    (void)length;
+#endif
+}
+
 static inline void sendCommand (SSD1306_DeviceHandle_t dev, uint8_t command)
 {
     uint8_t cmd = command;
+    countTransaction(dev, TRUE, 1);
 
     switch (dev->protocolType)
     {
@@ -116,6 +179,7 @@ static inline void sendCommand (SSD1306_DeviceHandle_t dev, uint8_t command)
 static inline void sendData (SSD1306_DeviceHandle_t dev, uint8_t value)
 {
     uint8_t data = value;
+    countTransaction(dev, FALSE, 1);
 
     switch (dev->protocolType)
     {
@@ -151,6 +215,82 @@ static inline void sendData (SSD1306_DeviceHandle_t dev, uint8_t value)
     }
 }
 
+static inline void sendCommandArray (SSD1306_DeviceHandle_t dev, uint8_t* commands, uint8_t length)
+{
+    countTransaction(dev, TRUE, length);
+
+    switch (dev->protocolType)
+    {
+    case GDL_PROTOCOLTYPE_PARALLEL:
+        {
+
+        }
+        break;
+    case GDL_PROTOCOLTYPE_I2C:
+        {
+            uint8_t retry = 3;
+            System_Errors err = ERRORS_NO_ERROR;
+            do
+            {
+                err = Iic_writeRegister(dev->config.iicDev,
+                                        dev->address,
+                                        SSD1306_SEND_COMMAND,
+                                        IIC_REGISTERADDRESSSIZE_8BIT,
+                                        commands,
+                                        length,
+                                        100);
+                retry--;
+            } while (retry > 0 && err != ERRORS_NO_ERROR);
+        }
+        break;
+    case GDL_PROTOCOLTYPE_SPI:
+        {
+
+        }
+        break;
+    default:
+        ohiassert(0);
+    }
+}
+
+static inline void sendDataArray (SSD1306_DeviceHandle_t dev, uint8_t* data, uint8_t length)
+{
+    countTransaction(dev, FALSE, length);
+
+    switch (dev->protocolType)
+    {
+    case GDL_PROTOCOLTYPE_PARALLEL:
+        {
+
+        }
+        break;
+    case GDL_PROTOCOLTYPE_I2C:
+        {
+            uint8_t retry = 3;
+            System_Errors err = ERRORS_NO_ERROR;
+            do
+            {
+                err = Iic_writeRegister(dev->config.iicDev,
+                                        dev->address,
+                                        SSD1306_SEND_DATA,
+                                        IIC_REGISTERADDRESSSIZE_8BIT,
+                                        data,
+                                        length,
+                                        100);
+                retry--;
+            } while (retry > 0 && err != ERRORS_NO_ERROR);
+        }
+        break;
+    case GDL_PROTOCOLTYPE_SPI:
+        {
+
+        }
+        break;
+    default:
+        ohiassert(0);
+    }
+}
+
 /*!
  * Sets Internal Iref
  *
@@ -178,158 +318,574 @@ static void setExternalIref (SSD1306_DeviceHandle_t dev)
 }
 
 /*!
- * This function specifies page start address and end address of the display data RAM.
+ * This function computes the cost of sending a block of display RAM with the
+ * selected addressing mode, following the cost model of the transport.
  *
- * \param[in]   dev: The handle of the device.
- * \param[in] start: The page start address.
- * \param[in]   end: The page end address.
+ * \param[in]      dev: The handle of the device.
+ * \param[in]    block: The block to be sent.
+ * \param[in]     mode: The addressing mode.
+ * \param[in] isSwitch: The addressing mode must be changed.
+ * \return The cost of the block.
  */
-static void setPageAddress (SSD1306_DeviceHandle_t dev, uint8_t start, uint8_t end)
+static uint32_t getBlockCost (SSD1306_DeviceHandle_t dev,
+                              const SSD1306_Block_t* block,
+                              uint8_t mode,
+                              bool isSwitch)
 {
-    sendCommand(dev,SSD1306_CMD_SETPAGEADDRESS);
-    sendCommand(dev,start);
-    sendCommand(dev,end);
+    uint16_t pages    = block->pageEnd - block->pageStart + 1;
+    uint16_t bytes    = pages * (block->colEnd - block->colStart + 1);
+    uint16_t commands = isSwitch ? 2 : 0;
+    uint16_t transactions;
+
+    switch (mode)
+    {
+    case SSD1306_ADDRESSING_PAGE_MODE:
+        // Page and column for each page, then its data
+        commands    += 3 * pages;
+        transactions = 2 * pages;
+        break;
+    case SSD1306_ADDRESSING_VERTICAL_MODE:
+        // Window, then the data column by column into few transactions
+        commands    += 6;
+        transactions = 1 + (bytes + SSD1306_MAX_DISPLAY_WIDTH - 1) / SSD1306_MAX_DISPLAY_WIDTH;
+        break;
+    default:
+        // Window, then the data page by page
+        commands    += 6;
+        transactions = 1 + pages;
+        break;
+    }
+
+    return (uint32_t)transactions * dev->cost.transaction +
+           (uint32_t)commands * dev->cost.command +
+           (uint32_t)bytes * dev->cost.data;
 }
 
 /*!
- * This function specifies column start address and end address of the display data RAM.
+ * This function chooses the cheapest addressing mode for a block.
  *
  * \param[in]   dev: The handle of the device.
- * \param[in] start: The column start address.
- * \param[in]   end: The column end address.
+ * \param[in] block: The block to be sent.
+ * \param[out] cost: The cost of the block with the chosen mode, or NULL.
+ * \return The addressing mode.
  */
-static void setColumnAddress (SSD1306_DeviceHandle_t dev, uint8_t start, uint8_t end)
+static uint8_t getBlockMode (SSD1306_DeviceHandle_t dev, const SSD1306_Block_t* block, uint32_t* cost)
 {
-    sendCommand(dev,SSD1306_CMD_SETCOLUMNADDRESS);
-    sendCommand(dev,start);
-    sendCommand(dev,end);
+    static const uint8_t modes[] =
+    {
+        SSD1306_ADDRESSING_HORIZONTAL_MODE,
+        SSD1306_ADDRESSING_VERTICAL_MODE,
+        SSD1306_ADDRESSING_PAGE_MODE,
+    };
+
+    // The current mode is the first choice, when the costs are equal
+    uint8_t best = dev->addressingMode;
+    uint32_t bestCost = getBlockCost(dev, block, best, FALSE);
+
+    for (uint8_t i = 0; i < sizeof(modes); ++i)
+    {
+        uint32_t value = getBlockCost(dev, block, modes[i], (modes[i] != dev->addressingMode));
+        if (value < bestCost)
+        {
+            best     = modes[i];
+            bestCost = value;
+        }
+    }
+
+    if (cost != NULL) *cost = bestCost;
+    return best;
 }
 
-void SSD1306_init (SSD1306_DeviceHandle_t dev, SSD1306_Config_t* config)
+/*!
+ * This function sends a block of the local buffer with the cheapest
+ * addressing mode. The buffer is addressed with display RAM rows, without
+ * start line remap.
+ *
+ * \param[in]   dev: The handle of the device.
+ * \param[in] block: The block to be sent.
+ */
+static void sendBlock (SSD1306_DeviceHandle_t dev, const SSD1306_Block_t* block)
 {
-    ohiassert (config != NULL);
-    if (config == NULL)
+    uint8_t commands[8];
+    uint8_t count = 0;
+    uint8_t length = block->colEnd - block->colStart + 1;
+
+    uint8_t mode = getBlockMode(dev, block, NULL);
+    if (mode != dev->addressingMode)
     {
-        return;
+        commands[count++] = SSD1306_CMD_SETADDRESSINGMODE;
+        commands[count++] = mode;
+        dev->addressingMode = mode;
     }
-    else
+
+    if (mode == SSD1306_ADDRESSING_PAGE_MODE)
     {
-        // Initialize the device pointer
-        memset(dev, 0, sizeof (SSD1306_Device_t));
-        // Save current configuration
-        dev->config = *config;
+        for (uint8_t page = block->pageStart; page <= block->pageEnd; ++page)
+        {
+            commands[count++] = SSD1306_CMD_SETPAGESTART | page;
+            commands[count++] = SSD1306_CMD_SETLOWCOLUMN | (block->colStart & 0x0F);
+            commands[count++] = SSD1306_CMD_SETHIGHCOLUMN | (block->colStart >> 4);
+            sendCommandArray(dev, commands, count);
+            count = 0;
+
+            sendDataArray(dev, &dev->buffer[(uint16_t)page * dev->gdl.width + block->colStart], length);
+        }
+        return;
     }
 
-    // Set the device model
-    dev->gdl.model = (uint8_t)((dev->config.product & 0xFF00) >> 8);
+    // Set the window
+    commands[count++] = SSD1306_CMD_SETCOLUMNADDRESS;
+    commands[count++] = block->colStart;
+    commands[count++] = block->colEnd;
+    commands[count++] = SSD1306_CMD_SETPAGEADDRESS;
+    commands[count++] = block->pageStart;
+    commands[count++] = block->pageEnd;
+    sendCommandArray(dev, commands, count);
 
-    // Save device informations
-    switch (dev->config.product)
+    if (mode == SSD1306_ADDRESSING_HORIZONTAL_MODE)
     {
-    case SSD1306_PRODUCT_ADAFRUIT_931:
-        dev->gdl.height   = 32;
-        dev->gdl.width    = 128;
-        dev->page         = 4;
-        dev->column       = 128;
-        dev->protocolType = GDL_PROTOCOLTYPE_I2C;
-        dev->address      = 0x3C;
-        break;
-    case SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1:
-        dev->gdl.height   = 64;
-        dev->gdl.width    = 128;
-        dev->page         = 8;
-        dev->column       = 128;
-        dev->protocolType = GDL_PROTOCOLTYPE_I2C;
-        dev->address      = 0x3C;
-        break;
-    default:
-        ohiassert(0);
-        break;
+        for (uint8_t page = block->pageStart; page <= block->pageEnd; ++page)
+        {
+            sendDataArray(dev, &dev->buffer[(uint16_t)page * dev->gdl.width + block->colStart], length);
+        }
     }
+    else
+    {
+        // The data are collected column by column
+        uint8_t data[SSD1306_MAX_DISPLAY_WIDTH];
+        uint8_t size = 0;
 
-    // Save default font size
-    dev->gdl.useCustomFont = FALSE;
+        for (uint8_t column = block->colStart; column <= block->colEnd; ++column)
+        {
+            for (uint8_t page = block->pageStart; page <= block->pageEnd; ++page)
+            {
+                data[size++] = dev->buffer[(uint16_t)page * dev->gdl.width + column];
+                if (size == sizeof(data))
+                {
+                    sendDataArray(dev, data, size);
+                    size = 0;
+                }
+            }
+        }
+        if (size > 0)
+        {
+            sendDataArray(dev, data, size);
+        }
+    }
+}
 
-    // Save callback for drawing pixel
-    dev->gdl.drawPixel = SSD1306_drawPixel;
-    memset(dev->buffer, 0x00, SSD1306_BUFFER_DIMENSION);
+/*!
+ * This function adds a block to the flush plan. The blocks are merged while
+ * sending their bounding box is cheaper than sending them one by one; when
+ * the plan is full, the pair with the cheapest merge is merged anyway.
+ *
+ * \param[in]     dev: The handle of the device.
+ * \param[in]    plan: The blocks of the plan.
+ * \param[in]   count: The number of blocks of the plan.
+ * \param[in]   block: The new block.
+ * \return The new number of blocks of the plan.
+ */
+static uint8_t addBlock (SSD1306_DeviceHandle_t dev,
+                         SSD1306_Block_t* plan,
+                         uint8_t count,
+                         const SSD1306_Block_t* block)
+{
+    bool isFull = (count == SSD1306_PLAN_DIMENSION);
+    if (!isFull)
+    {
+        plan[count++] = *block;
+    }
 
-    // Configure periphearl and pins
-    switch (dev->protocolType)
+    while (count > 1)
     {
-    case GDL_PROTOCOLTYPE_PARALLEL:
+        bool isFound = FALSE;
+        int32_t bestSaving = 0;
+        uint8_t first = 0, second = 0;
+        SSD1306_Block_t merged, bestMerged = {0};
+
+        for (uint8_t i = 0; i < count; ++i)
         {
-            // TODO
+            for (uint8_t j = i + 1; j < count; ++j)
+            {
+                uint32_t costA, costB, costMerged;
+                getBlockMode(dev, &plan[i], &costA);
+                getBlockMode(dev, &plan[j], &costB);
+
+                merged.pageStart = (plan[i].pageStart < plan[j].pageStart) ? plan[i].pageStart : plan[j].pageStart;
+                merged.pageEnd   = (plan[i].pageEnd > plan[j].pageEnd) ? plan[i].pageEnd : plan[j].pageEnd;
+                merged.colStart  = (plan[i].colStart < plan[j].colStart) ? plan[i].colStart : plan[j].colStart;
+                merged.colEnd    = (plan[i].colEnd > plan[j].colEnd) ? plan[i].colEnd : plan[j].colEnd;
+                getBlockMode(dev, &merged, &costMerged);
+
+                int32_t saving = (int32_t)(costA + costB) - (int32_t)costMerged;
+                if (!isFound || (saving > bestSaving))
+                {
+                    isFound    = TRUE;
+                    bestSaving = saving;
+                    bestMerged = merged;
+                    first      = i;
+                    second     = j;
+                }
+            }
         }
-        break;
-    case GDL_PROTOCOLTYPE_I2C:
+
+        if ((bestSaving < 0) && !isFull)
+            break;
+
+        plan[first]  = bestMerged;
+        plan[second] = plan[--count];
+
+        if (isFull)
         {
-            ohiassert(dev->config.iicDev != NULL);
-            Iic_init(dev->config.iicDev, &dev->config.iicConfig);
+            // Now there is room for the new block
+            plan[count++] = *block;
+            isFull = FALSE;
         }
-        break;
-    case GDL_PROTOCOLTYPE_SPI:
+    }
+    return count;
+}
+
+/*!
+ * This function fills a rectangular area of the local buffer, one byte for
+ * each column of each page. The area must be already clipped.
+ *
+ * \param[in]    dev: The handle of the device.
+ * \param[in] xStart: The first column of the area.
+ * \param[in]  xStop: The first column after the area.
+ * \param[in] yStart: The first line of the area.
+ * \param[in]  yStop: The first line after the area.
+ * \param[in]  color: The color of the area.
+ */
+static void fillArea (SSD1306_DeviceHandle_t dev,
+                      uint8_t xStart,
+                      uint8_t xStop,
+                      uint8_t yStart,
+                      uint8_t yStop,
+                      SSD1306_Color_t color)
+{
+#if defined (SSD1306_REFERENCE_RENDERER)
+    // The area is already clipped, so the clip area is opened for the pixels
+    SSD1306_Clip_t clip = dev->clip;
+    dev->clip.xStart = 0;
+    dev->clip.yStart = 0;
+    dev->clip.xStop  = dev->gdl.width;
+    dev->clip.yStop  = dev->gdl.height;
+
+    for (uint8_t y = yStart; y < yStop; ++y)
+    {
+        for (uint8_t x = xStart; x < xStop; ++x)
         {
-            // TODO
+            SSD1306_drawPixel(dev, x, y, color);
         }
-        break;
-    default:
-        ohiassert(0);
     }
-    // setup reset pin
-    if (dev->config.rstPin != GPIO_PINS_NONE)
+
+    dev->clip = clip;
+#else
+    // Remap the row into the display RAM circular buffer
+    uint8_t row   = (yStart + dev->startLine) & (SSD1306_RAM_ROWS - 1);
+    uint8_t count = yStop - yStart;
+
+    while (count > 0)
     {
-        Gpio_config(dev->config.rstPin,GPIO_PINS_OUTPUT);
+        uint8_t shift = row % 8;
+        uint8_t bits  = ((8 - shift) < count) ? (8 - shift) : count;
+        uint8_t mask  = (uint8_t)(((1u << bits) - 1) << shift);
+        uint8_t* data = &dev->buffer[(uint16_t)(row / 8) * dev->gdl.width];
 
-        // Reset sequence
-        Gpio_set(dev->config.rstPin);
-        System_delay(1);
-        Gpio_clear(dev->config.rstPin);
-        System_delay(10);
-        Gpio_set(dev->config.rstPin);
+        if (color == SSD1306_COLOR_COLOR)
+        {
+            for (uint8_t x = xStart; x < xStop; ++x) data[x] |= mask;
+        }
+        else
+        {
+            for (uint8_t x = xStart; x < xStop; ++x) data[x] &= ~mask;
+        }
+
+        row    = (row + bits) & (SSD1306_RAM_ROWS - 1);
+        count -= bits;
     }
+#endif
+}
 
-    // Starting init procedure
-    // Turn off the display
-    sendCommand(dev,SSD1306_CMD_DISPLAYOFF);
-    System_delay(10);
+/*!
+ * This function clips a rectangular area with the current clip area.
+ *
+ * \param[in]        dev: The handle of the device.
+ * \param[in,out] xStart: The first column of the area.
+ * \param[in,out]  xStop: The first column after the area.
+ * \param[in,out] yStart: The first line of the area.
+ * \param[in,out]  yStop: The first line after the area.
+ * \return TRUE if some part of the area is inside the clip area, FALSE otherwise.
+ */
+static bool clipArea (SSD1306_DeviceHandle_t dev,
+                      uint32_t* xStart,
+                      uint32_t* xStop,
+                      uint32_t* yStart,
+                      uint32_t* yStop)
+{
+    if (*xStart < dev->clip.xStart) *xStart = dev->clip.xStart;
+    if (*yStart < dev->clip.yStart) *yStart = dev->clip.yStart;
+    if (*xStop > dev->clip.xStop)   *xStop  = dev->clip.xStop;
+    if (*yStop > dev->clip.yStop)   *yStop  = dev->clip.yStop;
 
-    // Set display offset to NO OFFSET
-    sendCommand(dev,SSD1306_CMD_SETDISPLAYOFFSET);
-    sendCommand(dev,0x00);
-    // Set display start line to first
-    sendCommand(dev,SSD1306_CMD_SETDISPLAYSTARTLINE | 0x00);
+    return (*xStart < *xStop) && (*yStart < *yStop);
+}
 
-    // Set addressing mode to HORIZONTAL - it is the DEAFULT!
-    sendCommand(dev,SSD1306_CMD_SETADDRESSINGMODE);
-    sendCommand(dev,SSD1306_ADDRESSING_HORIZONTAL_MODE);
+/*!
+ * This function fills a rectangular area of the local buffer, after clipping
+ * it with the current clip area.
+ *
+ * \param[in]    dev: The handle of the device.
+ * \param[in]   xPos: The x position of the top-left corner.
+ * \param[in]   yPos: The y position of the top-left corner.
+ * \param[in]  width: The width of the area.
+ * \param[in] height: The height of the area.
+ * \param[in]  color: The color of the area.
+ */
+static void fillClippedArea (SSD1306_DeviceHandle_t dev,
+                             uint32_t xPos,
+                             uint32_t yPos,
+                             uint32_t width,
+                             uint32_t height,
+                             SSD1306_Color_t color)
+{
+    uint32_t xStop = xPos + width;
+    uint32_t yStop = yPos + height;
 
-    // Select segment re-map, COM scan direction, COM hardware configuration and
-    // de-select level
-    // They depend on producer choice
-    switch (dev->config.product)
+    if (clipArea(dev, &xPos, &xStop, &yPos, &yStop))
     {
-    case SSD1306_PRODUCT_ADAFRUIT_931:
-        sendCommand(dev,SSD1306_CMD_SEGMENTREMAP | 0x01);
-        sendCommand(dev,SSD1306_CMD_COMSCANDIRECTIONDOWN);
-        sendCommand(dev,SSD1306_CMD_COMPINS);
-        sendCommand(dev,SSD1306_CMD_COMPINS_COMMON_BASE);
+        fillArea(dev, xPos, xStop, yPos, yStop, color);
+    }
+}
 
-        // Set internal clock div to default value
-        sendCommand(dev,SSD1306_CMD_SETDISPLAYCLK);
-        sendCommand(dev,0x80);
+/*!
+ * This function sends segment re-map and COM scan direction, computed from
+ * the product choice and the current orientation.
+ *
+ * \param[in] dev: The handle of the device.
+ */
+static void sendOrientation (SSD1306_DeviceHandle_t dev)
+{
+    bool isMirrorX = (dev->orientation & SSD1306_ORIENTATION_MIRROR_X) != 0;
+    bool isMirrorY = (dev->orientation & SSD1306_ORIENTATION_MIRROR_Y) != 0;
 
-        // Set Multiplex ratio
-        sendCommand(dev,SSD1306_CMD_SETMUXRATIO);
-        sendCommand(dev,dev->gdl.height-1);
+    sendCommand(dev,SSD1306_CMD_SEGMENTREMAP | ((dev->isSegmentRemap != isMirrorX) ? 0x01 : 0x00));
+    sendCommand(dev,(dev->isComScanDown != isMirrorY) ? SSD1306_CMD_COMSCANDIRECTIONDOWN :
+                                                        SSD1306_CMD_COMSCANDIRECTIONUP);
+}
 
-        dev->isChargePump = TRUE;
-        break;
-    case SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1:
+/*!
+ * This function transposes a block of 8x8 pixels: the bit k of the column i
+ * becomes the bit i of the column k.
+ *
+ * \param[in]  in: The 8 columns of the block.
+ * \param[out] out: The 8 columns of the transposed block.
+ */
+static void transposeBlock (const uint8_t* in, uint8_t* out)
+{
+    uint32_t lo = (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+    uint32_t hi = (uint32_t)in[4] | ((uint32_t)in[5] << 8) | ((uint32_t)in[6] << 16) | ((uint32_t)in[7] << 24);
+    uint32_t t;
+
+    // Swap 1x1 blocks into 2x2 blocks
+    t = (lo ^ (lo >> 7)) & 0x00AA00AAul; lo ^= t ^ (t << 7);
+    t = (hi ^ (hi >> 7)) & 0x00AA00AAul; hi ^= t ^ (t << 7);
+    // Swap 2x2 blocks into 4x4 blocks
+    t = (lo ^ (lo >> 14)) & 0x0000CCCCul; lo ^= t ^ (t << 14);
+    t = (hi ^ (hi >> 14)) & 0x0000CCCCul; hi ^= t ^ (t << 14);
+    // Swap 4x4 blocks
+    t = ((lo >> 4) ^ hi) & 0x0F0F0F0Ful; hi ^= t; lo ^= (t << 4);
+
+    for (uint8_t i = 0; i < 4; ++i)
+    {
+        out[i]   = (uint8_t)(lo >> (8 * i));
+        out[i+4] = (uint8_t)(hi >> (8 * i));
+    }
+}
+
+/*!
+ * This function rotates a block of 8x8 pixels by 90 degrees.
+ *
+ * \param[in]   in: The 8 columns of the block.
+ * \param[out] out: The 8 columns of the rotated block.
+ * \param[in]  isCw: TRUE for clockwise rotation, FALSE otherwise.
+ */
+static void rotateBlock (const uint8_t* in, uint8_t* out, bool isCw)
+{
+    uint8_t tmp[8];
+
+    if (isCw)
+    {
+        transposeBlock(in, tmp);
+        for (uint8_t i = 0; i < 8; ++i) out[i] = tmp[7-i];
+    }
+    else
+    {
+        for (uint8_t i = 0; i < 8; ++i) tmp[i] = in[7-i];
+        transposeBlock(tmp, out);
+    }
+}
+
+/*!
+ * This function rotates by 90 degrees a square area of the buffer, moving one
+ * block of 8x8 pixels at time along its cycle of four positions.
+ *
+ * \param[in]  dev: The handle of the device.
+ * \param[in] xPos: The x position of the top-left corner.
+ * \param[in] yPos: The y position of the top-left corner.
+ * \param[in] size: The side of the area, multiple of 8.
+ * \param[in] isCw: TRUE for clockwise rotation, FALSE otherwise.
+ */
+static void rotateArea90 (SSD1306_DeviceHandle_t dev,
+                          uint8_t xPos,
+                          uint8_t yPos,
+                          uint8_t size,
+                          bool isCw)
+{
+    uint8_t blocks = size / 8;
+    uint8_t in[4][8];
+    uint8_t out[8];
+    uint8_t bx[4], by[4];
+
+    for (uint8_t x = 0; x < (blocks + 1) / 2; ++x)
+    {
+        for (uint8_t y = 0; y < blocks / 2; ++y)
+        {
+            // Positions of the cycle, every block moves to the next position
+            bx[0] = x;
+            by[0] = y;
+            for (uint8_t k = 1; k < 4; ++k)
+            {
+                bx[k] = isCw ? (blocks - 1 - by[k-1]) : by[k-1];
+                by[k] = isCw ? bx[k-1] : (blocks - 1 - bx[k-1]);
+            }
+
+            for (uint8_t k = 0; k < 4; ++k)
+                for (uint8_t i = 0; i < 8; ++i)
+                    in[k][i] = SSD1306_readColumn(dev, xPos + bx[k]*8 + i, yPos + by[k]*8);
+
+            for (uint8_t k = 0; k < 4; ++k)
+            {
+                uint8_t next = (k + 1) % 4;
+                rotateBlock(in[k], out, isCw);
+                for (uint8_t i = 0; i < 8; ++i)
+                    SSD1306_writeColumn(dev, xPos + bx[next]*8 + i, yPos + by[next]*8, out[i], 0xFF);
+            }
+        }
+    }
+
+    // The center block, when the number of blocks is odd, rotates in place
+    if (blocks % 2)
+    {
+        uint8_t center = (blocks / 2) * 8;
+        for (uint8_t i = 0; i < 8; ++i)
+            in[0][i] = SSD1306_readColumn(dev, xPos + center + i, yPos + center);
+        rotateBlock(in[0], out, isCw);
+        for (uint8_t i = 0; i < 8; ++i)
+            SSD1306_writeColumn(dev, xPos + center + i, yPos + center, out[i], 0xFF);
+    }
+}
+
+/*!
+ * This function rotates by 180 degrees a square area of the buffer, swapping
+ * every block of 8x8 pixels with its opposite one. All columns are read
+ * before they are written, so the clip area changes only the written pixels.
+ *
+ * \param[in]  dev: The handle of the device.
+ * \param[in] xPos: The x position of the top-left corner.
+ * \param[in] yPos: The y position of the top-left corner.
+ * \param[in] size: The side of the area, multiple of 8.
+ */
+static void rotateArea180 (SSD1306_DeviceHandle_t dev,
+                           uint8_t xPos,
+                           uint8_t yPos,
+                           uint8_t size)
+{
+    uint8_t blocks = size / 8;
+    uint16_t total = (uint16_t)blocks * blocks;
+    uint8_t in[2][8];
+    uint8_t bx[2], by[2];
+
+    for (uint16_t n = 0; n < (total + 1) / 2; ++n)
+    {
+        // The block and its opposite, the same one for the center block
+        bx[0] = n % blocks;
+        by[0] = n / blocks;
+        bx[1] = blocks - 1 - bx[0];
+        by[1] = blocks - 1 - by[0];
+
+        for (uint8_t k = 0; k < 2; ++k)
+            for (uint8_t i = 0; i < 8; ++i)
+                in[k][i] = SSD1306_readColumn(dev, xPos + bx[k]*8 + i, yPos + by[k]*8);
+
+        for (uint8_t k = 0; k < 2; ++k)
+        {
+            for (uint8_t i = 0; i < 8; ++i)
+            {
+                // Mirrored columns, with the bits of every column reversed
+                uint8_t column = in[1-k][7-i];
+                column = (uint8_t)(((column & 0xF0) >> 4) | ((column & 0x0F) << 4));
+                column = (uint8_t)(((column & 0xCC) >> 2) | ((column & 0x33) << 2));
+                column = (uint8_t)(((column & 0xAA) >> 1) | ((column & 0x55) << 1));
+                SSD1306_writeColumn(dev, xPos + bx[k]*8 + i, yPos + by[k]*8, column, 0xFF);
+            }
+        }
+    }
+}
+
+/*!
+ * This function sends the whole configuration of the driver, computed from
+ * the product choice and the current state of the device.
+ * The display is left OFF.
+ *
+ * \param[in] dev: The handle of the device.
+ */
+static void sendConfiguration (SSD1306_DeviceHandle_t dev)
+{
+    // Turn off the display
+    sendCommand(dev,SSD1306_CMD_DISPLAYOFF);
+    System_delay(10);
+
+    // Set display offset to NO OFFSET
+    sendCommand(dev,SSD1306_CMD_SETDISPLAYOFFSET);
+    sendCommand(dev,0x00);
+    // Set display start line, first line after reset
+    sendCommand(dev,SSD1306_CMD_SETDISPLAYSTARTLINE | dev->startLine);
+    dev->isStartLineChanged = FALSE;
+
+    // Set addressing mode to HORIZONTAL - it is the DEAFULT!
+    sendCommand(dev,SSD1306_CMD_SETADDRESSINGMODE);
+    sendCommand(dev,SSD1306_ADDRESSING_HORIZONTAL_MODE);
+    dev->addressingMode = SSD1306_ADDRESSING_HORIZONTAL_MODE;
+
+    // Select segment re-map, COM scan direction, COM hardware configuration and
+    // de-select level
+    // They depend on producer choice
+    switch (dev->config.product)
+    {
+    case SSD1306_PRODUCT_ADAFRUIT_931:
+        dev->isSegmentRemap = TRUE;
+        dev->isComScanDown  = TRUE;
+        sendOrientation(dev);
+        sendCommand(dev,SSD1306_CMD_COMPINS);
+        sendCommand(dev,SSD1306_CMD_COMPINS_COMMON_BASE);
+
+        // Set internal clock div to default value
+        sendCommand(dev,SSD1306_CMD_SETDISPLAYCLK);
+        sendCommand(dev,0x80);
+
+        // Set Multiplex ratio
+        sendCommand(dev,SSD1306_CMD_SETMUXRATIO);
+        sendCommand(dev,dev->gdl.height-1);
+
+        dev->isChargePump = TRUE;
+        break;
+    case SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1:
         // column address 0 is mapped to SEG0 (Reset)
-        sendCommand(dev,SSD1306_CMD_SEGMENTREMAP | 0x00);
+        dev->isSegmentRemap = FALSE;
         // row address 0 is mapped to COM0 (Reset)
-        sendCommand(dev,SSD1306_CMD_COMSCANDIRECTIONUP);
+        dev->isComScanDown  = FALSE;
+        sendOrientation(dev);
         sendCommand(dev,SSD1306_CMD_COMPINS);
         sendCommand(dev,SSD1306_CMD_COMPINS_COMMON_BASE        |
                         SSD1306_CMD_COMPINS_COMMON_ALTERNATIVE |
@@ -353,12 +909,11 @@ void SSD1306_init (SSD1306_DeviceHandle_t dev, SSD1306_Config_t* config)
         break;
     }
 
-    // Set contrast to default value
-    sendCommand(dev,SSD1306_CMD_SETCONTRAST);
-    sendCommand(dev,0x8F);
+    // Set contrast, default value after reset
+    SSD1306_setContrast(dev,dev->contrast);
 
-    // Set normal display
-    sendCommand(dev,SSD1306_CMD_DISPLAYNORMAL);
+    // Set normal or inverse display, normal after reset
+    sendCommand(dev,dev->isInverse ? SSD1306_CMD_DISPLAYINVERSE : SSD1306_CMD_DISPLAYNORMAL);
 
 
 #if 0
@@ -374,11 +929,114 @@ void SSD1306_init (SSD1306_DeviceHandle_t dev, SSD1306_Config_t* config)
     }
 #endif
 
-    // Disable scrolling... by default!
-    SSD1306_scroll(dev, FALSE);
+    // Set scrolling, disabled by default!
+    SSD1306_scroll(dev, dev->isScrolling);
 
     // Enable display on with RAM content
     sendCommand(dev,SSD1306_CMD_DISPLAYONRAM);
+}
+
+void SSD1306_init (SSD1306_DeviceHandle_t dev, SSD1306_Config_t* config)
+{
+    ohiassert (config != NULL);
+    if (config == NULL)
+    {
+        return;
+    }
+    else
+    {
+        // Initialize the device pointer
+        memset(dev, 0, sizeof (SSD1306_Device_t));
+        // Save current configuration
+        dev->config = *config;
+    }
+
+    // Set the device model
+    dev->gdl.model = (uint8_t)((dev->config.product & 0xFF00) >> 8);
+
+    // Save device informations
+    switch (dev->config.product)
+    {
+    case SSD1306_PRODUCT_ADAFRUIT_931:
+        dev->gdl.height   = 32;
+        dev->gdl.width    = 128;
+        dev->page         = 4;
+        dev->column       = 128;
+        dev->protocolType = GDL_PROTOCOLTYPE_I2C;
+        dev->address      = 0x3C;
+        break;
+    case SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1:
+        dev->gdl.height   = 64;
+        dev->gdl.width    = 128;
+        dev->page         = 8;
+        dev->column       = 128;
+        dev->protocolType = GDL_PROTOCOLTYPE_I2C;
+        dev->address      = 0x3C;
+        break;
+    default:
+        ohiassert(0);
+        break;
+    }
+
+    // Save default font size
+    dev->gdl.useCustomFont = FALSE;
+
+    // Save callback for drawing pixel
+    dev->gdl.drawPixel = SSD1306_drawPixel;
+    SSD1306_resetClip(dev);
+    memset(dev->buffer, 0x00, SSD1306_BUFFER_DIMENSION);
+
+    // Configure periphearl and pins
+    switch (dev->protocolType)
+    {
+    case GDL_PROTOCOLTYPE_PARALLEL:
+        {
+            // TODO
+            dev->cost.transaction = 1;
+            dev->cost.command     = 1;
+            dev->cost.data        = 1;
+        }
+        break;
+    case GDL_PROTOCOLTYPE_I2C:
+        {
+            ohiassert(dev->config.iicDev != NULL);
+            Iic_init(dev->config.iicDev, &dev->config.iicConfig);
+
+            // Bit times: start, address, control byte and stop for each
+            // transaction, 8 bits plus acknowledge for each byte
+            dev->cost.transaction = 20;
+            dev->cost.command     = 9;
+            dev->cost.data        = 9;
+        }
+        break;
+    case GDL_PROTOCOLTYPE_SPI:
+        {
+            // TODO
+            // Bit times: chip select and D/C line for each transaction
+            dev->cost.transaction = 2;
+            dev->cost.command     = 8;
+            dev->cost.data        = 8;
+        }
+        break;
+    default:
+        ohiassert(0);
+    }
+    // setup reset pin
+    if (dev->config.rstPin != GPIO_PINS_NONE)
+    {
+        Gpio_config(dev->config.rstPin,GPIO_PINS_OUTPUT);
+
+        // Reset sequence
+        Gpio_set(dev->config.rstPin);
+        System_delay(1);
+        Gpio_clear(dev->config.rstPin);
+        System_delay(10);
+        Gpio_set(dev->config.rstPin);
+    }
+
+    // Starting init procedure
+    dev->contrast = 0x8F;
+    sendConfiguration(dev);
 
     // Turn on the display
     // FIXME: Are you shure you want the display ON?
@@ -390,19 +1048,225 @@ GDL_Errors_t SSD1306_drawPixel (SSD1306_DeviceHandle_t dev,
                                 uint8_t yPos,
                                 SSD1306_Color_t color)
 {
-    if ((xPos >= dev->gdl.width) || (yPos >= dev->gdl.height))
-        return GDL_ERRORS_WRONG_POSITION;
+    if ((xPos < dev->clip.xStart) || (xPos >= dev->clip.xStop) ||
+        (yPos < dev->clip.yStart) || (yPos >= dev->clip.yStop))
+    {
+        if ((xPos >= dev->gdl.width) || (yPos >= dev->gdl.height))
+            return GDL_ERRORS_WRONG_POSITION;
+        else
+            return GDL_ERRORS_SUCCESS;
+    }
 
-    uint16_t pos = (uint16_t) xPos + ((uint16_t) (yPos/8)*dev->gdl.width);
+    // Remap the row into the display RAM circular buffer
+    uint8_t row = (yPos + dev->startLine) & (SSD1306_RAM_ROWS - 1);
+    uint16_t pos = (uint16_t) xPos + ((uint16_t) (row/8)*dev->gdl.width);
 
     if (color == SSD1306_COLOR_COLOR)
-        dev->buffer[pos] |= (1 << (yPos%8));
+        dev->buffer[pos] |= (1 << (row%8));
     else
-        dev->buffer[pos] &= ~(1 << (yPos%8));
+        dev->buffer[pos] &= ~(1 << (row%8));
 
     return GDL_ERRORS_SUCCESS;
 }
 
+uint8_t SSD1306_readColumn (SSD1306_DeviceHandle_t dev, uint8_t xPos, uint8_t yPos)
+{
+    if ((xPos >= dev->gdl.width) || (yPos >= dev->gdl.height))
+        return 0;
+
+    // Remap the row into the display RAM circular buffer
+    uint8_t row   = (yPos + dev->startLine) & (SSD1306_RAM_ROWS - 1);
+    uint8_t shift = row % 8;
+    uint8_t* data = &dev->buffer[xPos];
+
+    uint8_t bits = data[(uint16_t)(row/8) * dev->gdl.width] >> shift;
+    if (shift != 0)
+    {
+        uint8_t next = ((row/8) + 1) % (SSD1306_RAM_ROWS/8);
+        bits |= data[(uint16_t)next * dev->gdl.width] << (8 - shift);
+    }
+
+    // Remove the rows out of the display
+    if ((dev->gdl.height - yPos) < 8)
+        bits &= (uint8_t)((1u << (dev->gdl.height - yPos)) - 1);
+
+    return bits;
+}
+
+void SSD1306_writeColumn (SSD1306_DeviceHandle_t dev,
+                          uint8_t xPos,
+                          uint8_t yPos,
+                          uint8_t bits,
+                          uint8_t mask)
+{
+#if defined (SSD1306_REFERENCE_RENDERER)
+    for (uint8_t i = 0; i < 8; ++i)
+    {
+        if (((mask >> i) & 0x01) && ((yPos + i) < dev->gdl.height))
+        {
+            SSD1306_drawPixel(dev, xPos, yPos + i, ((bits >> i) & 0x01) ? SSD1306_COLOR_COLOR : SSD1306_COLOR_BLACK);
+        }
+    }
+#else
+    if ((xPos < dev->clip.xStart) || (xPos >= dev->clip.xStop) || (yPos >= dev->clip.yStop))
+        return;
+
+    // Remove the rows out of the clip area
+    if ((dev->clip.yStop - yPos) < 8)
+        mask &= (uint8_t)((1u << (dev->clip.yStop - yPos)) - 1);
+    if (yPos < dev->clip.yStart)
+    {
+        if ((dev->clip.yStart - yPos) >= 8) return;
+        mask &= (uint8_t)(0xFFu << (dev->clip.yStart - yPos));
+    }
+
+    // Remap the row into the display RAM circular buffer
+    uint8_t row   = (yPos + dev->startLine) & (SSD1306_RAM_ROWS - 1);
+    uint8_t shift = row % 8;
+    uint8_t* data = &dev->buffer[(uint16_t)(row/8) * dev->gdl.width + xPos];
+    uint8_t m = (uint8_t)(mask << shift);
+
+    *data = (*data & ~m) | ((uint8_t)(bits << shift) & m);
+    if (shift != 0)
+    {
+        uint8_t next = ((row/8) + 1) % (SSD1306_RAM_ROWS/8);
+        data = &dev->buffer[(uint16_t)next * dev->gdl.width + xPos];
+        m    = mask >> (8 - shift);
+        *data = (*data & ~m) | ((bits >> (8 - shift)) & m);
+    }
+#endif
+}
+
+/*!
+ * This function returns the Cohen-Sutherland outcode of a point, with
+ * respect to the current clip area.
+ *
+ * \param[in] dev: The handle of the device.
+ * \param[in]   x: The x position of the point.
+ * \param[in]   y: The y position of the point.
+ * \return The sides of the clip area the point is beyond.
+ */
+static inline uint8_t getOutCode (SSD1306_DeviceHandle_t dev, int32_t x, int32_t y)
+{
+    uint8_t code = 0;
+
+    if (x < dev->clip.xStart)       code |= SSD1306_OUTCODE_LEFT;
+    else if (x >= dev->clip.xStop)  code |= SSD1306_OUTCODE_RIGHT;
+    if (y < dev->clip.yStart)       code |= SSD1306_OUTCODE_TOP;
+    else if (y >= dev->clip.yStop)  code |= SSD1306_OUTCODE_BOTTOM;
+
+    return code;
+}
+
+#if !defined (SSD1306_REFERENCE_RENDERER)
+/*!
+ * This function limits the steps of a line along one axis to the ones inside
+ * the clip area: the position at the step n is start + sign * n.
+ *
+ * \param[in,out] first: The first step to draw.
+ * \param[in,out]  last: The last step to draw.
+ * \param[in]     start: The position at the step 0.
+ * \param[in]      sign: The direction of the steps, 1 or -1.
+ * \param[in] clipStart: The first position of the clip area.
+ * \param[in]  clipStop: The position after the last one of the clip area.
+ */
+static inline void clipSteps (int32_t* first,
+                              int32_t* last,
+                              int32_t start,
+                              int32_t sign,
+                              int32_t clipStart,
+                              int32_t clipStop)
+{
+    int32_t low  = (sign > 0) ? (clipStart - start) : (start - clipStop + 1);
+    int32_t high = (sign > 0) ? (clipStop - 1 - start) : (start - clipStart);
+
+    if (low > *first) *first = low;
+    if (high < *last) *last  = high;
+}
+
+/*!
+ * This function draws a diagonal line with the Bresenham algorithm, only
+ * for the pixels inside the clip area.
+ * At the step n of the major axis, the algorithm moves the minor axis by
+ * floor((2 * n * minor + major) / (2 * major)) pixels, where major and minor
+ * are the lengths of the line along the axes: the steps inside the clip area
+ * are computed from it, and the pixels are the same of the whole line.
+ *
+ * \param[in]    dev: The handle of the device.
+ * \param[in] xStart: The x position of the first end.
+ * \param[in] yStart: The y position of the first end.
+ * \param[in]  xStop: The x position of the last end.
+ * \param[in]  yStop: The y position of the last end.
+ * \param[in]  color: The color of the line.
+ */
+static void drawClippedLine (SSD1306_DeviceHandle_t dev,
+                             int32_t xStart,
+                             int32_t yStart,
+                             int32_t xStop,
+                             int32_t yStop,
+                             SSD1306_Color_t color)
+{
+    int32_t width  = (xStop > xStart) ? (xStop - xStart) : (xStart - xStop);
+    int32_t height = (yStop > yStart) ? (yStop - yStart) : (yStart - yStop);
+    bool isSteep   = height > width;
+
+    int32_t majorStart = isSteep ? yStart : xStart;
+    int32_t minorStart = isSteep ? xStart : yStart;
+    int32_t major      = isSteep ? height : width;
+    int32_t minor      = isSteep ? width : height;
+    int32_t majorSign  = ((isSteep ? yStop : xStop) > majorStart) ? 1 : -1;
+    int32_t minorSign  = ((isSteep ? xStop : yStop) > minorStart) ? 1 : -1;
+
+    int32_t majorClipStart = isSteep ? dev->clip.yStart : dev->clip.xStart;
+    int32_t majorClipStop  = isSteep ? dev->clip.yStop  : dev->clip.xStop;
+    int32_t minorClipStart = isSteep ? dev->clip.xStart : dev->clip.yStart;
+    int32_t minorClipStop  = isSteep ? dev->clip.xStop  : dev->clip.yStop;
+
+    // The steps inside the clip area along the major axis
+    int32_t first = 0;
+    int32_t last  = major;
+    clipSteps(&first, &last, majorStart, majorSign, majorClipStart, majorClipStop);
+
+    // The moves inside the clip area along the minor axis, then the steps
+    // that give them: the moves grow with the steps
+    int32_t moveFirst = 0;
+    int32_t moveLast  = minor;
+    clipSteps(&moveFirst, &moveLast, minorStart, minorSign, minorClipStart, minorClipStop);
+    if (moveFirst > moveLast)
+        return;
+    if (moveFirst > 0)
+    {
+        int32_t step = ((2 * moveFirst - 1) * major + 2 * minor - 1) / (2 * minor);
+        if (step > first) first = step;
+    }
+    if (moveLast < minor)
+    {
+        int32_t step = ((2 * moveLast + 1) * major + 2 * minor - 1) / (2 * minor) - 1;
+        if (step < last) last = step;
+    }
+
+    int32_t sum  = 2 * first * minor + major;
+    int32_t move = sum / (2 * major);
+    int32_t rest = sum % (2 * major);
+    for (int32_t n = first; n <= last; ++n)
+    {
+        int32_t a = majorStart + majorSign * n;
+        int32_t b = minorStart + minorSign * move;
+        if (isSteep)
+            SSD1306_drawPixel(dev, b, a, color);
+        else
+            SSD1306_drawPixel(dev, a, b, color);
+
+        rest += 2 * minor;
+        if (rest >= (2 * major))
+        {
+            rest -= 2 * major;
+            move++;
+        }
+    }
+}
+#endif
+
 void SSD1306_drawLine (SSD1306_DeviceHandle_t dev,
                        uint8_t xStart,
                        uint8_t yStart,
@@ -410,10 +1274,30 @@ void SSD1306_drawLine (SSD1306_DeviceHandle_t dev,
                        uint8_t yStop,
                        SSD1306_Color_t color)
 {
+    uint8_t xMin = (xStart < xStop) ? xStart : xStop;
+    uint8_t xMax = (xStart < xStop) ? xStop : xStart;
+    uint8_t yMin = (yStart < yStop) ? yStart : yStop;
+    uint8_t yMax = (yStart < yStop) ? yStop : yStart;
+
+    // Horizontal and vertical lines are filled as areas
+    if ((xStart == xStop) || (yStart == yStop))
+    {
+        fillClippedArea(dev, xMin, yMin, xMax - xMin + 1, yMax - yMin + 1, color);
+        return;
+    }
+
+    // The ends are on the same side out of the clip area: trivial reject
+    if ((getOutCode(dev, xStart, yStart) & getOutCode(dev, xStop, yStop)) != 0)
+        return;
+
+#if defined (SSD1306_REFERENCE_RENDERER)
     if (color == SSD1306_COLOR_BLACK)
         GDL_drawLine(&(dev->gdl),xStart,yStart,xStop,yStop,0);
     else
         GDL_drawLine(&(dev->gdl),xStart,yStart,xStop,yStop,1);
+#else
+    drawClippedLine(dev, xStart, yStart, xStop, yStop, color);
+#endif
 }
 
 void SSD1306_drawHLine (SSD1306_DeviceHandle_t dev,
@@ -442,19 +1326,332 @@ void SSD1306_drawRectangle (SSD1306_DeviceHandle_t dev,
                             uint8_t color,
                             bool isFill)
 {
-    if (color == SSD1306_COLOR_BLACK)
-        GDL_drawRectangle(&(dev->gdl),xStart,yStart,width,height,0,isFill);
-    else
-        GDL_drawRectangle(&(dev->gdl),xStart,yStart,width,height,1,isFill);
-}
+    SSD1306_Color_t c = (color == SSD1306_COLOR_BLACK) ? SSD1306_COLOR_BLACK : SSD1306_COLOR_COLOR;
 
-GDL_Errors_t SSD1306_drawChar (SSD1306_DeviceHandle_t dev,
-                               uint16_t xPos,
-                               uint16_t yPos,
-                               uint8_t c,
+    if ((width == 0) || (height == 0))
+        return;
+
+    if (isFill)
+    {
+        fillClippedArea(dev, xStart, yStart, width, height, c);
+    }
+    else
+    {
+        fillClippedArea(dev, xStart, yStart, width, 1, c);
+        fillClippedArea(dev, xStart, (uint32_t)yStart + height - 1, width, 1, c);
+        fillClippedArea(dev, xStart, yStart, 1, height, c);
+        fillClippedArea(dev, (uint32_t)xStart + width - 1, yStart, 1, height, c);
+    }
+}
+
+/*!
+ * This function fills a vertical span of a column, after clipping it with
+ * the current clip area.
+ *
+ * \param[in]    dev: The handle of the device.
+ * \param[in]      x: The column.
+ * \param[in] yStart: The first line of the span.
+ * \param[in]  yStop: The last line of the span.
+ * \param[in]  color: The color of the span.
+ */
+static inline void fillColumnSpan (SSD1306_DeviceHandle_t dev,
+                                   int32_t x,
+                                   int32_t yStart,
+                                   int32_t yStop,
+                                   SSD1306_Color_t color)
+{
+    if ((x < dev->clip.xStart) || (x >= dev->clip.xStop))
+        return;
+
+    if (yStart < dev->clip.yStart) yStart = dev->clip.yStart;
+    if (yStop >= dev->clip.yStop)  yStop  = dev->clip.yStop - 1;
+
+    if (yStart <= yStop)
+    {
+        fillArea(dev, x, x + 1, yStart, yStop + 1, color);
+    }
+}
+
+/*!
+ * This function computes the rounded value of a fraction, with positive
+ * denominator.
+ *
+ * \param[in]   num: The numerator.
+ * \param[in] denom: The denominator, greater than 0.
+ * \return The nearest integer, the halves are rounded up.
+ */
+static inline int32_t roundDivision (int64_t num, int32_t denom)
+{
+    int64_t n = 2 * num + denom;
+    int64_t d = 2 * denom;
+    // Floor division, also for negative numerator
+    return (n >= 0) ? (n / d) : -((-n + d - 1) / d);
+}
+
+void SSD1306_fillCircle (SSD1306_DeviceHandle_t dev,
+                         int16_t xCenter,
+                         int16_t yCenter,
+                         uint8_t radius,
+                         SSD1306_Color_t color)
+{
+    SSD1306_fillEllipse(dev, xCenter, yCenter, radius, radius, color);
+}
+
+void SSD1306_fillEllipse (SSD1306_DeviceHandle_t dev,
+                          int16_t xCenter,
+                          int16_t yCenter,
+                          uint8_t xRadius,
+                          uint8_t yRadius,
+                          SSD1306_Color_t color)
+{
+    // The ellipse is completely out of the clip area
+    if (((xCenter + xRadius) < dev->clip.xStart) || ((xCenter - xRadius) >= dev->clip.xStop) ||
+        ((yCenter + yRadius) < dev->clip.yStart) || ((yCenter - yRadius) >= dev->clip.yStop))
+        return;
+
+    // A pixel is inside when dx^2/(a^2+a) + dy^2/(b^2+b) <= 1
+    uint64_t a = (uint64_t)xRadius * xRadius + xRadius;
+    uint64_t b = (uint64_t)yRadius * yRadius + yRadius;
+    uint64_t limit = a * b;
+    int16_t height = yRadius;
+
+    // Every couple of symmetric columns is a single span, the half height
+    // only decreases moving away from the center
+    for (int16_t dx = 0; dx <= xRadius; ++dx)
+    {
+        uint64_t column = (uint64_t)dx * dx * b;
+        while ((height > 0) && ((column + (uint64_t)height * height * a) > limit))
+        {
+            height--;
+        }
+
+        fillColumnSpan(dev, xCenter + dx, yCenter - height, yCenter + height, color);
+        if (dx != 0)
+        {
+            fillColumnSpan(dev, xCenter - dx, yCenter - height, yCenter + height, color);
+        }
+    }
+}
+
+void SSD1306_fillRoundRectangle (SSD1306_DeviceHandle_t dev,
+                                 int16_t xStart,
+                                 int16_t yStart,
+                                 uint16_t width,
+                                 uint16_t height,
+                                 uint8_t radius,
+                                 SSD1306_Color_t color)
+{
+    if ((width == 0) || (height == 0))
+        return;
+
+    // The rectangle is completely out of the clip area
+    if (((xStart + (int32_t)width) <= dev->clip.xStart) || (xStart >= dev->clip.xStop) ||
+        ((yStart + (int32_t)height) <= dev->clip.yStart) || (yStart >= dev->clip.yStop))
+        return;
+
+    if (radius > ((width - 1) / 2))  radius = (width - 1) / 2;
+    if (radius > ((height - 1) / 2)) radius = (height - 1) / 2;
+
+    int32_t xStop = xStart + width - 1;
+    int32_t yStop = yStart + height - 1;
+
+    // Central part, between the corners
+    if (width > (2u * radius + 2))
+    {
+        int32_t x  = xStart + radius + 1;
+        int32_t y  = yStart;
+        int32_t w  = width - 2 * radius - 2;
+        int32_t h  = height;
+        if (x < 0) { w += x; x = 0; }
+        if (y < 0) { h += y; y = 0; }
+        if ((w > 0) && (h > 0)) fillClippedArea(dev, x, y, w, h, color);
+    }
+
+    // Corner columns, with the same rule of the circle
+    uint32_t limit = (uint32_t)radius * radius + radius;
+    int16_t corner = radius;
+    for (int16_t dx = 0; dx <= radius; ++dx)
+    {
+        while ((corner > 0) && (((uint32_t)dx * dx + (uint32_t)corner * corner) > limit))
+        {
+            corner--;
+        }
+
+        int32_t top    = yStart + radius - corner;
+        int32_t bottom = yStop - radius + corner;
+        fillColumnSpan(dev, xStart + radius - dx, top, bottom, color);
+        fillColumnSpan(dev, xStop - radius + dx, top, bottom, color);
+    }
+}
+
+void SSD1306_fillTriangle (SSD1306_DeviceHandle_t dev,
+                           int16_t x0,
+                           int16_t y0,
+                           int16_t x1,
+                           int16_t y1,
+                           int16_t x2,
+                           int16_t y2,
+                           SSD1306_Color_t color)
+{
+    SSD1306_Point_t points[3] =
+    {
+        { x0, y0 },
+        { x1, y1 },
+        { x2, y2 },
+    };
+    SSD1306_fillPolygon(dev, points, 3, color);
+}
+
+void SSD1306_fillPolygon (SSD1306_DeviceHandle_t dev,
+                          const SSD1306_Point_t* points,
+                          uint8_t count,
+                          SSD1306_Color_t color)
+{
+    int8_t low[SSD1306_MAX_DISPLAY_WIDTH];
+    int8_t high[SSD1306_MAX_DISPLAY_WIDTH];
+
+    if ((points == NULL) || (count == 0))
+        return;
+
+    // Bounding box of the polygon, clipped
+    int16_t xMin = points[0].x, xMax = points[0].x;
+    int16_t yMin = points[0].y, yMax = points[0].y;
+    for (uint8_t i = 1; i < count; ++i)
+    {
+        if (points[i].x < xMin) xMin = points[i].x;
+        if (points[i].x > xMax) xMax = points[i].x;
+        if (points[i].y < yMin) yMin = points[i].y;
+        if (points[i].y > yMax) yMax = points[i].y;
+    }
+    if ((xMax < dev->clip.xStart) || (xMin >= dev->clip.xStop) ||
+        (yMax < dev->clip.yStart) || (yMin >= dev->clip.yStop))
+        return;
+    if (xMin < dev->clip.xStart) xMin = dev->clip.xStart;
+    if (xMax >= dev->clip.xStop) xMax = dev->clip.xStop - 1;
+
+    for (int16_t x = xMin; x <= xMax; ++x)
+    {
+        low[x - xMin]  = INT8_MAX;
+        high[x - xMin] = INT8_MIN;
+    }
+
+    // Every edge updates the span of the columns that it crosses: for a convex
+    // polygon, the span goes from the lowest to the highest crossing line
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        const SSD1306_Point_t* p0 = &points[i];
+        const SSD1306_Point_t* p1 = &points[(i + 1) % count];
+        if (p0->x > p1->x)
+        {
+            const SSD1306_Point_t* tmp = p0;
+            p0 = p1;
+            p1 = tmp;
+        }
+
+        int16_t xFirst = (p0->x < xMin) ? xMin : p0->x;
+        int16_t xLast  = (p1->x > xMax) ? xMax : p1->x;
+        int32_t dx = p1->x - p0->x;
+        int32_t dy = p1->y - p0->y;
+
+        for (int16_t x = xFirst; x <= xLast; ++x)
+        {
+            int32_t yA, yB;
+            if (dx == 0)
+            {
+                yA = p0->y;
+                yB = p1->y;
+            }
+            else
+            {
+                yA = p0->y + roundDivision((int64_t)dy * (x - p0->x), dx);
+                yB = yA;
+            }
+            if (yA > yB)
+            {
+                int32_t tmp = yA;
+                yA = yB;
+                yB = tmp;
+            }
+
+            // Limit the lines to the clip area, with one line of margin
+            if (yA < (dev->clip.yStart - 1)) yA = dev->clip.yStart - 1;
+            if (yB < (dev->clip.yStart - 1)) yB = dev->clip.yStart - 1;
+            if (yA > dev->clip.yStop) yA = dev->clip.yStop;
+            if (yB > dev->clip.yStop) yB = dev->clip.yStop;
+
+            if (yA < low[x - xMin])  low[x - xMin]  = (int8_t)yA;
+            if (yB > high[x - xMin]) high[x - xMin] = (int8_t)yB;
+        }
+    }
+
+    for (int16_t x = xMin; x <= xMax; ++x)
+    {
+        if (low[x - xMin] <= high[x - xMin])
+        {
+            fillColumnSpan(dev, x, low[x - xMin], high[x - xMin], color);
+        }
+    }
+}
+
+#if !defined (SSD1306_REFERENCE_RENDERER)
+/*!
+ * A char of the default font, drawn without scale by GDL: the bit k of the
+ * column i is the pixel at line k.
+ */
+typedef struct _SSD1306_Glyph_t
+{
+    GDL_Device_t gdl;
+
+    uint8_t bits[GDL_DEFAULT_FONT_WIDTH];       /*!< Colors of the pixels */
+    uint8_t mask[GDL_DEFAULT_FONT_WIDTH];       /*!< Pixels drawn by GDL */
+} SSD1306_Glyph_t;
+
+/*!
+ * This function is the pixel callback used to capture a char from GDL.
+ *
+ * \param[in] glyph: The char to be captured.
+ * \param[in]  xPos: The column of the char.
+ * \param[in]  yPos: The line of the char.
+ * \param[in] color: The color of the pixel.
+ */
+static GDL_Errors_t drawGlyphPixel (SSD1306_Glyph_t* glyph,
+                                    uint8_t xPos,
+                                    uint8_t yPos,
+                                    uint8_t color)
+{
+    if ((xPos >= GDL_DEFAULT_FONT_WIDTH) || (yPos >= SSD1306_DEFAULT_FONT_HEIGHT))
+        return GDL_ERRORS_WRONG_POSITION;
+
+    glyph->mask[xPos] |= (uint8_t)(1u << yPos);
+    if (color)
+        glyph->bits[xPos] |= (uint8_t)(1u << yPos);
+    else
+        glyph->bits[xPos] &= (uint8_t)~(1u << yPos);
+    return GDL_ERRORS_SUCCESS;
+}
+#endif
+
+GDL_Errors_t SSD1306_drawChar (SSD1306_DeviceHandle_t dev,
+                               uint16_t xPos,
+                               uint16_t yPos,
+                               uint8_t c,
                                uint8_t color,
                                uint8_t size)
 {
+    uint16_t scale = (size == 0) ? 1 : size;
+
+    // The char is completely out of the clip area
+    if ((xPos >= dev->clip.xStop) || (yPos >= dev->clip.yStop) ||
+        ((xPos + scale * GDL_DEFAULT_FONT_WIDTH) <= dev->clip.xStart) ||
+        ((yPos + scale * SSD1306_DEFAULT_FONT_HEIGHT) <= dev->clip.yStart))
+    {
+        if ((xPos >= dev->gdl.width) || (yPos >= dev->gdl.height))
+            return GDL_ERRORS_WRONG_POSITION;
+        else
+            return GDL_ERRORS_SUCCESS;
+    }
+
+#if defined (SSD1306_REFERENCE_RENDERER)
     if (color == SSD1306_COLOR_BLACK)
     {
         return GDL_drawChar(&(dev->gdl),xPos,yPos,c,0,1,size);
@@ -463,6 +1660,48 @@ GDL_Errors_t SSD1306_drawChar (SSD1306_DeviceHandle_t dev,
     {
         return GDL_drawChar(&(dev->gdl),xPos,yPos,c,1,0,size);
     }
+#else
+    // The char is drawn once without scale, then only its part inside the
+    // clip area is written
+    SSD1306_Glyph_t glyph;
+    memset(&glyph, 0, sizeof(glyph));
+    glyph.gdl.width     = GDL_DEFAULT_FONT_WIDTH;
+    glyph.gdl.height    = SSD1306_DEFAULT_FONT_HEIGHT;
+    glyph.gdl.model     = dev->gdl.model;
+    glyph.gdl.drawPixel = drawGlyphPixel;
+    GDL_Errors_t error = GDL_drawChar(&(glyph.gdl),0,0,c,1,0,1);
+
+    uint32_t xStart = xPos;
+    uint32_t yStart = yPos;
+    uint32_t xStop  = (uint32_t)xPos + scale * GDL_DEFAULT_FONT_WIDTH;
+    uint32_t yStop  = (uint32_t)yPos + scale * SSD1306_DEFAULT_FONT_HEIGHT;
+    clipArea(dev, &xStart, &xStop, &yStart, &yStop);
+
+    for (uint32_t x = xStart; x < xStop; ++x)
+    {
+        uint8_t column = (x - xPos) / scale;
+        uint8_t bits   = (color == SSD1306_COLOR_BLACK) ? ~glyph.bits[column] : glyph.bits[column];
+
+        if (scale == 1)
+        {
+            SSD1306_writeColumn(dev, x, yPos, bits, glyph.mask[column]);
+            continue;
+        }
+
+        for (uint32_t y = yStart; y < yStop; y += 8)
+        {
+            uint8_t scaledBits = 0, scaledMask = 0;
+            for (uint8_t i = 0; (i < 8) && ((y + i) < yStop); ++i)
+            {
+                uint8_t line = (y + i - yPos) / scale;
+                scaledBits |= ((bits >> line) & 0x01) << i;
+                scaledMask |= ((glyph.mask[column] >> line) & 0x01) << i;
+            }
+            SSD1306_writeColumn(dev, x, y, scaledBits, scaledMask);
+        }
+    }
+    return error;
+#endif
 }
 
 GDL_Errors_t SSD1306_drawString (SSD1306_DeviceHandle_t dev,
@@ -475,7 +1714,7 @@ GDL_Errors_t SSD1306_drawString (SSD1306_DeviceHandle_t dev,
     uint8_t charWidth = size * GDL_DEFAULT_FONT_WIDTH;
     GDL_Errors_t error;
 
-    for (uint8_t i=0; text[i] != '\n' && text[i] != '\0'; i++)
+    for (uint16_t i=0; text[i] != '\n' && text[i] != '\0'; i++)
     {
         error = SSD1306_drawChar(dev,(xPos + charWidth * i),yPos,text[i],color,size);
         if (error != GDL_ERRORS_SUCCESS) return error;
@@ -490,17 +1729,328 @@ GDL_Errors_t SSD1306_drawPicture (SSD1306_DeviceHandle_t dev,
                                   uint16_t height,
                                   const uint8_t* picture)
 {
+    // The picture is completely out of the clip area
+    if ((xPos >= dev->clip.xStop) || (yPos >= dev->clip.yStop) ||
+        ((xPos + width) <= dev->clip.xStart) || ((yPos + height) <= dev->clip.yStart))
+    {
+        if ((xPos >= dev->gdl.width) || (yPos >= dev->gdl.height))
+            return GDL_ERRORS_WRONG_POSITION;
+        else
+            return GDL_ERRORS_SUCCESS;
+    }
+
+#if defined (SSD1306_REFERENCE_RENDERER)
     return GDL_drawPicture(dev, xPos, yPos, width, height, picture, GDL_PICTURETYPE_1BIT);
+#else
+    // Only the part of the picture inside the clip area is read: every
+    // row of the picture starts with a new byte, most significant bit first
+    uint16_t stride = (width + 7) / 8;
+    uint32_t xStart = xPos;
+    uint32_t yStart = yPos;
+    uint32_t xStop  = (uint32_t)xPos + width;
+    uint32_t yStop  = (uint32_t)yPos + height;
+    clipArea(dev, &xStart, &xStop, &yStart, &yStop);
+
+    for (uint32_t x = xStart; x < xStop; ++x)
+    {
+        const uint8_t* data = &picture[(x - xPos) / 8];
+        uint8_t shift = 7 - ((x - xPos) % 8);
+
+        for (uint32_t y = yStart; y < yStop; y += 8)
+        {
+            uint8_t bits = 0, mask = 0;
+            for (uint8_t i = 0; (i < 8) && ((y + i) < yStop); ++i)
+            {
+                bits |= ((data[(y + i - yPos) * stride] >> shift) & 0x01) << i;
+                mask |= 1u << i;
+            }
+            SSD1306_writeColumn(dev, x, y, bits, mask);
+        }
+    }
+    return GDL_ERRORS_SUCCESS;
+#endif
+}
+
+void SSD1306_pushClip (SSD1306_DeviceHandle_t dev,
+                       uint16_t xPos,
+                       uint16_t yPos,
+                       uint16_t width,
+                       uint16_t height)
+{
+    ohiassert(dev->clipDepth < SSD1306_CLIP_STACK_DIMENSION);
+    if (dev->clipDepth >= SSD1306_CLIP_STACK_DIMENSION)
+        return;
+
+    dev->clipStack[dev->clipDepth++] = dev->clip;
+
+    // The new clip area is always inside the previous one
+    uint32_t xStart = xPos;
+    uint32_t yStart = yPos;
+    uint32_t xStop  = (uint32_t)xPos + width;
+    uint32_t yStop  = (uint32_t)yPos + height;
+
+    if (clipArea(dev, &xStart, &xStop, &yStart, &yStop))
+    {
+        dev->clip.xStart = xStart;
+        dev->clip.yStart = yStart;
+        dev->clip.xStop  = xStop;
+        dev->clip.yStop  = yStop;
+    }
+    else
+    {
+        // Empty area: nothing can be drawn
+        dev->clip.xStop = dev->clip.xStart;
+        dev->clip.yStop = dev->clip.yStart;
+    }
+}
+
+void SSD1306_popClip (SSD1306_DeviceHandle_t dev)
+{
+    ohiassert(dev->clipDepth > 0);
+    if (dev->clipDepth > 0)
+    {
+        dev->clip = dev->clipStack[--dev->clipDepth];
+    }
+}
+
+void SSD1306_resetClip (SSD1306_DeviceHandle_t dev)
+{
+    dev->clipDepth   = 0;
+    dev->clip.xStart = 0;
+    dev->clip.yStart = 0;
+    dev->clip.xStop  = dev->gdl.width;
+    dev->clip.yStop  = dev->gdl.height;
+}
+
+GDL_Errors_t SSD1306_rotateArea (SSD1306_DeviceHandle_t dev,
+                                 uint8_t xPos,
+                                 uint8_t yPos,
+                                 uint8_t size,
+                                 SSD1306_Rotation_t rotation)
+{
+    if (((size % 8) != 0) ||
+        ((xPos + size) > dev->gdl.width) ||
+        ((yPos + size) > dev->gdl.height))
+        return GDL_ERRORS_WRONG_POSITION;
+
+    switch (rotation)
+    {
+    case SSD1306_ROTATION_90:
+        rotateArea90(dev, xPos, yPos, size, TRUE);
+        break;
+    case SSD1306_ROTATION_180:
+        rotateArea180(dev, xPos, yPos, size);
+        break;
+    case SSD1306_ROTATION_270:
+        rotateArea90(dev, xPos, yPos, size, FALSE);
+        break;
+    default:
+        ohiassert(0);
+        break;
+    }
+    return GDL_ERRORS_SUCCESS;
+}
+
+void SSD1306_setOrientation (SSD1306_DeviceHandle_t dev, SSD1306_Orientation_t orientation)
+{
+    bool isRemapChanged = ((dev->orientation ^ orientation) & SSD1306_ORIENTATION_MIRROR_X) != 0;
+
+    dev->orientation = orientation;
+    sendOrientation(dev);
+
+    // The segment re-map is applied only to the data written after it; with
+    // the governor the buffer is sent by its next frame
+    if (isRemapChanged)
+    {
+        SSD1306_flush(dev);
+    }
+}
+
+/*!
+ * This function draws a grayscale picture with fixed threshold or ordered
+ * dithering: every group of 8 lines of a column is built into a single byte
+ * and written with \ref SSD1306_writeColumn.
+ * The pattern of the Bayer matrix is aligned to the display, so it does not
+ * move with the picture.
+ *
+ * \param[in]     dev: The handle of the device.
+ * \param[in]    xPos: The x position of the picture.
+ * \param[in]    yPos: The y position of the picture.
+ * \param[in]   width: The width of the picture.
+ * \param[in]  xStart: The first column to draw, into the picture.
+ * \param[in]   xStop: The first column after the drawn area, into the picture.
+ * \param[in]  yStart: The first line to draw, into the picture.
+ * \param[in]   yStop: The first line after the drawn area, into the picture.
+ * \param[in] picture: The array of the picture, one byte for each pixel.
+ * \param[in] isBayer: TRUE for ordered dithering, FALSE for fixed threshold.
+ */
+static void drawGrayscaleOrdered (SSD1306_DeviceHandle_t dev,
+                                  uint16_t xPos,
+                                  uint16_t yPos,
+                                  uint16_t width,
+                                  uint16_t xStart,
+                                  uint16_t xStop,
+                                  uint16_t yStart,
+                                  uint16_t yStop,
+                                  const uint8_t* picture,
+                                  bool isBayer)
+{
+    for (uint16_t y = yStart; y < yStop; y += 8)
+    {
+        uint8_t lines = ((yStop - y) < 8) ? (yStop - y) : 8;
+        uint8_t mask  = (uint8_t)((1u << lines) - 1);
+
+        for (uint16_t x = xStart; x < xStop; ++x)
+        {
+            const uint8_t* pixel = &picture[(uint32_t)y * width + x];
+            uint8_t column = (xPos + x) % 8;
+            uint8_t bits = 0;
+
+            for (uint8_t k = 0; k < lines; ++k)
+            {
+                uint8_t threshold = isBayer ? (mBayerMatrix[(yPos + y + k) % 8][column] * 4 + 2) : 127;
+                if (*pixel > threshold)
+                    bits |= (1u << k);
+                pixel += width;
+            }
+            SSD1306_writeColumn(dev, xPos + x, yPos + y, bits, mask);
+        }
+    }
+}
+
+/*!
+ * This function draws a grayscale picture with Floyd-Steinberg error
+ * diffusion. The lines are processed one at time, with a single line of
+ * errors; every group of 8 lines is collected into one byte for each column
+ * and written with \ref SSD1306_writeColumn.
+ *
+ * \param[in]     dev: The handle of the device.
+ * \param[in]    xPos: The x position of the picture.
+ * \param[in]    yPos: The y position of the picture.
+ * \param[in]   width: The width of the picture.
+ * \param[in]  xStart: The first column to draw, into the picture.
+ * \param[in]   xStop: The first column after the drawn area, into the picture.
+ * \param[in]  yStart: The first line to draw, into the picture.
+ * \param[in]   yStop: The first line after the drawn area, into the picture.
+ * \param[in] picture: The array of the picture, one byte for each pixel.
+ */
+static void drawGrayscaleDiffusion (SSD1306_DeviceHandle_t dev,
+                                    uint16_t xPos,
+                                    uint16_t yPos,
+                                    uint16_t width,
+                                    uint16_t xStart,
+                                    uint16_t xStop,
+                                    uint16_t yStart,
+                                    uint16_t yStop,
+                                    const uint8_t* picture)
+{
+    int16_t error[SSD1306_MAX_DISPLAY_WIDTH];
+    uint8_t columns[SSD1306_MAX_DISPLAY_WIDTH];
+    uint8_t count = xStop - xStart;
+
+    memset(error, 0, sizeof(error));
+    memset(columns, 0, sizeof(columns));
+
+    // The error is diffused also from the lines over the clip area
+    for (uint16_t y = 0; y < yStop; ++y)
+    {
+        const uint8_t* pixel = &picture[(uint32_t)y * width + xStart];
+        uint8_t bit = (y >= yStart) ? ((y - yStart) % 8) : 0;
+        int16_t right = 0;
+        int16_t belowLeft = 0;
+        int16_t below = 0;
+
+        for (uint8_t x = 0; x < count; ++x)
+        {
+            int16_t value = (int16_t)pixel[x] + error[x] + right;
+            int16_t e;
+
+            if (value > 127)
+            {
+                e = value - 255;
+                if (y >= yStart) columns[x] |= (1u << bit);
+            }
+            else
+            {
+                e = value;
+            }
+
+            // Weights 7/16 right, 3/16 below-left, 5/16 below, 1/16 below-right
+            int16_t e7 = (e * 7) / 16;
+            int16_t e3 = (e * 3) / 16;
+            int16_t e5 = (e * 5) / 16;
+            right = e7;
+            if (x > 0) error[x-1] = belowLeft + e3;
+            belowLeft = below + e5;
+            below = e - e7 - e3 - e5;
+        }
+        error[count-1] = belowLeft;
+
+        // Write a complete group of lines
+        if ((y >= yStart) && ((bit == 7) || ((y + 1) == yStop)))
+        {
+            uint16_t first = y - bit;
+            uint8_t mask = (uint8_t)((1u << (bit + 1)) - 1);
+            for (uint8_t x = 0; x < count; ++x)
+            {
+                SSD1306_writeColumn(dev, xPos + xStart + x, yPos + first, columns[x], mask);
+                columns[x] = 0;
+            }
+        }
+    }
+}
+
+GDL_Errors_t SSD1306_drawGrayscale (SSD1306_DeviceHandle_t dev,
+                                    uint16_t xPos,
+                                    uint16_t yPos,
+                                    uint16_t width,
+                                    uint16_t height,
+                                    const uint8_t* picture,
+                                    SSD1306_Dither_t dither)
+{
+    if ((xPos >= dev->gdl.width) || (yPos >= dev->gdl.height))
+        return GDL_ERRORS_WRONG_POSITION;
+
+    // Visible part of the picture, into the picture coordinates
+    uint32_t xStart = xPos;
+    uint32_t yStart = yPos;
+    uint32_t xStop  = (uint32_t)xPos + width;
+    uint32_t yStop  = (uint32_t)yPos + height;
+    if (!clipArea(dev, &xStart, &xStop, &yStart, &yStop))
+        return GDL_ERRORS_SUCCESS;
+
+    xStart -= xPos;
+    xStop  -= xPos;
+    yStart -= yPos;
+    yStop  -= yPos;
+
+    switch (dither)
+    {
+    case SSD1306_DITHER_THRESHOLD:
+    case SSD1306_DITHER_BAYER:
+        drawGrayscaleOrdered(dev, xPos, yPos, width, xStart, xStop, yStart, yStop,
+                             picture, (dither == SSD1306_DITHER_BAYER));
+        break;
+    case SSD1306_DITHER_FLOYD_STEINBERG:
+        drawGrayscaleDiffusion(dev, xPos, yPos, width, xStart, xStop, yStart, yStop, picture);
+        break;
+    default:
+        ohiassert(0);
+        break;
+    }
+    return GDL_ERRORS_SUCCESS;
 }
 
 void SSD1306_inverseDisplay (SSD1306_DeviceHandle_t dev)
 {
     sendCommand(dev,SSD1306_CMD_DISPLAYINVERSE);
+    dev->isInverse = TRUE;
 }
 
 void SSD1306_normalDisplay (SSD1306_DeviceHandle_t dev)
 {
     sendCommand(dev,SSD1306_CMD_DISPLAYNORMAL);
+    dev->isInverse = FALSE;
 }
 
 void SSD1306_scroll (SSD1306_DeviceHandle_t dev, bool scroll)
@@ -513,20 +2063,266 @@ void SSD1306_scroll (SSD1306_DeviceHandle_t dev, bool scroll)
     {
         sendCommand(dev,SSD1306_CMD_DEACTIVATESCROLL);
     }
+    dev->isScrolling = scroll;
 }
 
-void SSD1306_flush (SSD1306_DeviceHandle_t dev)
+void SSD1306_scrollLines (SSD1306_DeviceHandle_t dev, uint8_t lines)
+{
+    if (lines == 0) return;
+
+    uint8_t height = (uint8_t)dev->gdl.height;
+    uint8_t count  = (lines < height) ? lines : height;
+
+    // Move the first display line forward, into the display RAM circular buffer
+    dev->startLine = (dev->startLine + lines) & (SSD1306_RAM_ROWS - 1);
+    dev->isStartLineChanged = TRUE;
+
+    // The pending areas are moved with the display content, so the whole
+    // display must be sent
+    if (dev->dirtyCount > 0)
+    {
+        dev->dirtyCount = 0;
+        SSD1306_requestFlush(dev);
+    }
+
+    // Clear the new lines at the bottom of the display
+    fillArea(dev, 0, dev->gdl.width, height - count, height, SSD1306_COLOR_BLACK);
+}
+
+void SSD1306_flushStartLine (SSD1306_DeviceHandle_t dev)
+{
+    if (!dev->isStartLineChanged)
+        return;
+
+    if (dev->frameTime > 0)
+    {
+        // The next frame sends it, after the data of the frame
+        dev->isFlushPending = TRUE;
+        return;
+    }
+
+    sendCommand(dev,SSD1306_CMD_SETDISPLAYSTARTLINE | dev->startLine);
+    dev->isStartLineChanged = FALSE;
+}
+
+void SSD1306_flushArea (SSD1306_DeviceHandle_t dev,
+                        uint16_t xPos,
+                        uint16_t yPos,
+                        uint16_t width,
+                        uint16_t height)
+{
+    SSD1306_Region_t region = { xPos, yPos, width, height };
+    SSD1306_flushAreas(dev, &region, 1);
+}
+
+void SSD1306_flushAreas (SSD1306_DeviceHandle_t dev,
+                         const SSD1306_Region_t* regions,
+                         uint8_t count)
+{
+    if (dev->frameTime > 0)
+    {
+        for (uint8_t i = 0; i < count; ++i)
+        {
+            SSD1306_requestFlushArea(dev, regions[i].xPos, regions[i].yPos, regions[i].width, regions[i].height);
+        }
+        return;
+    }
+
+    SSD1306_flushRegions(dev, regions, count);
+}
+
+void SSD1306_flushRegions (SSD1306_DeviceHandle_t dev,
+                           const SSD1306_Region_t* regions,
+                           uint8_t count)
 {
-    // Set start column address and page address
-    // They depend on producer choice and device type
-    setPageAddress(dev, 0x00, dev->page-1);
-    setColumnAddress(dev, 0x00, dev->column-1);
+    SSD1306_Block_t plan [SSD1306_PLAN_DIMENSION];
+    uint8_t blocks = 0;
 
-    uint16_t count = dev->column * dev->page;
-    for (uint16_t i = 0; i < count; ++i)
+    for (uint8_t i = 0; i < count; ++i)
     {
-        sendData(dev,dev->buffer[i]);
+        uint16_t xPos   = regions[i].xPos;
+        uint16_t yPos   = regions[i].yPos;
+        uint16_t width  = regions[i].width;
+        uint16_t height = regions[i].height;
+
+        if ((xPos >= dev->gdl.width) || (yPos >= dev->gdl.height) || (width == 0) || (height == 0))
+            continue;
+
+        if (width > (dev->gdl.width - xPos))   width  = dev->gdl.width - xPos;
+        if (height > (dev->gdl.height - yPos)) height = dev->gdl.height - yPos;
+
+        SSD1306_Block_t block;
+        block.colStart = (uint8_t)xPos;
+        block.colEnd   = (uint8_t)(xPos + width - 1);
+        // Remap the rows into the display RAM circular buffer
+        uint8_t rowStart = (yPos + dev->startLine) & (SSD1306_RAM_ROWS - 1);
+        uint16_t rowEnd  = rowStart + height - 1;
+
+        if (rowEnd < SSD1306_RAM_ROWS)
+        {
+            block.pageStart = rowStart/8;
+            block.pageEnd   = rowEnd/8;
+            blocks = addBlock(dev, plan, blocks, &block);
+        }
+        else
+        {
+            // The area wraps around the end of display RAM
+            block.pageStart = rowStart/8;
+            block.pageEnd   = (SSD1306_RAM_ROWS/8) - 1;
+            blocks = addBlock(dev, plan, blocks, &block);
+            block.pageStart = 0;
+            block.pageEnd   = (rowEnd - SSD1306_RAM_ROWS)/8;
+            blocks = addBlock(dev, plan, blocks, &block);
+        }
+    }
+
+    for (uint8_t i = 0; i < blocks; ++i)
+    {
+        sendBlock(dev, &plan[i]);
     }
+
+    // The new start line is sent after the data, so the new lines are already
+    // written when they are shown
+    if (dev->isStartLineChanged)
+    {
+        sendCommand(dev,SSD1306_CMD_SETDISPLAYSTARTLINE | dev->startLine);
+        dev->isStartLineChanged = FALSE;
+    }
+}
+
+#if defined (SSD1306_STATISTICS)
+void SSD1306_resetStatistics (SSD1306_DeviceHandle_t dev)
+{
+    memset(&dev->statistics, 0, sizeof(SSD1306_Statistics_t));
+}
+#endif
+
+void SSD1306_setCostModel (SSD1306_DeviceHandle_t dev, const SSD1306_CostModel_t* cost)
+{
+    ohiassert(cost != NULL);
+
+    dev->cost = *cost;
+}
+
+void SSD1306_setFrameRate (SSD1306_DeviceHandle_t dev, uint8_t target, uint8_t maximum)
+{
+    ohiassert((target == 0) || (maximum >= target));
+
+    dev->frameTime    = (target > 0) ? (1000 / target) : 0;
+    dev->minFrameTime = (maximum > 0) ? (1000 / maximum) : dev->frameTime;
+    dev->nextFrame    = System_currentTick();
+}
+
+void SSD1306_requestFlush (SSD1306_DeviceHandle_t dev)
+{
+    SSD1306_requestFlushArea(dev, 0, 0, dev->gdl.width, dev->gdl.height);
+}
+
+void SSD1306_requestFlushArea (SSD1306_DeviceHandle_t dev,
+                               uint16_t xPos,
+                               uint16_t yPos,
+                               uint16_t width,
+                               uint16_t height)
+{
+    dev->isFlushPending = TRUE;
+
+    // An empty area sends only a pending start line
+    if ((xPos >= dev->gdl.width) || (yPos >= dev->gdl.height) || (width == 0) || (height == 0))
+        return;
+
+    if (width > (dev->gdl.width - xPos))   width  = dev->gdl.width - xPos;
+    if (height > (dev->gdl.height - yPos)) height = dev->gdl.height - yPos;
+
+    // Merge the area with the pending areas that it touches, or with the
+    // area that grows less when the list is full
+    bool isFound = FALSE;
+    uint8_t best = 0;
+    uint32_t bestGrowth = 0;
+    for (uint8_t i = 0; i < dev->dirtyCount; ++i)
+    {
+        SSD1306_Region_t* region = &dev->dirty[i];
+        uint16_t xStart = (region->xPos < xPos) ? region->xPos : xPos;
+        uint16_t yStart = (region->yPos < yPos) ? region->yPos : yPos;
+        uint16_t xStop  = ((region->xPos + region->width) > (xPos + width)) ? (region->xPos + region->width) : (xPos + width);
+        uint16_t yStop  = ((region->yPos + region->height) > (yPos + height)) ? (region->yPos + region->height) : (yPos + height);
+
+        uint32_t growth = (uint32_t)(xStop - xStart) * (yStop - yStart) -
+                          (uint32_t)region->width * region->height;
+
+        bool isTouching = (xPos <= (region->xPos + region->width)) && (region->xPos <= (xPos + width)) &&
+                          (yPos <= (region->yPos + region->height)) && (region->yPos <= (yPos + height));
+        if (isTouching || (dev->dirtyCount == SSD1306_DIRTY_DIMENSION))
+        {
+            if (isTouching) growth = 0;
+            if (!isFound || (growth < bestGrowth))
+            {
+                isFound    = TRUE;
+                best       = i;
+                bestGrowth = growth;
+            }
+        }
+    }
+
+    if (!isFound)
+    {
+        SSD1306_Region_t* region = &dev->dirty[dev->dirtyCount++];
+        region->xPos   = xPos;
+        region->yPos   = yPos;
+        region->width  = width;
+        region->height = height;
+    }
+    else
+    {
+        SSD1306_Region_t region = dev->dirty[best];
+        dev->dirty[best] = dev->dirty[--dev->dirtyCount];
+
+        // The merged area can touch other pending areas too
+        uint16_t xStart = (region.xPos < xPos) ? region.xPos : xPos;
+        uint16_t yStart = (region.yPos < yPos) ? region.yPos : yPos;
+        uint16_t xStop  = ((region.xPos + region.width) > (xPos + width)) ? (region.xPos + region.width) : (xPos + width);
+        uint16_t yStop  = ((region.yPos + region.height) > (yPos + height)) ? (region.yPos + region.height) : (yPos + height);
+        SSD1306_requestFlushArea(dev, xStart, yStart, xStop - xStart, yStop - yStart);
+    }
+}
+
+bool SSD1306_processFlush (SSD1306_DeviceHandle_t dev)
+{
+    if (!dev->isFlushPending)
+        return FALSE;
+
+    if (dev->frameTime > 0)
+    {
+        uint32_t now = System_currentTick();
+
+        // Wait for the next frame, but never go faster than the maximum rate
+        if (((int32_t)(now - dev->nextFrame) < 0) || ((now - dev->lastFlush) < dev->minFrameTime))
+            return FALSE;
+
+        // Keep the pace, unless the display was idle or it is late more than a frame
+        dev->nextFrame += dev->frameTime;
+        if ((int32_t)(now - dev->nextFrame) >= 0)
+            dev->nextFrame = now + dev->frameTime;
+    }
+
+    SSD1306_forceFlush(dev);
+    return TRUE;
+}
+
+void SSD1306_forceFlush (SSD1306_DeviceHandle_t dev)
+{
+    if (!dev->isFlushPending)
+        return;
+
+    SSD1306_flushRegions(dev, dev->dirty, dev->dirtyCount);
+
+    dev->dirtyCount     = 0;
+    dev->isFlushPending = FALSE;
+    dev->lastFlush      = System_currentTick();
+}
+
+void SSD1306_flush (SSD1306_DeviceHandle_t dev)
+{
+    SSD1306_flushArea(dev, 0, 0, dev->gdl.width, dev->gdl.height);
 }
 
 void SSD1306_clear (SSD1306_DeviceHandle_t dev)
@@ -540,15 +2336,57 @@ void SSD1306_clear (SSD1306_DeviceHandle_t dev)
 void SSD1306_on (SSD1306_DeviceHandle_t dev)
 {
     sendCommand(dev,SSD1306_CMD_DISPLAYON);
+    dev->isSuspended = FALSE;
 }
 
 void SSD1306_off (SSD1306_DeviceHandle_t dev)
 {
+    // The display OFF command is the sleep mode of the driver
     sendCommand(dev,SSD1306_CMD_DISPLAYOFF);
+    dev->isSuspended = TRUE;
+}
+
+void SSD1306_suspend (SSD1306_DeviceHandle_t dev)
+{
+    // In sleep mode the driver keeps display RAM and configuration
+    SSD1306_off(dev);
+
+    // The internal charge pump is stopped after the panel, to save its current
+    if (dev->isChargePump)
+    {
+        uint8_t commands[2] = { SSD1306_CMD_CHARGEPUMP, SSD1306_CMDVALUE_CHARGEPUMP_DISABLE };
+        sendCommandArray(dev, commands, 2);
+    }
+}
+
+void SSD1306_resume (SSD1306_DeviceHandle_t dev)
+{
+    // The internal charge pump must run before the panel is turned on
+    if (dev->isChargePump)
+    {
+        uint8_t commands[2] = { SSD1306_CMD_CHARGEPUMP, SSD1306_CMDVALUE_CHARGEPUMP_ENABLE };
+        sendCommandArray(dev, commands, 2);
+    }
+    SSD1306_on(dev);
+}
+
+void SSD1306_restore (SSD1306_DeviceHandle_t dev)
+{
+    sendConfiguration(dev);
+    SSD1306_requestFlush(dev);
+    SSD1306_forceFlush(dev);
+
+    // The charge pump is stopped by the reset of the driver
+    if (!dev->isSuspended)
+    {
+        SSD1306_resume(dev);
+    }
 }
 
 void SSD1306_setContrast (SSD1306_DeviceHandle_t dev, uint8_t value)
 {
-    sendCommand(dev,SSD1306_CMD_SETCONTRAST);
-    sendCommand(dev, value);
+    // Command and value in a single transaction, so a fade step is cheap
+    uint8_t commands[2] = { SSD1306_CMD_SETCONTRAST, value };
+    sendCommandArray(dev, commands, 2);
+    dev->contrast = value;
 }
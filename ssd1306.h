@@ -48,6 +48,31 @@ extern "C" {
  * framework for multi microcontroller.
  * \li GDL https://github.com/warcomeb/gdl a generic Graphics Display Library
  *
+ * \section options Compile Options
+ *
+ * \li SSD1306_STATISTICS counts the bus transactions, the command bytes and
+ * the data bytes sent to the display, see \ref SSD1306_Statistics_t.
+ * \li SSD1306_REFERENCE_RENDERER replaces the byte-level fast paths with
+ * loops of \ref SSD1306_drawPixel: building the library with and without
+ * it, a test harness can check that both produce the same buffer.
+ *
+ * \section tests Host Tests
+ *
+ * The tests directory builds the library for the host, with stubs of
+ * libohiboard and GDL and a simulated controller on the I2C bus. The drawing
+ * functions are compared with reference rasterizers that test every pixel
+ * against the rules documented here, and the bus usage of the main scenarios
+ * is checked against budgets through \ref SSD1306_Statistics_t. The flush
+ * planner is checked with random regions and cost models: the display must
+ * show the buffer, and the cost must stay close to the best grouping of the
+ * blocks.
+ *
+ * \code{.sh}
+ * cmake -S tests -B build
+ * cmake --build build
+ * ctest --test-dir build --output-on-failure
+ * \endcode
+ *
  * \section example Example
  *
  * \code{.c}
@@ -135,6 +160,9 @@ extern "C" {
 #define SSD1306_MAX_DISPLAY_WIDTH                128
 #define SSD1306_BUFFER_DIMENSION                 (SSD1306_MAX_DISPLAY_WIDTH*SSD1306_MAX_DISPLAY_HEIGHT/8)
 
+#define SSD1306_CLIP_STACK_DIMENSION             4
+#define SSD1306_DIRTY_DIMENSION                  4
+
 /*!
  * \defgroup SSD1306_Core
  * \{
@@ -179,6 +207,63 @@ typedef struct _SSD1306_Config_t
 
 } SSD1306_Config_t;
 
+/*!
+ * SSD1306 clip area.
+ * Only the pixels inside the area can be changed by drawing functions.
+ */
+typedef struct _SSD1306_Clip_t
+{
+    uint8_t xStart;              /*!< First column inside the area */
+    uint8_t yStart;              /*!< First line inside the area */
+    uint8_t xStop;               /*!< First column after the area */
+    uint8_t yStop;               /*!< First line after the area */
+} SSD1306_Clip_t;
+
+/*!
+ * SSD1306 region of the display, used to describe the areas to be sent.
+ */
+typedef struct _SSD1306_Region_t
+{
+    uint16_t xPos;               /*!< The x position of the top-left corner */
+    uint16_t yPos;               /*!< The y position of the top-left corner */
+    uint16_t width;
+    uint16_t height;
+} SSD1306_Region_t;
+
+#if defined (SSD1306_STATISTICS)
+/*!
+ * SSD1306 bus statistics.
+ */
+typedef struct _SSD1306_Statistics_t
+{
+    uint32_t transactions;       /*!< Number of bus transactions */
+    uint32_t commandBytes;       /*!< Number of command bytes */
+    uint32_t dataBytes;          /*!< Number of data bytes */
+} SSD1306_Statistics_t;
+#endif
+
+/*!
+ * SSD1306 transport cost model.
+ * The flush planner uses it to choose the cheapest command sequence. The
+ * unit is free, e.g. bus bit times, but it must be the same for all fields.
+ */
+typedef struct _SSD1306_CostModel_t
+{
+    uint16_t transaction;        /*!< Fixed cost of every bus transaction */
+    uint16_t command;            /*!< Cost of a command byte */
+    uint16_t data;               /*!< Cost of a data byte */
+} SSD1306_CostModel_t;
+
+/*!
+ * SSD1306 point, used to describe polygons.
+ * The coordinates can be out of the display.
+ */
+typedef struct _SSD1306_Point_t
+{
+    int16_t x;
+    int16_t y;
+} SSD1306_Point_t;
+
 /*!
  * SSD1306 device class.
  */
@@ -199,6 +284,37 @@ typedef struct _SSD1306_Device_t
     uint8_t page;
     uint8_t column;
 
+#if defined (SSD1306_STATISTICS)
+    SSD1306_Statistics_t statistics;
+#endif
+
+    SSD1306_CostModel_t cost;    /*!< Cost model of the transport */
+    uint8_t addressingMode;      /*!< Current addressing mode of the display RAM */
+
+    uint8_t startLine;           /*!< Display RAM row shown on the first line */
+    bool isStartLineChanged;     /*!< The start line must be sent with next flush */
+
+    uint8_t contrast;            /*!< Current contrast value */
+    bool isInverse;              /*!< The display shows black on white */
+    bool isScrolling;            /*!< The scrolling is active */
+    bool isSuspended;            /*!< The display is in sleep mode */
+
+    bool isSegmentRemap;         /*!< Segment re-map of the product */
+    bool isComScanDown;          /*!< COM scan direction of the product */
+    uint8_t orientation;         /*!< Current orientation, see \ref SSD1306_Orientation_t */
+
+    uint32_t frameTime;          /*!< Time between two frames in ms, 0 without governor */
+    uint32_t minFrameTime;       /*!< Minimum time between two frames in ms */
+    uint32_t nextFrame;          /*!< Tick of the next frame */
+    uint32_t lastFlush;          /*!< Tick of the last flush */
+    bool isFlushPending;         /*!< An update is waiting for the next frame */
+    SSD1306_Region_t dirty [SSD1306_DIRTY_DIMENSION];
+    uint8_t dirtyCount;
+
+    SSD1306_Clip_t clip;         /*!< Current clip area */
+    SSD1306_Clip_t clipStack [SSD1306_CLIP_STACK_DIMENSION];
+    uint8_t clipDepth;
+
     /*! Buffer to store display data */
     uint8_t buffer [SSD1306_BUFFER_DIMENSION];
 
@@ -214,6 +330,7 @@ void SSD1306_init (SSD1306_DeviceHandle_t dev, SSD1306_Config_t* config);
 
 /*!
  * This function draw a single pixel into internal buffer.
+ * The pixels out of the clip area are not drawn.
  * \note To send the design to the display, you must use \ref SSD1306_flush
  *
  * \param[in]   dev: The handle of the device
@@ -227,6 +344,38 @@ GDL_Errors_t SSD1306_drawPixel (SSD1306_DeviceHandle_t dev,
                                 uint8_t yPos,
                                 SSD1306_Color_t color);
 
+/*!
+ * This function reads 8 vertical pixels from the internal buffer, starting
+ * from the selected position. The bit 0 is the pixel at the y position.
+ * The pixels out of the display are read as 0.
+ *
+ * \param[in]  dev: The handle of the device
+ * \param[in] xPos: The x position
+ * \param[in] yPos: The y position of the first pixel
+ * \return The 8 pixels.
+ */
+uint8_t SSD1306_readColumn (SSD1306_DeviceHandle_t dev, uint8_t xPos, uint8_t yPos);
+
+/*!
+ * This function writes 8 vertical pixels into the internal buffer, starting
+ * from the selected position. The bit 0 is the pixel at the y position, and
+ * only the pixels selected by the mask and inside the clip area are changed.
+ * It is the fast path for drawing page-major data: the pixels are written one
+ * or two bytes at time, whatever is the y position.
+ * \note To send the design to the display, you must use \ref SSD1306_flush
+ *
+ * \param[in]  dev: The handle of the device
+ * \param[in] xPos: The x position
+ * \param[in] yPos: The y position of the first pixel
+ * \param[in] bits: The 8 pixels
+ * \param[in] mask: The pixels to be changed
+ */
+void SSD1306_writeColumn (SSD1306_DeviceHandle_t dev,
+                          uint8_t xPos,
+                          uint8_t yPos,
+                          uint8_t bits,
+                          uint8_t mask);
+
 /*!
  * The function print a line in the selected position with the selected
  * color.
@@ -282,13 +431,15 @@ void SSD1306_drawVLine (SSD1306_DeviceHandle_t dev,
 
 /*!
  * The function draw a rectangle. It can be fill or not.
+ * The rectangle covers the columns from xStart to xStart+width-1, and the
+ * lines from yStart to yStart+height-1.
  * \note To send the design to the display, you must use \ref SSD1306_flush
  *
  * \param[in]    dev: The handle of the device
  * \param[in] xStart: The starting x position
  * \param[in] yStart: The starting y position
- * \param[in]  width: The ending x position
- * \param[in] height: The ending y position
+ * \param[in]  width: The width of the rectangle
+ * \param[in] height: The height of the rectangle
  * \param[in]  color: The color of the rectangle
  * \param[in] isFill: If TRUE the rectangle will be fill
  */
@@ -300,6 +451,109 @@ void SSD1306_drawRectangle (SSD1306_DeviceHandle_t dev,
                             uint8_t color,
                             bool isFill);
 
+/*!
+ * The function draws a filled circle.
+ * A pixel is inside the circle when dx^2 + dy^2 <= radius^2 + radius, where
+ * dx and dy are the distances from the center.
+ * The circle is drawn as vertical spans, one for each column.
+ * \note To send the design to the display, you must use \ref SSD1306_flush
+ *
+ * \param[in]     dev: The handle of the device
+ * \param[in] xCenter: The x position of the center, it can be out of the display
+ * \param[in] yCenter: The y position of the center, it can be out of the display
+ * \param[in]  radius: The radius of the circle
+ * \param[in]   color: The color of the circle
+ */
+void SSD1306_fillCircle (SSD1306_DeviceHandle_t dev,
+                         int16_t xCenter,
+                         int16_t yCenter,
+                         uint8_t radius,
+                         SSD1306_Color_t color);
+
+/*!
+ * The function draws a filled ellipse with axes parallel to the display.
+ * A pixel is inside the ellipse when dx^2/(a^2+a) + dy^2/(b^2+b) <= 1, where
+ * dx and dy are the distances from the center, a and b the radii.
+ * The ellipse is drawn as vertical spans, one for each column.
+ * \note To send the design to the display, you must use \ref SSD1306_flush
+ *
+ * \param[in]     dev: The handle of the device
+ * \param[in] xCenter: The x position of the center, it can be out of the display
+ * \param[in] yCenter: The y position of the center, it can be out of the display
+ * \param[in] xRadius: The horizontal radius
+ * \param[in] yRadius: The vertical radius
+ * \param[in]   color: The color of the ellipse
+ */
+void SSD1306_fillEllipse (SSD1306_DeviceHandle_t dev,
+                          int16_t xCenter,
+                          int16_t yCenter,
+                          uint8_t xRadius,
+                          uint8_t yRadius,
+                          SSD1306_Color_t color);
+
+/*!
+ * The function draws a filled rectangle with rounded corners.
+ * The corners follow the same rule of \ref SSD1306_fillCircle, and the radius
+ * is limited to half of the smaller side.
+ * \note To send the design to the display, you must use \ref SSD1306_flush
+ *
+ * \param[in]    dev: The handle of the device
+ * \param[in] xStart: The starting x position, it can be out of the display
+ * \param[in] yStart: The starting y position, it can be out of the display
+ * \param[in]  width: The width of the rectangle
+ * \param[in] height: The height of the rectangle
+ * \param[in] radius: The radius of the corners
+ * \param[in]  color: The color of the rectangle
+ */
+void SSD1306_fillRoundRectangle (SSD1306_DeviceHandle_t dev,
+                                 int16_t xStart,
+                                 int16_t yStart,
+                                 uint16_t width,
+                                 uint16_t height,
+                                 uint8_t radius,
+                                 SSD1306_Color_t color);
+
+/*!
+ * The function draws a filled triangle.
+ * It is the same of \ref SSD1306_fillPolygon with three points.
+ * \note To send the design to the display, you must use \ref SSD1306_flush
+ *
+ * \param[in]   dev: The handle of the device
+ * \param[in]    x0: The x position of the first vertex
+ * \param[in]    y0: The y position of the first vertex
+ * \param[in]    x1: The x position of the second vertex
+ * \param[in]    y1: The y position of the second vertex
+ * \param[in]    x2: The x position of the third vertex
+ * \param[in]    y2: The y position of the third vertex
+ * \param[in] color: The color of the triangle
+ */
+void SSD1306_fillTriangle (SSD1306_DeviceHandle_t dev,
+                           int16_t x0,
+                           int16_t y0,
+                           int16_t x1,
+                           int16_t y1,
+                           int16_t x2,
+                           int16_t y2,
+                           SSD1306_Color_t color);
+
+/*!
+ * The function draws a filled convex polygon.
+ * In every column, the polygon is filled from the lowest to the highest
+ * crossing point of its edges, rounded to the nearest line: the edges are
+ * always drawn, so also a thin polygon is visible.
+ * The polygon is drawn as vertical spans, one for each column.
+ * \note To send the design to the display, you must use \ref SSD1306_flush
+ *
+ * \param[in]    dev: The handle of the device
+ * \param[in] points: The vertices of the polygon, in order
+ * \param[in]  count: The number of vertices
+ * \param[in]  color: The color of the polygon
+ */
+void SSD1306_fillPolygon (SSD1306_DeviceHandle_t dev,
+                          const SSD1306_Point_t* points,
+                          uint8_t count,
+                          SSD1306_Color_t color);
+
 /*!
  * The function print a char in the selected position with the selected
  * color and size.
@@ -360,7 +614,8 @@ GDL_Errors_t SSD1306_drawString (SSD1306_DeviceHandle_t dev,
  * \param[in]   width: The width of picture
  * \param[in]  height: The height of picture
  * \param[in] picture: The array of the picture. Pay attention: every byte of the array
- *                     represent 8 pixel in the same row.
+ *                     represent 8 pixel in the same row, the most significant bit
+ *                     on the left, and every row starts with a new byte.
  * \return
  *         \arg \ref GDL_ERRORS_WRONG_POSITION if the dimension plus position of the char
  *                   exceeds the width or height of the display
@@ -373,6 +628,109 @@ GDL_Errors_t SSD1306_drawPicture (SSD1306_DeviceHandle_t dev,
                                   uint16_t height,
                                   const uint8_t* picture);
 
+/*!
+ * The function selects a new clip area, as intersection between the selected
+ * rectangle and the current clip area, and saves the current one.
+ * All drawing functions are limited to the clip area: the primitives
+ * completely out of the area are discarded without drawing any pixel.
+ *
+ * \param[in]    dev: The handle of the device
+ * \param[in]   xPos: The x position of the top-left corner
+ * \param[in]   yPos: The y position of the top-left corner
+ * \param[in]  width: The width of the area
+ * \param[in] height: The height of the area
+ */
+void SSD1306_pushClip (SSD1306_DeviceHandle_t dev,
+                       uint16_t xPos,
+                       uint16_t yPos,
+                       uint16_t width,
+                       uint16_t height);
+
+/*!
+ * The function restores the clip area saved by the last \ref SSD1306_pushClip.
+ *
+ * \param[in] dev: The handle of the device
+ */
+void SSD1306_popClip (SSD1306_DeviceHandle_t dev);
+
+/*!
+ * The function removes all the clip areas: the whole display can be drawn.
+ *
+ * \param[in] dev: The handle of the device
+ */
+void SSD1306_resetClip (SSD1306_DeviceHandle_t dev);
+
+/*!
+ * The function rotates the content of a square area of the internal buffer.
+ * The area is managed in blocks of 8x8 pixels with a bit transpose, so the
+ * side of the area must be a multiple of 8.
+ * A widget can be drawn normally, and then rotated to be shown with 90 or
+ * 270 degrees orientation.
+ * \note To send the design to the display, you must use \ref SSD1306_flush
+ *
+ * \param[in]      dev: The handle of the device
+ * \param[in]     xPos: The x position of the top-left corner
+ * \param[in]     yPos: The y position of the top-left corner
+ * \param[in]     size: The side of the area, multiple of 8
+ * \param[in] rotation: The clockwise rotation
+ * \return
+ *         \arg \ref GDL_ERRORS_WRONG_POSITION if the size is not a multiple of 8,
+ *                   or the area exceeds the width or height of the display
+ *         \arg \ref GDL_ERRORS_SUCCESS otherwise.
+ */
+GDL_Errors_t SSD1306_rotateArea (SSD1306_DeviceHandle_t dev,
+                                 uint8_t xPos,
+                                 uint8_t yPos,
+                                 uint8_t size,
+                                 SSD1306_Rotation_t rotation);
+
+/*!
+ * The function sets the orientation of the whole display, using the segment
+ * re-map and the COM scan direction of the driver: no pixel is moved into
+ * the internal buffer.
+ * When the horizontal mirror changes, the buffer is sent again, because the
+ * segment re-map is applied only to the data written after it. When the
+ * flush governor is enabled, it is sent by the next frame.
+ *
+ * \param[in]         dev: The handle of the device
+ * \param[in] orientation: The new orientation
+ */
+void SSD1306_setOrientation (SSD1306_DeviceHandle_t dev, SSD1306_Orientation_t orientation);
+
+/*!
+ * The function draws a grayscale picture, converted to black and white
+ * with the selected dithering algorithm.
+ * The picture is converted directly into the internal buffer, 8 lines at
+ * time, without any intermediate bitmap.
+ * With \ref SSD1306_DITHER_BAYER a pixel is on when its value is greater than
+ * 4*M+2, where M is the entry of the Bayer matrix at the display position.
+ * With \ref SSD1306_DITHER_FLOYD_STEINBERG the error is diffused with the
+ * weights 7/16, 3/16 and 5/16, rounded toward zero, and the remainder; the
+ * visible columns are processed from the first line of the picture, so the
+ * lines over the clip area change the result, the columns out of it do not.
+ * \note To send the design to the display, you must use \ref SSD1306_flush
+ *
+ * \param[in]     dev: The handle of the device
+ * \param[in]    xPos: The x position
+ * \param[in]    yPos: The y position
+ * \param[in]   width: The width of picture
+ * \param[in]  height: The height of picture
+ * \param[in] picture: The array of the picture. Every byte of the array is a
+ *                     pixel, from 0 (black) to 255 (white), row by row.
+ * \param[in]  dither: The dithering algorithm
+ * \return
+ *         \arg \ref GDL_ERRORS_WRONG_POSITION if the position exceeds the width
+ *                   or height of the display
+ *         \arg \ref GDL_ERRORS_SUCCESS otherwise.
+ */
+GDL_Errors_t SSD1306_drawGrayscale (SSD1306_DeviceHandle_t dev,
+                                    uint16_t xPos,
+                                    uint16_t yPos,
+                                    uint16_t width,
+                                    uint16_t height,
+                                    const uint8_t* picture,
+                                    SSD1306_Dither_t dither);
+
 /*!
  * The function shows black pixels on white background.
  *
@@ -399,6 +757,31 @@ void SSD1306_normalDisplay (SSD1306_DeviceHandle_t dev);
  */
 void SSD1306_scroll (SSD1306_DeviceHandle_t dev, bool scroll);
 
+/*!
+ * The function scrolls up the display content by the selected number of lines,
+ * using the display RAM as a circular buffer: only the display start line is
+ * moved, and the new lines at the bottom of the display are cleared.
+ * All drawing functions remap the positions, so the y position 0 is always
+ * the first line of the display.
+ * \note To send the new lines and the start line to the display, you must use
+ *       \ref SSD1306_flushArea or \ref SSD1306_flush; the start line alone
+ *       is sent by \ref SSD1306_flushStartLine
+ *
+ * \param[in]   dev: The handle of the device.
+ * \param[in] lines: The number of lines to scroll.
+ */
+void SSD1306_scrollLines (SSD1306_DeviceHandle_t dev, uint8_t lines);
+
+/*!
+ * The function sends a pending display start line, set by
+ * \ref SSD1306_scrollLines, without sending any data.
+ * When the flush governor is enabled, the start line is sent with the next
+ * frame.
+ *
+ * \param[in] dev: The handle of the device.
+ */
+void SSD1306_flushStartLine (SSD1306_DeviceHandle_t dev);
+
 /*!
  * This function clear the display content.
  * At the same time, the function clear the local buffer content.
@@ -410,11 +793,140 @@ void SSD1306_clear (SSD1306_DeviceHandle_t dev);
 /*!
  * This function writes all the buffer content to the display.
  * The function wrties all pixel.
+ * When the flush governor is enabled, the update is only requested, see
+ * \ref SSD1306_requestFlush.
  *
  * \param[in] dev: The handle of the device.
  */
 void SSD1306_flush (SSD1306_DeviceHandle_t dev);
 
+/*!
+ * This function writes a rectangular area of the buffer content to the display.
+ * The area is extended to whole pages (8 lines), and it is clipped to the
+ * display dimension. An empty area sends only a pending start line.
+ * The command sequence is chosen by the flush planner, see
+ * \ref SSD1306_flushRegions
+ * When the flush governor is enabled, the update is only requested, see
+ * \ref SSD1306_requestFlushArea.
+ *
+ * \param[in]    dev: The handle of the device.
+ * \param[in]   xPos: The x position of the top-left corner
+ * \param[in]   yPos: The y position of the top-left corner
+ * \param[in]  width: The width of the area
+ * \param[in] height: The height of the area
+ */
+void SSD1306_flushArea (SSD1306_DeviceHandle_t dev,
+                        uint16_t xPos,
+                        uint16_t yPos,
+                        uint16_t width,
+                        uint16_t height);
+
+/*!
+ * This function writes a list of rectangular areas of the buffer content to
+ * the display, like \ref SSD1306_flushArea: the areas are sent together by
+ * \ref SSD1306_flushRegions, or requested with
+ * \ref SSD1306_requestFlushArea when the flush governor is enabled.
+ *
+ * \param[in]     dev: The handle of the device.
+ * \param[in] regions: The areas to be sent.
+ * \param[in]   count: The number of areas.
+ */
+void SSD1306_flushAreas (SSD1306_DeviceHandle_t dev,
+                         const SSD1306_Region_t* regions,
+                         uint8_t count);
+
+/*!
+ * This function writes a list of rectangular areas of the buffer content to
+ * the display. Every area is extended to whole pages (8 lines), and it is
+ * clipped to the display dimension.
+ * The flush planner merges the areas when sending their bounding box is
+ * cheaper, and sends every block with the cheapest addressing mode among
+ * horizontal, vertical and page mode, following the cost model of the
+ * transport.
+ *
+ * \param[in]     dev: The handle of the device.
+ * \param[in] regions: The areas to be sent.
+ * \param[in]   count: The number of areas.
+ */
+void SSD1306_flushRegions (SSD1306_DeviceHandle_t dev,
+                           const SSD1306_Region_t* regions,
+                           uint8_t count);
+
+/*!
+ * This function changes the cost model used by the flush planner. A default
+ * model for the transport is selected by \ref SSD1306_init.
+ *
+ * \param[in]  dev: The handle of the device.
+ * \param[in] cost: The new cost model.
+ */
+void SSD1306_setCostModel (SSD1306_DeviceHandle_t dev, const SSD1306_CostModel_t* cost);
+
+/*!
+ * This function enables the flush governor: the flush requests are merged,
+ * and at most one update is sent for each frame.
+ * The frames follow the target rate; when \ref SSD1306_processFlush is
+ * called late, the next frame can come earlier to keep the pace, but never
+ * faster than the maximum rate. After an idle period, the first update is
+ * sent at once.
+ *
+ * \param[in]     dev: The handle of the device.
+ * \param[in]  target: The target frame rate in Hz, 0 to disable the governor.
+ * \param[in] maximum: The maximum frame rate in Hz, at least the target rate.
+ */
+void SSD1306_setFrameRate (SSD1306_DeviceHandle_t dev, uint8_t target, uint8_t maximum);
+
+/*!
+ * This function marks the whole display as changed. The update is sent by
+ * \ref SSD1306_processFlush or \ref SSD1306_forceFlush.
+ *
+ * \param[in] dev: The handle of the device.
+ */
+void SSD1306_requestFlush (SSD1306_DeviceHandle_t dev);
+
+/*!
+ * This function marks a rectangular area of the display as changed. The
+ * pending areas are merged, and the update is sent by
+ * \ref SSD1306_processFlush or \ref SSD1306_forceFlush.
+ *
+ * \param[in]    dev: The handle of the device.
+ * \param[in]   xPos: The x position of the top-left corner
+ * \param[in]   yPos: The y position of the top-left corner
+ * \param[in]  width: The width of the area
+ * \param[in] height: The height of the area
+ */
+void SSD1306_requestFlushArea (SSD1306_DeviceHandle_t dev,
+                               uint16_t xPos,
+                               uint16_t yPos,
+                               uint16_t width,
+                               uint16_t height);
+
+/*!
+ * This function must be called periodically: it sends the pending update
+ * when the next frame is due. Without governor, the pending update is sent
+ * at once.
+ *
+ * \param[in] dev: The handle of the device.
+ * \return TRUE when an update was sent.
+ */
+bool SSD1306_processFlush (SSD1306_DeviceHandle_t dev);
+
+/*!
+ * This function sends the pending update at once, whatever is the frame
+ * rate, e.g. for urgent alerts.
+ *
+ * \param[in] dev: The handle of the device.
+ */
+void SSD1306_forceFlush (SSD1306_DeviceHandle_t dev);
+
+#if defined (SSD1306_STATISTICS)
+/*!
+ * This function clears the bus statistics of the device.
+ *
+ * \param[in] dev: The handle of the device.
+ */
+void SSD1306_resetStatistics (SSD1306_DeviceHandle_t dev);
+#endif
+
 /*!
  * This function turn the OLED panel display ON.
  *
@@ -424,11 +936,45 @@ void SSD1306_on (SSD1306_DeviceHandle_t dev);
 
 /*!
  * This function turn the OLED panel display OFF.
+ * The display OFF is the sleep mode of the driver, but the internal charge
+ * pump keeps running: use \ref SSD1306_suspend to stop it too.
  *
  * \param[in] dev: The handle of the device
  */
 void SSD1306_off (SSD1306_DeviceHandle_t dev);
 
+/*!
+ * This function puts the display in sleep mode.
+ * The driver keeps display RAM content, contrast, inversion, scrolling and
+ * all other settings, so the display can be waked up with \ref SSD1306_resume
+ * without a new initialization and without sending the buffer.
+ * When the product uses the internal charge pump, it is disabled after the
+ * display OFF command.
+ *
+ * \param[in] dev: The handle of the device
+ */
+void SSD1306_suspend (SSD1306_DeviceHandle_t dev);
+
+/*!
+ * This function wakes up the display from sleep mode. When the product uses
+ * the internal charge pump, it is enabled before the display ON command.
+ *
+ * \param[in] dev: The handle of the device
+ */
+void SSD1306_resume (SSD1306_DeviceHandle_t dev);
+
+/*!
+ * This function sends again the whole configuration and the buffer, from the
+ * state saved into the device, without reset and without clearing the buffer.
+ * It must be used only when the display lost its content, for example
+ * after the power supply of the display was removed.
+ * The display is turned on with \ref SSD1306_resume, so also the charge
+ * pump is started, unless it is suspended.
+ *
+ * \param[in] dev: The handle of the device
+ */
+void SSD1306_restore (SSD1306_DeviceHandle_t dev);
+
 /*!
  * This function sets the contrast setting of the display.
  * The display has 256 contrast steps: from 00h to FFh.
@@ -0,0 +1,328 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef __WARCOMEB_SSD1306_HPP
+#define __WARCOMEB_SSD1306_HPP
+
+#include "ssd1306.h"
+
+/*!
+ * \defgroup SSD1306_Cpp
+ * \ingroup SSD1306
+ *
+ * Header-only C++ front-end of the driver.
+ * The geometry is a template parameter, so the pixel addressing is compiled
+ * down to shifts and masks, and the transport is a class with static
+ * functions, so every transfer of the full flush is inlined.
+ * The wrapped device is a plain \ref SSD1306_Device_t: all functions of the
+ * C API can be used with \ref ssd1306::Display::handle.
+ * \{
+ */
+
+namespace ssd1306
+{
+
+#if defined (LIBOHIBOARD_IIC)
+
+/*!
+ * I2C transport, it uses the peripheral and the address of the device.
+ */
+struct IicTransport
+{
+    static inline void sendCommands (SSD1306_DeviceHandle_t dev, uint8_t* commands, uint8_t length)
+    {
+        write(dev, 0x00, commands, length);
+    }
+
+    static inline void sendData (SSD1306_DeviceHandle_t dev, uint8_t* data, uint8_t length)
+    {
+        write(dev, 0x40, data, length);
+    }
+
+private:
+    static inline void write (SSD1306_DeviceHandle_t dev, uint8_t control, uint8_t* data, uint8_t length)
+    {
+        uint8_t retry = 3;
+        System_Errors err = ERRORS_NO_ERROR;
+        do
+        {
+            err = Iic_writeRegister(dev->config.iicDev,
+                                    dev->address,
+                                    control,
+                                    IIC_REGISTERADDRESSSIZE_8BIT,
+                                    data,
+                                    length,
+                                    100);
+            retry--;
+        } while (retry > 0 && err != ERRORS_NO_ERROR);
+    }
+};
+
+#endif
+
+/*!
+ * SSD1306 display with compile-time geometry.
+ * The geometry does not change the size of the buffer, see \ref pages.
+ *
+ * \tparam     Width: The width of the display, in pixels.
+ * \tparam    Height: The height of the display, in pixels.
+ * \tparam Transport: The class with the static functions sendCommands and
+ *                    sendData, used by the full flush.
+ */
+template <uint8_t Width, uint8_t Height, class Transport>
+class Display
+{
+public:
+    static constexpr uint8_t width  = Width;
+    static constexpr uint8_t height = Height;
+
+    /*! The buffer is an image of the whole display RAM, 64 rows also for
+     *  shorter displays. The scrolling moves the display start line over
+     *  all 64 RAM rows, and every RAM row can be shown: a buffer of Height
+     *  rows could follow it only when Height divides 64. The wrapped device
+     *  is also shared with the C API, that addresses all 64 rows.
+     *  So the storage is not reduced by the geometry: the device always
+     *  holds \ref SSD1306_BUFFER_DIMENSION bytes, and \ref bufferSize is
+     *  the part used with this width. */
+    static constexpr uint8_t pages = SSD1306_MAX_DISPLAY_HEIGHT / 8;
+    static constexpr uint16_t bufferSize = static_cast<uint16_t>(Width) * pages;
+
+    static_assert((Width > 0) && (Width <= SSD1306_MAX_DISPLAY_WIDTH), "Wrong display width");
+    static_assert((Height > 0) && (Height <= SSD1306_MAX_DISPLAY_HEIGHT) && ((Height % 8) == 0),
+                  "Wrong display height");
+
+    /*!
+     * The constructor initialize and configure the display through
+     * \ref SSD1306_init: the product must match the geometry.
+     *
+     * \param[in] config: A structure with all configuration parameters.
+     */
+    explicit Display (SSD1306_Config_t& config)
+    {
+        SSD1306_init(&mDevice, &config);
+        ohiassert((mDevice.gdl.width == Width) && (mDevice.gdl.height == Height));
+    }
+
+    Display (const Display&) = delete;
+    Display& operator= (const Display&) = delete;
+
+    /*!
+     * The function returns the handle of the device, for the C API.
+     */
+    inline SSD1306_DeviceHandle_t handle ()
+    {
+        return &mDevice;
+    }
+
+    /*!
+     * The function returns the internal buffer, of \ref bufferSize bytes.
+     */
+    inline uint8_t* buffer ()
+    {
+        return mDevice.buffer;
+    }
+
+    /*!
+     * The function draws a single pixel into internal buffer, like
+     * \ref SSD1306_drawPixel: the clip area and the scroll offset are
+     * honoured.
+     *
+     * \param[in]  xPos: The x position
+     * \param[in]  yPos: The y position
+     * \param[in] color: The color of the pixel
+     */
+    inline void drawPixel (uint8_t xPos, uint8_t yPos, SSD1306_Color_t color)
+    {
+        if ((xPos < mDevice.clip.xStart) || (xPos >= mDevice.clip.xStop) ||
+            (yPos < mDevice.clip.yStart) || (yPos >= mDevice.clip.yStop))
+            return;
+
+        uint8_t* data = &mDevice.buffer[index(xPos, yPos)];
+        uint8_t mask  = bit(yPos);
+        if (color == SSD1306_COLOR_BLACK)
+            *data &= static_cast<uint8_t>(~mask);
+        else
+            *data |= mask;
+    }
+
+    /*!
+     * The function returns the color of a pixel of the internal buffer.
+     *
+     * \param[in] xPos: The x position
+     * \param[in] yPos: The y position
+     */
+    inline SSD1306_Color_t getPixel (uint8_t xPos, uint8_t yPos) const
+    {
+        if ((xPos >= Width) || (yPos >= Height))
+            return SSD1306_COLOR_BLACK;
+
+        return (mDevice.buffer[index(xPos, yPos)] & bit(yPos)) ? SSD1306_COLOR_COLOR : SSD1306_COLOR_BLACK;
+    }
+
+    /*!
+     * The function clears the internal buffer.
+     * \note To send the design to the display, you must use \ref flush
+     */
+    inline void clear ()
+    {
+        memset(mDevice.buffer, 0x00, bufferSize);
+    }
+
+    /*!
+     * The function writes the visible lines of the buffer to the display,
+     * with horizontal addressing and a full width window over the pages of
+     * the display RAM shown from the current start line.
+     * When the flush governor is enabled, the update is only requested, see
+     * \ref SSD1306_requestFlush. Otherwise the flush planner is not used:
+     * a full width window is always its choice for the whole display.
+     */
+    void flush ()
+    {
+        if (mDevice.frameTime > 0)
+        {
+            SSD1306_requestFlush(&mDevice);
+            return;
+        }
+
+        // Remap the lines into the display RAM circular buffer
+        uint8_t rowStart = mDevice.startLine;
+        uint8_t rowEnd   = rowStart + Height - 1;
+
+        if (rowEnd < SSD1306_MAX_DISPLAY_HEIGHT)
+        {
+            sendPages(rowStart / 8, rowEnd / 8);
+        }
+        else if ((((rowEnd - SSD1306_MAX_DISPLAY_HEIGHT) / 8) + 1) >= (rowStart / 8))
+        {
+            // The two parts cover all pages, or share one: a single window
+            sendPages(0, pages - 1);
+        }
+        else
+        {
+            // The lines wrap around the end of display RAM
+            sendPages(rowStart / 8, pages - 1);
+            sendPages(0, (rowEnd - SSD1306_MAX_DISPLAY_HEIGHT) / 8);
+        }
+
+        // The new start line is sent after the data
+        if (mDevice.isStartLineChanged)
+        {
+            uint8_t command = static_cast<uint8_t>(CMD_SETDISPLAYSTARTLINE | mDevice.startLine);
+            Transport::sendCommands(&mDevice, &command, 1);
+            countTransaction(true, 1);
+            mDevice.isStartLineChanged = FALSE;
+        }
+    }
+
+    /*!
+     * The function writes a rectangular area of the buffer content to the
+     * display, see \ref SSD1306_flushArea.
+     */
+    inline void flushArea (uint16_t xPos, uint16_t yPos, uint16_t width, uint16_t height)
+    {
+        SSD1306_flushArea(&mDevice, xPos, yPos, width, height);
+    }
+
+private:
+    static constexpr uint8_t CMD_SETADDRESSINGMODE   = 0x20;
+    static constexpr uint8_t CMD_SETCOLUMNADDRESS    = 0x21;
+    static constexpr uint8_t CMD_SETPAGEADDRESS      = 0x22;
+    static constexpr uint8_t CMD_SETDISPLAYSTARTLINE = 0x40;
+    static constexpr uint8_t ADDRESSING_HORIZONTAL   = 0x00;
+
+    /*!
+     * The function sends the selected pages of the display RAM, full width.
+     */
+    inline void sendPages (uint8_t pageStart, uint8_t pageEnd)
+    {
+        uint8_t commands[8];
+        uint8_t count = 0;
+
+        if (mDevice.addressingMode != ADDRESSING_HORIZONTAL)
+        {
+            commands[count++] = CMD_SETADDRESSINGMODE;
+            commands[count++] = ADDRESSING_HORIZONTAL;
+            mDevice.addressingMode = ADDRESSING_HORIZONTAL;
+        }
+        commands[count++] = CMD_SETCOLUMNADDRESS;
+        commands[count++] = 0;
+        commands[count++] = Width - 1;
+        commands[count++] = CMD_SETPAGEADDRESS;
+        commands[count++] = pageStart;
+        commands[count++] = pageEnd;
+        Transport::sendCommands(&mDevice, commands, count);
+        countTransaction(true, count);
+
+        for (uint8_t page = pageStart; page <= pageEnd; ++page)
+        {
+            Transport::sendData(&mDevice, &mDevice.buffer[static_cast<uint16_t>(page) * Width], Width);
+            countTransaction(false, Width);
+        }
+    }
+
+    /*!
+     * The position of a pixel into the buffer, with the row remapped into
+     * the display RAM circular buffer.
+     */
+    inline uint16_t index (uint8_t xPos, uint8_t yPos) const
+    {
+        uint8_t row = (yPos + mDevice.startLine) & (SSD1306_MAX_DISPLAY_HEIGHT - 1);
+        return static_cast<uint16_t>(row >> 3) * Width + xPos;
+    }
+
+    /*!
+     * The function updates the bus statistics, when they are enabled.
+     */
+    inline void countTransaction (bool isCommand, uint8_t length)
+    {
+#if defined (SSD1306_STATISTICS)
+        mDevice.statistics.transactions++;
+        if (isCommand)
+            mDevice.statistics.commandBytes += length;
+        else
+            mDevice.statistics.dataBytes += length;
+#else
+        (void)isCommand;
+        (void)length;
+#endif
+    }
+
+    inline uint8_t bit (uint8_t yPos) const
+    {
+        return static_cast<uint8_t>(1u << ((yPos + mDevice.startLine) & 0x07));
+    }
+
+    SSD1306_Device_t mDevice;
+};
+
+}
+
+/*!
+ * \}
+ */
+
+#endif // __WARCOMEB_SSD1306_HPP
@@ -0,0 +1,261 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+/*!
+ * \file  /ssd1306anim.c
+ * \brief
+ */
+
+#include "ssd1306anim.h"
+
+/*!
+ * The function returns the rows of a page of the animation.
+ *
+ * \param[in] animation: The animation.
+ * \param[in]      page: The page.
+ * \return The mask of the rows into the animation.
+ */
+static uint8_t getRows (const SSD1306_Animation_t* animation, uint8_t page)
+{
+    uint8_t rows = animation->height - page * 8;
+    return (rows < 8) ? (uint8_t)((1u << rows) - 1) : 0xFF;
+}
+
+/*!
+ * The function decodes a delta into the buffer and sends the changed spans
+ * together, so the flush planner can merge them. With the flush governor,
+ * the spans wait for its next frame like the rest of the display.
+ *
+ * \param[in] player: The handle of the player.
+ */
+static void drawDelta (SSD1306_AnimationPlayerHandle_t player)
+{
+    SSD1306_DeviceHandle_t dev = player->dev;
+    const uint8_t* data = player->next;
+    SSD1306_Region_t regions [SSD1306_ANIMATION_REGION_DIMENSION];
+    uint8_t count = 0;
+
+    while (*data != SSD1306_ANIMATION_END_OF_FRAME)
+    {
+        uint8_t page   = *data++;
+        uint8_t column = *data++;
+        uint8_t length = *data++;
+
+        uint8_t rows = getRows(player->animation, page);
+        uint16_t x   = (uint16_t)player->xPos + column;
+        uint16_t y   = (uint16_t)player->yPos + page * 8;
+        uint8_t visible = 0;
+
+        for (uint8_t i = 0; i < length; ++i, ++data)
+        {
+            // The columns out of the display are skipped, never wrapped
+            if (((x + i) >= dev->gdl.width) || (y >= dev->gdl.height))
+                continue;
+
+            // The changed pixels are inverted
+            SSD1306_writeColumn(dev, x + i, y, ~SSD1306_readColumn(dev, x + i, y), *data & rows);
+            visible++;
+        }
+        if (visible == 0)
+            continue;
+
+        if (count == SSD1306_ANIMATION_REGION_DIMENSION)
+        {
+            SSD1306_flushAreas(dev, regions, count);
+            count = 0;
+        }
+        regions[count].xPos   = x;
+        regions[count].yPos   = y;
+        regions[count].width  = visible;
+        regions[count].height = (rows == 0xFF) ? 8 : (player->animation->height - page * 8);
+        count++;
+    }
+    SSD1306_flushAreas(dev, regions, count);
+
+    player->frame++;
+    player->next = data + 1;
+
+    // The last delta goes back to the keyframe
+    if (player->frame == player->animation->frameCount)
+    {
+        player->frame = 0;
+        player->next  = player->animation->deltas;
+    }
+}
+
+void SSD1306_animationInit (SSD1306_AnimationPlayerHandle_t player,
+                            SSD1306_DeviceHandle_t dev,
+                            const SSD1306_Animation_t* animation,
+                            uint8_t xPos,
+                            uint8_t yPos,
+                            uint8_t frameRate,
+                            bool isLoop)
+{
+    ohiassert(player != NULL);
+    ohiassert(dev != NULL);
+    ohiassert(animation != NULL);
+    ohiassert(frameRate > 0);
+
+    memset(player, 0, sizeof(SSD1306_AnimationPlayer_t));
+
+    player->dev       = dev;
+    player->animation = animation;
+    player->xPos      = xPos;
+    player->yPos      = yPos;
+    player->frameTime = 1000 / frameRate;
+    player->isLoop    = isLoop;
+}
+
+void SSD1306_animationStart (SSD1306_AnimationPlayerHandle_t player)
+{
+    const SSD1306_Animation_t* animation = player->animation;
+    const uint8_t* data = animation->keyframe;
+
+    for (uint8_t page = 0; page < ((animation->height + 7) / 8); ++page)
+    {
+        uint8_t rows = getRows(animation, page);
+        uint16_t y   = (uint16_t)player->yPos + page * 8;
+        for (uint8_t column = 0; column < animation->width; ++column, ++data)
+        {
+            uint16_t x = (uint16_t)player->xPos + column;
+            if ((x < player->dev->gdl.width) && (y < player->dev->gdl.height))
+            {
+                SSD1306_writeColumn(player->dev, x, y, *data, rows);
+            }
+        }
+    }
+    SSD1306_flushArea(player->dev, player->xPos, player->yPos, animation->width, animation->height);
+
+    player->frame     = 0;
+    player->next      = animation->deltas;
+    player->lastFrame = System_currentTick();
+    player->isRunning = (animation->frameCount > 1);
+}
+
+void SSD1306_animationStop (SSD1306_AnimationPlayerHandle_t player)
+{
+    player->isRunning = FALSE;
+}
+
+bool SSD1306_animationProcess (SSD1306_AnimationPlayerHandle_t player)
+{
+    if (!player->isRunning)
+        return FALSE;
+
+    uint32_t now = System_currentTick();
+    if ((now - player->lastFrame) < player->frameTime)
+        return TRUE;
+
+    // Keep the frame rate, unless the player is late more than a frame
+    player->lastFrame += player->frameTime;
+    if ((now - player->lastFrame) >= player->frameTime)
+        player->lastFrame = now;
+
+    drawDelta(player);
+
+    if (!player->isLoop && (player->frame == (player->animation->frameCount - 1)))
+        player->isRunning = FALSE;
+
+    return player->isRunning;
+}
+
+uint32_t SSD1306_encodeDelta (const uint8_t* previous,
+                              const uint8_t* next,
+                              uint8_t width,
+                              uint8_t height,
+                              uint8_t* output,
+                              uint32_t size)
+{
+    uint32_t length = 0;
+
+    for (uint8_t page = 0; page < ((height + 7) / 8); ++page)
+    {
+        uint16_t index = (uint16_t)page * width;
+        uint8_t column = 0;
+
+        while (column < width)
+        {
+            if (previous[index + column] == next[index + column])
+            {
+                column++;
+                continue;
+            }
+
+            // Extend the span while the next change is near enough
+            uint8_t start = column;
+            uint8_t stop  = column;
+            for (uint8_t i = column + 1; (i < width) && ((i - stop) <= SSD1306_ANIMATION_SPAN_GAP); ++i)
+            {
+                if (previous[index + i] != next[index + i])
+                    stop = i;
+            }
+
+            if ((length + 3 + (stop - start + 1)) > size)
+                return 0;
+
+            output[length++] = page;
+            output[length++] = start;
+            output[length++] = stop - start + 1;
+            for (uint8_t i = start; i <= stop; ++i)
+            {
+                output[length++] = previous[index + i] ^ next[index + i];
+            }
+            column = stop + 1;
+        }
+    }
+
+    if (length >= size)
+        return 0;
+
+    output[length++] = SSD1306_ANIMATION_END_OF_FRAME;
+    return length;
+}
+
+uint32_t SSD1306_encodeAnimation (const uint8_t* frames,
+                                  uint16_t frameCount,
+                                  uint8_t width,
+                                  uint8_t height,
+                                  uint8_t* output,
+                                  uint32_t size)
+{
+    uint16_t frameSize = (uint16_t)width * ((height + 7) / 8);
+    uint32_t length = 0;
+
+    for (uint16_t frame = 0; frame < frameCount; ++frame)
+    {
+        // The last delta goes back to the keyframe
+        const uint8_t* previous = &frames[(uint32_t)frame * frameSize];
+        const uint8_t* next     = &frames[(uint32_t)((frame + 1) % frameCount) * frameSize];
+
+        uint32_t delta = SSD1306_encodeDelta(previous, next, width, height, &output[length], size - length);
+        if (delta == 0)
+            return 0;
+
+        length += delta;
+    }
+    return length;
+}
@@ -0,0 +1,196 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef __WARCOMEB_SSD1306_ANIM_H
+#define __WARCOMEB_SSD1306_ANIM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ssd1306.h"
+
+/*!
+ * \defgroup SSD1306_Animation
+ * \ingroup SSD1306
+ * \{
+ */
+
+/*!
+ * The marker of the end of a frame into the delta stream.
+ */
+#define SSD1306_ANIMATION_END_OF_FRAME      0xFF
+
+/*!
+ * The maximum number of unchanged bytes merged into a span by the encoder:
+ * sending them is cheaper than starting a new span.
+ */
+#define SSD1306_ANIMATION_SPAN_GAP          4
+
+/*!
+ * The maximum number of spans sent together by the player.
+ */
+#define SSD1306_ANIMATION_REGION_DIMENSION  8
+
+/*!
+ * SSD1306 animation class.
+ * The first frame is stored as a page-major keyframe, like the display
+ * buffer. Every other frame is stored as the difference from the previous
+ * one, a list of spans terminated by \ref SSD1306_ANIMATION_END_OF_FRAME:
+ *
+ *     page, column, length, length bytes to be XORed into the frame
+ *
+ * The stream holds one delta for every frame: the last one goes back to the
+ * keyframe, so the animation can loop without drawing the keyframe again.
+ */
+typedef struct _SSD1306_Animation_t
+{
+    uint8_t width;
+    uint8_t height;
+    uint16_t frameCount;
+
+    const uint8_t* keyframe;     /*!< The first frame */
+    const uint8_t* deltas;       /*!< The delta stream */
+
+} SSD1306_Animation_t;
+
+/*!
+ * SSD1306 animation player class.
+ */
+typedef struct _SSD1306_AnimationPlayer_t
+{
+    SSD1306_DeviceHandle_t dev;
+    const SSD1306_Animation_t* animation;
+
+    uint8_t xPos;
+    uint8_t yPos;
+
+    uint32_t frameTime;          /*!< Time between two frames in ms */
+    uint32_t lastFrame;          /*!< Tick of the last frame */
+    uint16_t frame;              /*!< The frame on the display */
+    const uint8_t* next;         /*!< The delta of the next frame */
+    bool isLoop;
+    bool isRunning;
+
+} SSD1306_AnimationPlayer_t, *SSD1306_AnimationPlayerHandle_t;
+
+/*!
+ * The function initialize the player.
+ * The part of the animation out of the display is not drawn. The frames are
+ * sent with \ref SSD1306_flushAreas, so with the flush governor they are
+ * sent by its next frame.
+ *
+ * \param[in]    player: The handle of the player.
+ * \param[in]       dev: The handle of the device.
+ * \param[in] animation: The animation to be played.
+ * \param[in]      xPos: The x position of the animation.
+ * \param[in]      yPos: The y position of the animation.
+ * \param[in] frameRate: The number of frames per second.
+ * \param[in]    isLoop: Restart the animation at the end.
+ */
+void SSD1306_animationInit (SSD1306_AnimationPlayerHandle_t player,
+                            SSD1306_DeviceHandle_t dev,
+                            const SSD1306_Animation_t* animation,
+                            uint8_t xPos,
+                            uint8_t yPos,
+                            uint8_t frameRate,
+                            bool isLoop);
+
+/*!
+ * The function draws and sends the keyframe, and starts the animation.
+ *
+ * \param[in] player: The handle of the player.
+ */
+void SSD1306_animationStart (SSD1306_AnimationPlayerHandle_t player);
+
+/*!
+ * The function stops the animation, leaving the current frame on the display.
+ *
+ * \param[in] player: The handle of the player.
+ */
+void SSD1306_animationStop (SSD1306_AnimationPlayerHandle_t player);
+
+/*!
+ * The function must be called periodically. When the frame time is elapsed,
+ * the next delta is decoded into the buffer and only the changed spans are
+ * sent to the display.
+ *
+ * \param[in] player: The handle of the player.
+ * \return TRUE while the animation is running.
+ */
+bool SSD1306_animationProcess (SSD1306_AnimationPlayerHandle_t player);
+
+/*!
+ * The function encodes the difference between two page-major frames as a
+ * list of spans, terminated by \ref SSD1306_ANIMATION_END_OF_FRAME.
+ * It does not depend on the device, so it can be used to convert the
+ * animations on the host too.
+ *
+ * \param[in] previous: The previous frame.
+ * \param[in]     next: The next frame.
+ * \param[in]    width: The width of the frames.
+ * \param[in]   height: The height of the frames.
+ * \param[out]  output: The delta.
+ * \param[in]     size: The dimension of the output.
+ * \return The number of bytes of the delta, 0 when the output is too small.
+ */
+uint32_t SSD1306_encodeDelta (const uint8_t* previous,
+                              const uint8_t* next,
+                              uint8_t width,
+                              uint8_t height,
+                              uint8_t* output,
+                              uint32_t size);
+
+/*!
+ * The function encodes the delta stream of an animation, from all its
+ * page-major frames stored one after the other. The first frame is the
+ * keyframe of the animation.
+ *
+ * \param[in]     frames: The frames.
+ * \param[in] frameCount: The number of frames.
+ * \param[in]      width: The width of the frames.
+ * \param[in]     height: The height of the frames.
+ * \param[out]    output: The delta stream.
+ * \param[in]       size: The dimension of the output.
+ * \return The number of bytes of the stream, 0 when the output is too small.
+ */
+uint32_t SSD1306_encodeAnimation (const uint8_t* frames,
+                                  uint16_t frameCount,
+                                  uint8_t width,
+                                  uint8_t height,
+                                  uint8_t* output,
+                                  uint32_t size);
+
+/*!
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __WARCOMEB_SSD1306_ANIM_H
@@ -0,0 +1,444 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+/*!
+ * \file  /ssd1306canvas.c
+ * \brief
+ */
+
+#include "ssd1306canvas.h"
+
+/*!
+ * The function marks a column of the canvas as changed, when it is shown by
+ * the panels.
+ *
+ * \param[in] canvas: The handle of the canvas.
+ * \param[in]   xPos: The column of the canvas, already wrapped.
+ */
+static void setDirty (SSD1306_CanvasHandle_t canvas, uint16_t xPos)
+{
+    // The columns exposed by a movement are copied anyway
+    uint16_t column = (xPos >= canvas->xShown) ? (xPos - canvas->xShown) :
+                                                 (xPos + canvas->width - canvas->xShown);
+    if (column >= canvas->viewWidth)
+        return;
+
+    if (canvas->dirtyStart >= canvas->dirtyStop)
+    {
+        canvas->dirtyStart = column;
+        canvas->dirtyStop  = column + 1;
+    }
+    else
+    {
+        if (column < canvas->dirtyStart)  canvas->dirtyStart = column;
+        if (column >= canvas->dirtyStop)  canvas->dirtyStop  = column + 1;
+    }
+}
+
+/*!
+ * The function reads 8 vertical pixels of the canvas starting from any line.
+ *
+ * \param[in] canvas: The handle of the canvas.
+ * \param[in]   xPos: The column of the canvas, already wrapped.
+ * \param[in]   yPos: The y position of the first pixel.
+ * \return The 8 pixels, bit 0 on top.
+ */
+static uint8_t readColumn (SSD1306_CanvasHandle_t canvas, uint16_t xPos, uint8_t yPos)
+{
+    uint8_t pages = (canvas->height + 7) / 8;
+    uint8_t page  = yPos / 8;
+    uint8_t shift = yPos % 8;
+
+    if (page >= pages)
+        return 0;
+
+    uint8_t bits = canvas->buffer[(uint32_t)page * canvas->width + xPos] >> shift;
+    if ((shift != 0) && ((page + 1) < pages))
+    {
+        bits |= canvas->buffer[(uint32_t)(page + 1) * canvas->width + xPos] << (8 - shift);
+    }
+    return bits;
+}
+
+/*!
+ * The function copies columns of the viewport from the canvas into the
+ * panels.
+ *
+ * \param[in] canvas: The handle of the canvas.
+ * \param[in]  start: The first column of the viewport.
+ * \param[in]   stop: The column after the last one.
+ */
+static void copyColumns (SSD1306_CanvasHandle_t canvas, uint16_t start, uint16_t stop)
+{
+    uint16_t offset = 0;
+    for (uint8_t i = 0; i < canvas->panelCount; ++i)
+    {
+        SSD1306_DeviceHandle_t dev = canvas->panels[i];
+        uint16_t first = (start > offset) ? start : offset;
+        uint16_t last  = (stop < (offset + dev->gdl.width)) ? stop : (offset + dev->gdl.width);
+
+        for (uint16_t column = first; column < last; ++column)
+        {
+            uint16_t xPos = (canvas->xView + column) % canvas->width;
+            for (uint8_t row = 0; row < canvas->viewHeight; row += 8)
+            {
+                uint8_t rows = ((canvas->viewHeight - row) < 8) ?
+                               (uint8_t)((1u << (canvas->viewHeight - row)) - 1) : 0xFF;
+                SSD1306_writeColumn(dev, column - offset, row,
+                                    readColumn(canvas, xPos, canvas->yView + row), rows);
+            }
+        }
+        offset += dev->gdl.width;
+    }
+}
+
+/*!
+ * The function sends columns of the viewport with \ref SSD1306_flushArea.
+ *
+ * \param[in] canvas: The handle of the canvas.
+ * \param[in]  start: The first column of the viewport.
+ * \param[in]   stop: The column after the last one.
+ */
+static void sendColumns (SSD1306_CanvasHandle_t canvas, uint16_t start, uint16_t stop)
+{
+    uint16_t offset = 0;
+    for (uint8_t i = 0; i < canvas->panelCount; ++i)
+    {
+        SSD1306_DeviceHandle_t dev = canvas->panels[i];
+        uint16_t first = (start > offset) ? start : offset;
+        uint16_t last  = (stop < (offset + dev->gdl.width)) ? stop : (offset + dev->gdl.width);
+
+        if (first < last)
+            SSD1306_flushArea(dev, first - offset, 0, last - first, canvas->viewHeight);
+        offset += dev->gdl.width;
+    }
+}
+
+/*!
+ * The function checks that no panel has a clip area, so their buffers can
+ * be moved directly.
+ *
+ * \param[in] canvas: The handle of the canvas.
+ */
+static bool isPanelClipFull (SSD1306_CanvasHandle_t canvas)
+{
+    for (uint8_t i = 0; i < canvas->panelCount; ++i)
+    {
+        SSD1306_DeviceHandle_t dev = canvas->panels[i];
+        if ((dev->clip.xStart != 0) || (dev->clip.yStart != 0) ||
+            (dev->clip.xStop != dev->gdl.width) || (dev->clip.yStop != dev->gdl.height))
+            return FALSE;
+    }
+    return TRUE;
+}
+
+/*!
+ * The function moves columns inside the buffer of a panel, only for the
+ * lines of the viewport: every page of the display RAM is moved at once,
+ * with a mask when it has lines out of the viewport.
+ *
+ * \param[in] canvas: The handle of the canvas.
+ * \param[in]    dev: The panel.
+ * \param[in]     to: The first column of the destination.
+ * \param[in]   from: The first column of the source.
+ * \param[in]  count: The number of columns.
+ */
+static void moveColumns (SSD1306_CanvasHandle_t canvas,
+                         SSD1306_DeviceHandle_t dev,
+                         uint8_t to,
+                         uint8_t from,
+                         uint8_t count)
+{
+    for (uint8_t page = 0; page < (SSD1306_MAX_DISPLAY_HEIGHT / 8); ++page)
+    {
+        // The lines of the page shown into the viewport
+        uint8_t mask = 0;
+        for (uint8_t i = 0; i < 8; ++i)
+        {
+            uint8_t line = (page * 8 + i - dev->startLine) & (SSD1306_MAX_DISPLAY_HEIGHT - 1);
+            if (line < canvas->viewHeight)
+                mask |= (uint8_t)(1u << i);
+        }
+
+        uint8_t* data = &dev->buffer[(uint16_t)page * dev->gdl.width];
+        if (mask == 0xFF)
+        {
+            memmove(&data[to], &data[from], count);
+        }
+        else if (mask != 0)
+        {
+            // Same direction of memmove, so the source is read before it is changed
+            for (uint8_t i = 0; i < count; ++i)
+            {
+                uint8_t k = (to < from) ? i : (count - 1 - i);
+                data[to + k] = (data[to + k] & ~mask) | (data[from + k] & mask);
+            }
+        }
+    }
+}
+
+/*!
+ * The function moves the content of the panels by some columns, like the
+ * viewport moves: the columns that go out of a panel are copied into the
+ * next one, the columns exposed at the border of the viewport are left
+ * unchanged.
+ *
+ * \param[in] canvas: The handle of the canvas.
+ * \param[in]  shift: The movement of the viewport, positive to the right,
+ *                    shorter than the viewport.
+ */
+static void movePanels (SSD1306_CanvasHandle_t canvas, int32_t shift)
+{
+    // The sources are read before they are changed: from the left panel
+    // when the viewport moves to the right, from the right panel otherwise
+    for (uint8_t n = 0; n < canvas->panelCount; ++n)
+    {
+        uint8_t i = (shift > 0) ? n : (canvas->panelCount - 1 - n);
+        SSD1306_DeviceHandle_t dev = canvas->panels[i];
+        int32_t width = dev->gdl.width;
+        int32_t offset = 0;
+        for (uint8_t k = 0; k < i; ++k)
+            offset += canvas->panels[k]->gdl.width;
+
+        // The columns that stay into the panel
+        if (shift > 0)
+        {
+            if (shift < width)
+                moveColumns(canvas, dev, 0, shift, width - shift);
+        }
+        else
+        {
+            if (-shift < width)
+                moveColumns(canvas, dev, -shift, 0, width + shift);
+        }
+
+        // The columns that come from the other panels
+        int32_t first = (shift > 0) ? ((width > shift) ? (width - shift) : 0) : 0;
+        int32_t last  = (shift > 0) ? width : ((width < -shift) ? width : -shift);
+        for (int32_t column = first; column < last; ++column)
+        {
+            int32_t source = offset + column + shift;
+            if ((source < 0) || (source >= canvas->viewWidth))
+                continue;
+
+            // The panel of the source
+            uint8_t k = 0;
+            int32_t sourceOffset = 0;
+            while ((source - sourceOffset) >= canvas->panels[k]->gdl.width)
+                sourceOffset += canvas->panels[k++]->gdl.width;
+
+            for (uint8_t row = 0; row < canvas->viewHeight; row += 8)
+            {
+                uint8_t rows = ((canvas->viewHeight - row) < 8) ?
+                               (uint8_t)((1u << (canvas->viewHeight - row)) - 1) : 0xFF;
+                SSD1306_writeColumn(dev, column, row,
+                                    SSD1306_readColumn(canvas->panels[k], source - sourceOffset, row), rows);
+            }
+        }
+    }
+}
+
+void SSD1306_canvasInit (SSD1306_CanvasHandle_t canvas,
+                         uint8_t* buffer,
+                         uint16_t width,
+                         uint8_t height)
+{
+    ohiassert(canvas != NULL);
+    ohiassert(buffer != NULL);
+    ohiassert((width > 0) && (height > 0));
+
+    memset(canvas, 0, sizeof(SSD1306_Canvas_t));
+
+    canvas->buffer = buffer;
+    canvas->width  = width;
+    canvas->height = height;
+    memset(buffer, 0x00, SSD1306_CANVAS_SIZE(width, height));
+}
+
+GDL_Errors_t SSD1306_canvasAddPanel (SSD1306_CanvasHandle_t canvas, SSD1306_DeviceHandle_t dev)
+{
+    ohiassert(dev != NULL);
+
+    if ((canvas->panelCount == SSD1306_CANVAS_PANEL_DIMENSION) ||
+        ((canvas->viewWidth + dev->gdl.width) > canvas->width))
+        return GDL_ERRORS_WRONG_POSITION;
+
+    canvas->panels[canvas->panelCount++] = dev;
+    canvas->viewWidth += dev->gdl.width;
+
+    if ((canvas->viewHeight == 0) || (dev->gdl.height < canvas->viewHeight))
+        canvas->viewHeight = dev->gdl.height;
+
+    canvas->isViewChanged = TRUE;
+    return GDL_ERRORS_SUCCESS;
+}
+
+void SSD1306_canvasDrawPixel (SSD1306_CanvasHandle_t canvas,
+                              uint16_t xPos,
+                              uint8_t yPos,
+                              SSD1306_Color_t color)
+{
+    SSD1306_canvasWriteColumn(canvas, xPos, yPos, (color == SSD1306_COLOR_BLACK) ? 0x00 : 0x01, 0x01);
+}
+
+SSD1306_Color_t SSD1306_canvasGetPixel (SSD1306_CanvasHandle_t canvas, uint16_t xPos, uint8_t yPos)
+{
+    if (yPos >= canvas->height)
+        return SSD1306_COLOR_BLACK;
+
+    return (readColumn(canvas, xPos % canvas->width, yPos) & 0x01) ? SSD1306_COLOR_COLOR : SSD1306_COLOR_BLACK;
+}
+
+void SSD1306_canvasWriteColumn (SSD1306_CanvasHandle_t canvas,
+                                uint16_t xPos,
+                                uint8_t yPos,
+                                uint8_t bits,
+                                uint8_t mask)
+{
+    if (yPos >= canvas->height)
+        return;
+
+    // Remove the rows out of the canvas
+    if ((canvas->height - yPos) < 8)
+        mask &= (uint8_t)((1u << (canvas->height - yPos)) - 1);
+    if (mask == 0)
+        return;
+
+    xPos %= canvas->width;
+
+    uint8_t shift = yPos % 8;
+    uint8_t* data = &canvas->buffer[(uint32_t)(yPos / 8) * canvas->width + xPos];
+    uint8_t m = (uint8_t)(mask << shift);
+
+    *data = (*data & ~m) | ((uint8_t)(bits << shift) & m);
+    if ((shift != 0) && ((uint8_t)(mask >> (8 - shift)) != 0))
+    {
+        data += canvas->width;
+        m     = mask >> (8 - shift);
+        *data = (*data & ~m) | ((bits >> (8 - shift)) & m);
+    }
+
+    setDirty(canvas, xPos);
+}
+
+void SSD1306_canvasFillRectangle (SSD1306_CanvasHandle_t canvas,
+                                  uint16_t xPos,
+                                  uint8_t yPos,
+                                  uint16_t width,
+                                  uint8_t height,
+                                  SSD1306_Color_t color)
+{
+    if (width > canvas->width) width = canvas->width;
+    if ((yPos >= canvas->height) || (width == 0) || (height == 0))
+        return;
+    if (height > (canvas->height - yPos)) height = canvas->height - yPos;
+
+    uint8_t bits = (color == SSD1306_COLOR_BLACK) ? 0x00 : 0xFF;
+
+    for (uint16_t row = 0; row < height; row += 8)
+    {
+        uint8_t rows = ((height - row) < 8) ? (uint8_t)((1u << (height - row)) - 1) : 0xFF;
+        for (uint16_t column = 0; column < width; ++column)
+        {
+            SSD1306_canvasWriteColumn(canvas, xPos + column, yPos + row, bits, rows);
+        }
+    }
+}
+
+void SSD1306_canvasPan (SSD1306_CanvasHandle_t canvas, uint16_t xPos, uint8_t yPos)
+{
+    xPos %= canvas->width;
+    if (yPos > (canvas->height - canvas->viewHeight))
+        yPos = (canvas->height > canvas->viewHeight) ? (canvas->height - canvas->viewHeight) : 0;
+
+    // A horizontal movement is managed by the update, from the columns
+    // shown by the panels
+    canvas->xView = xPos;
+    if (yPos != canvas->yView)
+    {
+        canvas->yView = yPos;
+        canvas->isViewChanged = TRUE;
+    }
+}
+
+bool SSD1306_canvasUpdate (SSD1306_CanvasHandle_t canvas)
+{
+    // The shortest movement from the columns shown by the panels
+    int32_t shift = ((int32_t)canvas->xView - canvas->xShown + canvas->width) % canvas->width;
+    if (shift > (canvas->width / 2))
+        shift -= canvas->width;
+    int32_t length = (shift > 0) ? shift : -shift;
+
+    if (!canvas->isViewChanged && (shift != 0))
+    {
+        if ((length < canvas->viewWidth) && isPanelClipFull(canvas))
+        {
+            movePanels(canvas, shift);
+
+            // The changed columns were moved with the others
+            int32_t start = (int32_t)canvas->dirtyStart - shift;
+            int32_t stop  = (int32_t)canvas->dirtyStop - shift;
+            if (start < 0) start = 0;
+            if (stop > canvas->viewWidth) stop = canvas->viewWidth;
+            if (start < stop)
+                copyColumns(canvas, start, stop);
+
+            if (shift > 0)
+                copyColumns(canvas, canvas->viewWidth - length, canvas->viewWidth);
+            else
+                copyColumns(canvas, 0, length);
+        }
+        else
+        {
+            canvas->isViewChanged = TRUE;
+        }
+    }
+    canvas->xShown = canvas->xView;
+
+    if (canvas->isViewChanged)
+    {
+        copyColumns(canvas, 0, canvas->viewWidth);
+    }
+    else if (shift == 0)
+    {
+        if (canvas->dirtyStart >= canvas->dirtyStop)
+            return FALSE;
+        copyColumns(canvas, canvas->dirtyStart, canvas->dirtyStop);
+    }
+
+    // After a movement all the panels are sent, the display RAM has no
+    // horizontal offset
+    if (canvas->isViewChanged || (shift != 0))
+        sendColumns(canvas, 0, canvas->viewWidth);
+    else
+        sendColumns(canvas, canvas->dirtyStart, canvas->dirtyStop);
+
+    canvas->isViewChanged = FALSE;
+    canvas->dirtyStart = 0;
+    canvas->dirtyStop  = 0;
+    return TRUE;
+}
@@ -0,0 +1,198 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef __WARCOMEB_SSD1306_CANVAS_H
+#define __WARCOMEB_SSD1306_CANVAS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ssd1306.h"
+
+/*!
+ * \defgroup SSD1306_Canvas
+ * \ingroup SSD1306
+ * \{
+ */
+
+#define SSD1306_CANVAS_PANEL_DIMENSION           4
+
+/*!
+ * The number of bytes of the buffer of a canvas of the selected dimensions.
+ */
+#define SSD1306_CANVAS_SIZE(width,height)        ((uint32_t)(width) * (((height) + 7) / 8))
+
+/*!
+ * SSD1306 virtual canvas class.
+ * The canvas is a page-major picture larger than a panel, stored into a user
+ * buffer. One or more panels, placed side by side, show a viewport of the
+ * canvas that can be moved in any position.
+ * The canvas is circular on the x axis: the columns after the last one are
+ * the first ones again. A long chart can scroll forever moving the viewport
+ * one column at time and drawing only the new column after its right edge.
+ *
+ * \note The SSD1306 has no horizontal offset of the display RAM, so every
+ *       horizontal movement of the viewport sends all the panels again, full
+ *       width. The buffers of the panels are moved instead, and only the
+ *       columns exposed by the movement are copied from the canvas.
+ */
+typedef struct _SSD1306_Canvas_t
+{
+    uint8_t* buffer;             /*!< Page-major pixels, width bytes for each page */
+    uint16_t width;
+    uint8_t height;
+
+    SSD1306_DeviceHandle_t panels [SSD1306_CANVAS_PANEL_DIMENSION];
+    uint8_t panelCount;
+    uint16_t viewWidth;          /*!< Sum of the panel widths */
+    uint8_t viewHeight;          /*!< Height of the lowest panel */
+
+    uint16_t xView;              /*!< First column of the viewport */
+    uint8_t yView;               /*!< First line of the viewport */
+    uint16_t xShown;             /*!< First column shown by the panels */
+    bool isViewChanged;          /*!< The whole viewport must be copied and sent */
+
+    uint16_t dirtyStart;         /*!< First changed column shown by the panels */
+    uint16_t dirtyStop;          /*!< First column after the changed ones */
+
+} SSD1306_Canvas_t, *SSD1306_CanvasHandle_t;
+
+/*!
+ * The function initialize the canvas and clears its buffer.
+ *
+ * \param[in] canvas: The handle of the canvas.
+ * \param[in] buffer: The buffer, of \ref SSD1306_CANVAS_SIZE bytes.
+ * \param[in]  width: The width of the canvas.
+ * \param[in] height: The height of the canvas.
+ */
+void SSD1306_canvasInit (SSD1306_CanvasHandle_t canvas,
+                         uint8_t* buffer,
+                         uint16_t width,
+                         uint8_t height);
+
+/*!
+ * The function adds a panel at the right of the viewport.
+ *
+ * \param[in] canvas: The handle of the canvas.
+ * \param[in]    dev: The handle of the device.
+ * \return GDL_ERRORS_WRONG_POSITION when there is no room for the panel.
+ */
+GDL_Errors_t SSD1306_canvasAddPanel (SSD1306_CanvasHandle_t canvas, SSD1306_DeviceHandle_t dev);
+
+/*!
+ * The function draws a single pixel into the canvas.
+ * \note To send the design to the panels, you must use \ref SSD1306_canvasUpdate
+ *
+ * \param[in] canvas: The handle of the canvas.
+ * \param[in]   xPos: The x position, it wraps around the canvas width.
+ * \param[in]   yPos: The y position
+ * \param[in]  color: The color of the pixel
+ */
+void SSD1306_canvasDrawPixel (SSD1306_CanvasHandle_t canvas,
+                              uint16_t xPos,
+                              uint8_t yPos,
+                              SSD1306_Color_t color);
+
+/*!
+ * The function returns the color of a pixel of the canvas.
+ *
+ * \param[in] canvas: The handle of the canvas.
+ * \param[in]   xPos: The x position, it wraps around the canvas width.
+ * \param[in]   yPos: The y position
+ */
+SSD1306_Color_t SSD1306_canvasGetPixel (SSD1306_CanvasHandle_t canvas, uint16_t xPos, uint8_t yPos);
+
+/*!
+ * The function writes 8 vertical pixels into the canvas, like
+ * \ref SSD1306_writeColumn does into the display buffer.
+ * \note To send the design to the panels, you must use \ref SSD1306_canvasUpdate
+ *
+ * \param[in] canvas: The handle of the canvas.
+ * \param[in]   xPos: The x position, it wraps around the canvas width.
+ * \param[in]   yPos: The y position of the first pixel
+ * \param[in]   bits: The 8 pixels, bit 0 on top
+ * \param[in]   mask: The pixels to be changed
+ */
+void SSD1306_canvasWriteColumn (SSD1306_CanvasHandle_t canvas,
+                                uint16_t xPos,
+                                uint8_t yPos,
+                                uint8_t bits,
+                                uint8_t mask);
+
+/*!
+ * The function fills a rectangle of the canvas.
+ * \note To send the design to the panels, you must use \ref SSD1306_canvasUpdate
+ *
+ * \param[in] canvas: The handle of the canvas.
+ * \param[in]   xPos: The x position, it wraps around the canvas width.
+ * \param[in]   yPos: The y position
+ * \param[in]  width: The width of the rectangle
+ * \param[in] height: The height of the rectangle
+ * \param[in]  color: The color of the rectangle
+ */
+void SSD1306_canvasFillRectangle (SSD1306_CanvasHandle_t canvas,
+                                  uint16_t xPos,
+                                  uint8_t yPos,
+                                  uint16_t width,
+                                  uint8_t height,
+                                  SSD1306_Color_t color);
+
+/*!
+ * The function moves the viewport.
+ * \note To send the design to the panels, you must use \ref SSD1306_canvasUpdate
+ *
+ * \param[in] canvas: The handle of the canvas.
+ * \param[in]   xPos: The first column of the viewport, it wraps around the
+ *                    canvas width.
+ * \param[in]   yPos: The first line of the viewport.
+ */
+void SSD1306_canvasPan (SSD1306_CanvasHandle_t canvas, uint16_t xPos, uint8_t yPos);
+
+/*!
+ * The function copies the changed columns of the viewport into the panels,
+ * and sends them with \ref SSD1306_flushArea. After a movement of the
+ * viewport, all the panels are sent.
+ * A horizontal movement shorter than the viewport moves the columns already
+ * into the panel buffers, and copies from the canvas only the exposed ones.
+ * This needs panels without clip area: otherwise, and after a vertical
+ * movement, the whole viewport is copied again.
+ *
+ * \param[in] canvas: The handle of the canvas.
+ * \return TRUE when something was sent.
+ */
+bool SSD1306_canvasUpdate (SSD1306_CanvasHandle_t canvas);
+
+/*!
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __WARCOMEB_SSD1306_CANVAS_H
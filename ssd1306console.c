@@ -0,0 +1,187 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+/*!
+ * \file  /ssd1306console.c
+ * \brief
+ */
+
+#include "ssd1306console.h"
+
+/*!
+ * The function moves the cursor to the beginning of the next line.
+ * When the cursor is on the last row, the whole console scrolls up by one row
+ * using the display start line, so only the new row is sent.
+ *
+ * \param[in] console: The handle of the console.
+ */
+static void newLine (SSD1306_ConsoleHandle_t console)
+{
+    console->cursorColumn = 0;
+
+    if ((console->cursorRow + 1) < console->rows)
+    {
+        console->cursorRow++;
+        return;
+    }
+
+    // The display content moves up, so both grids are moved up
+    SSD1306_scrollLines(console->dev, SSD1306_CONSOLE_CHAR_HEIGHT);
+    for (uint8_t row = 1; row < console->rows; ++row)
+    {
+        memcpy(console->text[row-1], console->text[row], console->columns);
+        memcpy(console->shown[row-1], console->shown[row], console->columns);
+    }
+    // The new row is cleared by the scroll function only into the buffer:
+    // the display RAM still holds old lines, so the whole row is marked as
+    // not shown and the next flush sends it
+    memset(console->text[console->rows-1], ' ', console->columns);
+    memset(console->shown[console->rows-1], '\0', console->columns);
+}
+
+void SSD1306_consoleInit (SSD1306_ConsoleHandle_t console,
+                          SSD1306_DeviceHandle_t dev,
+                          bool isWrap)
+{
+    ohiassert(console != NULL);
+    ohiassert(dev != NULL);
+
+    memset(console, 0, sizeof(SSD1306_Console_t));
+
+    console->dev     = dev;
+    console->isWrap  = isWrap;
+    console->columns = dev->gdl.width / SSD1306_CONSOLE_CHAR_WIDTH;
+    console->rows    = dev->gdl.height / SSD1306_CONSOLE_CHAR_HEIGHT;
+
+    SSD1306_consoleClear(console);
+}
+
+void SSD1306_consoleClear (SSD1306_ConsoleHandle_t console)
+{
+    memset(console->text, ' ', sizeof(console->text));
+    memset(console->shown, ' ', sizeof(console->shown));
+
+    console->cursorColumn = 0;
+    console->cursorRow    = 0;
+
+    SSD1306_clear(console->dev);
+}
+
+void SSD1306_consoleSetCursor (SSD1306_ConsoleHandle_t console,
+                               uint8_t column,
+                               uint8_t row)
+{
+    console->cursorColumn = (column < console->columns) ? column : (console->columns - 1);
+    console->cursorRow    = (row < console->rows) ? row : (console->rows - 1);
+}
+
+void SSD1306_consolePutChar (SSD1306_ConsoleHandle_t console, char c)
+{
+    switch (c)
+    {
+    case '\n':
+        newLine(console);
+        break;
+    case '\r':
+        console->cursorColumn = 0;
+        break;
+    case '\b':
+        if (console->cursorColumn > 0)
+        {
+            console->cursorColumn--;
+            console->text[console->cursorRow][console->cursorColumn] = ' ';
+        }
+        break;
+    default:
+        if (console->cursorColumn >= console->columns)
+        {
+            if (console->isWrap)
+            {
+                newLine(console);
+            }
+            else
+            {
+                // Discard the chars until the new line
+                return;
+            }
+        }
+        console->text[console->cursorRow][console->cursorColumn] = c;
+        console->cursorColumn++;
+        break;
+    }
+}
+
+void SSD1306_consolePrint (SSD1306_ConsoleHandle_t console, const char* text)
+{
+    while (*text != '\0')
+    {
+        SSD1306_consolePutChar(console, *text++);
+    }
+}
+
+void SSD1306_consoleFlush (SSD1306_ConsoleHandle_t console)
+{
+    for (uint8_t row = 0; row < console->rows; ++row)
+    {
+        uint8_t column = 0;
+        uint16_t yPos = (uint16_t)row * SSD1306_CONSOLE_CHAR_HEIGHT;
+
+        while (column < console->columns)
+        {
+            if (console->text[row][column] == console->shown[row][column])
+            {
+                column++;
+                continue;
+            }
+
+            // Draw the run of changed chars, and send them together
+            uint8_t start = column;
+            while ((column < console->columns) &&
+                   (console->text[row][column] != console->shown[row][column]))
+            {
+                SSD1306_drawChar(console->dev,
+                                 (uint16_t)column * SSD1306_CONSOLE_CHAR_WIDTH,
+                                 yPos,
+                                 console->text[row][column],
+                                 SSD1306_COLOR_COLOR,
+                                 1);
+                console->shown[row][column] = console->text[row][column];
+                column++;
+            }
+            // A run up to the last column is sent up to the display edge,
+            // so the new row after a scroll is sent whole
+            uint16_t xStart = (uint16_t)start * SSD1306_CONSOLE_CHAR_WIDTH;
+            uint16_t xStop  = (column == console->columns) ?
+                              console->dev->gdl.width :
+                              (uint16_t)column * SSD1306_CONSOLE_CHAR_WIDTH;
+            SSD1306_flushArea(console->dev, xStart, yPos, xStop - xStart, SSD1306_CONSOLE_CHAR_HEIGHT);
+        }
+    }
+
+    // Send a pending scroll also when there are no changed chars
+    SSD1306_flushStartLine(console->dev);
+}
@@ -0,0 +1,143 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef __WARCOMEB_SSD1306_CONSOLE_H
+#define __WARCOMEB_SSD1306_CONSOLE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ssd1306.h"
+
+/*!
+ * \defgroup SSD1306_Console
+ * \ingroup SSD1306
+ * \{
+ */
+
+#define SSD1306_CONSOLE_CHAR_WIDTH               GDL_DEFAULT_FONT_WIDTH
+#define SSD1306_CONSOLE_CHAR_HEIGHT              8
+#define SSD1306_CONSOLE_MAX_COLUMNS              (SSD1306_MAX_DISPLAY_WIDTH/SSD1306_CONSOLE_CHAR_WIDTH)
+#define SSD1306_CONSOLE_MAX_ROWS                 (SSD1306_MAX_DISPLAY_HEIGHT/SSD1306_CONSOLE_CHAR_HEIGHT)
+
+/*!
+ * SSD1306 text console class.
+ * The console keeps a grid of characters that covers the whole display, and
+ * sends to the display only the characters changed from the previous flush.
+ */
+typedef struct _SSD1306_Console_t
+{
+    SSD1306_DeviceHandle_t dev;
+
+    uint8_t columns;
+    uint8_t rows;
+
+    uint8_t cursorColumn;
+    uint8_t cursorRow;
+
+    bool isWrap;                 /*!< Long lines continue on the next line */
+
+    /*! Characters to be shown */
+    char text [SSD1306_CONSOLE_MAX_ROWS][SSD1306_CONSOLE_MAX_COLUMNS];
+    /*! Characters drawn into the device buffer */
+    char shown [SSD1306_CONSOLE_MAX_ROWS][SSD1306_CONSOLE_MAX_COLUMNS];
+
+} SSD1306_Console_t, *SSD1306_ConsoleHandle_t;
+
+/*!
+ * The function initialize the console and clear the display.
+ * The device must be already initialized.
+ *
+ * \param[in] console: The handle of the console.
+ * \param[in]     dev: The handle of the device.
+ * \param[in]  isWrap: If TRUE the long lines continue on the next line,
+ *                     otherwise the exceeding characters are discarded.
+ */
+void SSD1306_consoleInit (SSD1306_ConsoleHandle_t console,
+                          SSD1306_DeviceHandle_t dev,
+                          bool isWrap);
+
+/*!
+ * The function clears the console content and the display, and moves the
+ * cursor to the top-left corner.
+ *
+ * \param[in] console: The handle of the console.
+ */
+void SSD1306_consoleClear (SSD1306_ConsoleHandle_t console);
+
+/*!
+ * The function moves the cursor to the selected position.
+ * The position is limited to the console dimension.
+ *
+ * \param[in] console: The handle of the console.
+ * \param[in]  column: The column of the cursor.
+ * \param[in]     row: The row of the cursor.
+ */
+void SSD1306_consoleSetCursor (SSD1306_ConsoleHandle_t console,
+                               uint8_t column,
+                               uint8_t row);
+
+/*!
+ * The function writes a char at the cursor position and moves the cursor.
+ * The special chars '\\n' (new line), '\\r' (carriage return) and '\\b'
+ * (backspace) are managed. When the cursor goes over the last row, the
+ * console scrolls up by one row.
+ * \note To send the changes to the display, you must use \ref SSD1306_consoleFlush
+ *
+ * \param[in] console: The handle of the console.
+ * \param[in]       c: The char to write.
+ */
+void SSD1306_consolePutChar (SSD1306_ConsoleHandle_t console, char c);
+
+/*!
+ * The function writes a string starting from the cursor position.
+ * \note To send the changes to the display, you must use \ref SSD1306_consoleFlush
+ *
+ * \param[in] console: The handle of the console.
+ * \param[in]    text: The string to write.
+ */
+void SSD1306_consolePrint (SSD1306_ConsoleHandle_t console, const char* text);
+
+/*!
+ * The function draws and sends to the display only the characters changed
+ * from the previous flush. The adjacent changed characters of the same row are
+ * sent together.
+ *
+ * \param[in] console: The handle of the console.
+ */
+void SSD1306_consoleFlush (SSD1306_ConsoleHandle_t console);
+
+/*!
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __WARCOMEB_SSD1306_CONSOLE_H
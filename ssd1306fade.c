@@ -0,0 +1,189 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+/*!
+ * \file  /ssd1306fade.c
+ * \brief
+ */
+
+#include "ssd1306fade.h"
+
+/*!
+ * The function computes the linear interpolation between two contrast values.
+ *
+ * \param[in]     from: The starting contrast.
+ * \param[in]       to: The ending contrast.
+ * \param[in]  elapsed: The elapsed time.
+ * \param[in] duration: The total time.
+ * \return The contrast value.
+ */
+static uint8_t interpolate (uint8_t from, uint8_t to, uint32_t elapsed, uint32_t duration)
+{
+    if ((duration == 0) || (elapsed >= duration)) return to;
+
+    int32_t delta = (int32_t)to - (int32_t)from;
+    return (uint8_t)((int32_t)from + (int32_t)((delta * (int64_t)elapsed) / (int64_t)duration));
+}
+
+void SSD1306_fadeInit (SSD1306_FadeHandle_t fade,
+                       SSD1306_DeviceHandle_t dev,
+                       uint32_t stepTime)
+{
+    ohiassert(fade != NULL);
+    ohiassert(dev != NULL);
+
+    memset(fade, 0, sizeof(SSD1306_Fade_t));
+
+    fade->dev            = dev;
+    fade->mode           = SSD1306_FADEMODE_NONE;
+    fade->stepTime       = stepTime;
+    fade->activeContrast = dev->contrast;
+    fade->lastActivity   = System_currentTick();
+}
+
+void SSD1306_fadeTo (SSD1306_FadeHandle_t fade, uint8_t contrast, uint32_t duration)
+{
+    fade->mode       = SSD1306_FADEMODE_FADE;
+    fade->from       = fade->dev->contrast;
+    fade->to         = contrast;
+    fade->duration   = duration;
+    fade->startTime  = System_currentTick();
+    fade->isOffAtEnd = FALSE;
+}
+
+void SSD1306_fadeIn (SSD1306_FadeHandle_t fade, uint32_t duration)
+{
+    SSD1306_setContrast(fade->dev, 0);
+    // The display can be suspended, with the charge pump stopped
+    SSD1306_resume(fade->dev);
+    SSD1306_fadeTo(fade, fade->activeContrast, duration);
+    fade->isDimmed     = FALSE;
+    fade->lastActivity = fade->startTime;
+}
+
+void SSD1306_fadeOut (SSD1306_FadeHandle_t fade, uint32_t duration)
+{
+    SSD1306_fadeTo(fade, 0, duration);
+    fade->isOffAtEnd = TRUE;
+}
+
+void SSD1306_fadePulse (SSD1306_FadeHandle_t fade,
+                        uint8_t low,
+                        uint8_t high,
+                        uint32_t period)
+{
+    fade->mode       = SSD1306_FADEMODE_PULSE;
+    fade->from       = low;
+    fade->to         = high;
+    fade->duration   = period;
+    fade->startTime  = System_currentTick();
+    fade->isOffAtEnd = FALSE;
+}
+
+void SSD1306_fadeStop (SSD1306_FadeHandle_t fade)
+{
+    fade->mode = SSD1306_FADEMODE_NONE;
+}
+
+void SSD1306_fadeSetIdle (SSD1306_FadeHandle_t fade,
+                          uint32_t timeout,
+                          uint8_t contrast,
+                          uint32_t duration)
+{
+    fade->idleTimeout  = timeout;
+    fade->idleContrast = contrast;
+    fade->idleDuration = duration;
+    fade->lastActivity = System_currentTick();
+}
+
+void SSD1306_fadeActivity (SSD1306_FadeHandle_t fade)
+{
+    fade->lastActivity = System_currentTick();
+
+    if (fade->isDimmed)
+    {
+        fade->isDimmed = FALSE;
+        SSD1306_fadeTo(fade, fade->activeContrast, fade->idleDuration);
+    }
+}
+
+bool SSD1306_fadeProcess (SSD1306_FadeHandle_t fade)
+{
+    uint32_t now = System_currentTick();
+    uint8_t contrast;
+
+    // Start the dimming when the idle timeout is elapsed
+    if ((fade->idleTimeout > 0) && !fade->isDimmed && (fade->mode == SSD1306_FADEMODE_NONE) &&
+        ((now - fade->lastActivity) >= fade->idleTimeout))
+    {
+        fade->isDimmed = TRUE;
+        SSD1306_fadeTo(fade, fade->idleContrast, fade->idleDuration);
+    }
+
+    uint32_t elapsed = now - fade->startTime;
+
+    switch (fade->mode)
+    {
+    case SSD1306_FADEMODE_FADE:
+        contrast = interpolate(fade->from, fade->to, elapsed, fade->duration);
+        // The last step is always sent, without wait the step time
+        if (contrast == fade->to)
+        {
+            if (contrast != fade->dev->contrast)
+            {
+                SSD1306_setContrast(fade->dev, contrast);
+            }
+            if (fade->isOffAtEnd)
+            {
+                SSD1306_off(fade->dev);
+            }
+            fade->mode = SSD1306_FADEMODE_NONE;
+            return FALSE;
+        }
+        break;
+    case SSD1306_FADEMODE_PULSE:
+        {
+            // Triangle wave: half period up, half period down
+            uint32_t half  = fade->duration / 2;
+            uint32_t phase = (fade->duration > 0) ? (elapsed % fade->duration) : 0;
+            if (phase < half)
+                contrast = interpolate(fade->from, fade->to, phase, half);
+            else
+                contrast = interpolate(fade->to, fade->from, phase - half, fade->duration - half);
+        }
+        break;
+    default:
+        return FALSE;
+    }
+
+    if ((contrast != fade->dev->contrast) && ((now - fade->lastStep) >= fade->stepTime))
+    {
+        SSD1306_setContrast(fade->dev, contrast);
+        fade->lastStep = now;
+    }
+    return TRUE;
+}
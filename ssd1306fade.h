@@ -0,0 +1,180 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef __WARCOMEB_SSD1306_FADE_H
+#define __WARCOMEB_SSD1306_FADE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ssd1306.h"
+
+/*!
+ * \defgroup SSD1306_Fade
+ * \ingroup SSD1306
+ * \{
+ */
+
+/*!
+ * List of possible fade modes
+ */
+typedef enum _SSD1306_FadeMode_t
+{
+    SSD1306_FADEMODE_NONE,
+    SSD1306_FADEMODE_FADE,
+    SSD1306_FADEMODE_PULSE,
+} SSD1306_FadeMode_t;
+
+/*!
+ * SSD1306 fade engine class.
+ * The engine changes only the contrast of the display: the buffer is never
+ * modified and no flush is done, so every step costs one contrast command.
+ */
+typedef struct _SSD1306_Fade_t
+{
+    SSD1306_DeviceHandle_t dev;
+
+    SSD1306_FadeMode_t mode;
+
+    uint8_t from;                /*!< Contrast at the start of the fade */
+    uint8_t to;                  /*!< Contrast at the end of the fade */
+    uint32_t startTime;          /*!< Tick of the start of the fade */
+    uint32_t duration;           /*!< Fade duration, or pulse period, in ms */
+    uint32_t stepTime;           /*!< Minimum time between two steps in ms */
+    uint32_t lastStep;           /*!< Tick of the last contrast command */
+    bool isOffAtEnd;             /*!< Turn off the display at the end of the fade */
+
+    uint8_t activeContrast;      /*!< Contrast used during the activity */
+    uint8_t idleContrast;        /*!< Contrast used after the idle timeout */
+    uint32_t idleTimeout;        /*!< Idle timeout in ms, 0 to disable dimming */
+    uint32_t idleDuration;       /*!< Dimming fade duration in ms */
+    uint32_t lastActivity;       /*!< Tick of the last activity */
+    bool isDimmed;
+
+} SSD1306_Fade_t, *SSD1306_FadeHandle_t;
+
+/*!
+ * The function initialize the fade engine.
+ * The current contrast of the device is used as contrast for the activity.
+ *
+ * \param[in]     fade: The handle of the fade engine.
+ * \param[in]      dev: The handle of the device.
+ * \param[in] stepTime: The minimum time between two contrast commands in ms.
+ */
+void SSD1306_fadeInit (SSD1306_FadeHandle_t fade,
+                       SSD1306_DeviceHandle_t dev,
+                       uint32_t stepTime);
+
+/*!
+ * The function starts a fade from the current contrast to the selected one.
+ *
+ * \param[in]     fade: The handle of the fade engine.
+ * \param[in] contrast: The contrast at the end of the fade.
+ * \param[in] duration: The fade duration in ms.
+ */
+void SSD1306_fadeTo (SSD1306_FadeHandle_t fade, uint8_t contrast, uint32_t duration);
+
+/*!
+ * The function turns on the display with the minimum contrast, and starts a
+ * fade to the activity contrast. The display is waked up with
+ * \ref SSD1306_resume, so it can be also suspended.
+ *
+ * \param[in]     fade: The handle of the fade engine.
+ * \param[in] duration: The fade duration in ms.
+ */
+void SSD1306_fadeIn (SSD1306_FadeHandle_t fade, uint32_t duration);
+
+/*!
+ * The function starts a fade to the minimum contrast, and turns off the
+ * display at the end of the fade.
+ *
+ * \param[in]     fade: The handle of the fade engine.
+ * \param[in] duration: The fade duration in ms.
+ */
+void SSD1306_fadeOut (SSD1306_FadeHandle_t fade, uint32_t duration);
+
+/*!
+ * The function starts a continuous pulse between two contrast values.
+ * The pulse is stopped by \ref SSD1306_fadeStop or by a new fade.
+ *
+ * \param[in]   fade: The handle of the fade engine.
+ * \param[in]    low: The minimum contrast.
+ * \param[in]   high: The maximum contrast.
+ * \param[in] period: The pulse period in ms.
+ */
+void SSD1306_fadePulse (SSD1306_FadeHandle_t fade,
+                        uint8_t low,
+                        uint8_t high,
+                        uint32_t period);
+
+/*!
+ * The function stops the current fade or pulse, leaving the current contrast.
+ *
+ * \param[in] fade: The handle of the fade engine.
+ */
+void SSD1306_fadeStop (SSD1306_FadeHandle_t fade);
+
+/*!
+ * The function configures the dimming after idle.
+ *
+ * \param[in]     fade: The handle of the fade engine.
+ * \param[in]  timeout: The idle time before dimming in ms, 0 to disable dimming.
+ * \param[in] contrast: The contrast used after the idle timeout.
+ * \param[in] duration: The dimming fade duration in ms.
+ */
+void SSD1306_fadeSetIdle (SSD1306_FadeHandle_t fade,
+                          uint32_t timeout,
+                          uint8_t contrast,
+                          uint32_t duration);
+
+/*!
+ * The function notifies an activity: it restarts the idle timeout and, when
+ * the display is dimmed, it starts a fade to the activity contrast.
+ *
+ * \param[in] fade: The handle of the fade engine.
+ */
+void SSD1306_fadeActivity (SSD1306_FadeHandle_t fade);
+
+/*!
+ * The function computes the contrast for the current time and sends it when
+ * it is changed. It must be called periodically, for example into the main loop.
+ *
+ * \param[in] fade: The handle of the fade engine.
+ * \return TRUE while a fade or a pulse is running, FALSE otherwise.
+ */
+bool SSD1306_fadeProcess (SSD1306_FadeHandle_t fade);
+
+/*!
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __WARCOMEB_SSD1306_FADE_H
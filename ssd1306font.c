@@ -0,0 +1,266 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+/*!
+ * \file  /ssd1306font.c
+ * \brief
+ */
+
+#include "ssd1306font.h"
+
+#define SSD1306_FONT_INVALID_CODE              0xFFFD
+
+/*!
+ * The function decodes a code point from a UTF-8 string, and moves the
+ * string after it. The wrong sequences are decoded as the replacement char.
+ *
+ * \param[in,out] text: The string.
+ * \return The code point.
+ */
+static uint32_t decodeUtf8 (const char** text)
+{
+    const uint8_t* s = (const uint8_t*)*text;
+    uint32_t code;
+    uint8_t length;
+
+    if (s[0] < 0x80)
+    {
+        *text += 1;
+        return s[0];
+    }
+    else if ((s[0] & 0xE0) == 0xC0)
+    {
+        code   = s[0] & 0x1F;
+        length = 2;
+    }
+    else if ((s[0] & 0xF0) == 0xE0)
+    {
+        code   = s[0] & 0x0F;
+        length = 3;
+    }
+    else if ((s[0] & 0xF8) == 0xF0)
+    {
+        code   = s[0] & 0x07;
+        length = 4;
+    }
+    else
+    {
+        *text += 1;
+        return SSD1306_FONT_INVALID_CODE;
+    }
+
+    for (uint8_t i = 1; i < length; ++i)
+    {
+        // Stop on a truncated sequence, without skip the next char
+        if ((s[i] & 0xC0) != 0x80)
+        {
+            *text += i;
+            return SSD1306_FONT_INVALID_CODE;
+        }
+        code = (code << 6) | (s[i] & 0x3F);
+    }
+    *text += length;
+    return code;
+}
+
+const SSD1306_FontGlyph_t* SSD1306_getGlyph (const SSD1306_Font_t* font, uint32_t code)
+{
+    // Direct index for the contiguous range
+    if ((code >= font->firstCode) && (code < ((uint32_t)font->firstCode + font->directCount)))
+    {
+        return &font->glyphs[code - font->firstCode];
+    }
+
+    // Binary search for the sparse codes
+    uint16_t low  = font->directCount;
+    uint16_t high = font->glyphCount;
+    while (low < high)
+    {
+        uint16_t middle = low + (high - low) / 2;
+        if (font->glyphs[middle].code < code)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    if ((low < font->glyphCount) && (font->glyphs[low].code == code))
+    {
+        return &font->glyphs[low];
+    }
+
+    return &font->glyphs[font->fallback];
+}
+
+uint16_t SSD1306_measureString (const SSD1306_Font_t* font, const char* text)
+{
+    uint16_t width = 0;
+
+    while ((*text != '\0') && (*text != '\n'))
+    {
+        width += SSD1306_getGlyph(font, decodeUtf8(&text))->advance;
+    }
+    return width;
+}
+
+uint16_t SSD1306_fitString (const SSD1306_Font_t* font,
+                            const char* text,
+                            uint16_t maxWidth,
+                            uint16_t* width)
+{
+    const char* start = text;
+    uint16_t current = 0;
+    uint16_t length = 0;          // Fitting bytes
+    uint16_t lengthWidth = 0;     // Width of the fitting bytes
+    bool isWord = FALSE;
+
+    while ((*text != '\0') && (*text != '\n'))
+    {
+        const char* position = text;
+        uint32_t code = decodeUtf8(&text);
+        uint16_t advance = SSD1306_getGlyph(font, code)->advance;
+
+        if (code == ' ')
+        {
+            // End of a word: all the text up to here fits
+            if (isWord)
+            {
+                length = position - start;
+                lengthWidth = current;
+                isWord = FALSE;
+            }
+        }
+        else
+        {
+            if ((current + advance) > maxWidth)
+            {
+                // A single word longer than the line is broken
+                if (length == 0)
+                {
+                    length = position - start;
+                    lengthWidth = current;
+                }
+                if (width != NULL) *width = lengthWidth;
+                return length;
+            }
+            isWord = TRUE;
+        }
+        current += advance;
+    }
+
+    if (isWord)
+    {
+        length = text - start;
+        lengthWidth = current;
+    }
+    if (width != NULL) *width = lengthWidth;
+    return length;
+}
+
+uint16_t SSD1306_drawText (SSD1306_DeviceHandle_t dev,
+                           const SSD1306_Font_t* font,
+                           int16_t xPos,
+                           uint8_t yPos,
+                           const char* text,
+                           uint16_t length,
+                           SSD1306_Color_t color)
+{
+    const char* end = text + length;
+    uint8_t pages = (font->height + 7) / 8;
+    int16_t x = xPos;
+
+    while ((text < end) && (*text != '\0') && (*text != '\n'))
+    {
+        const SSD1306_FontGlyph_t* glyph = SSD1306_getGlyph(font, decodeUtf8(&text));
+
+        // Only the glyphs into the clip area are drawn
+        if (((x + glyph->advance) > dev->clip.xStart) && (x < dev->clip.xStop))
+        {
+            const uint8_t* bitmap = &font->bitmaps[glyph->offset];
+
+            for (uint8_t column = 0; column < glyph->advance; ++column)
+            {
+                int16_t xColumn = x + column;
+                if ((xColumn < dev->clip.xStart) || (xColumn >= dev->clip.xStop))
+                    continue;
+
+                for (uint8_t page = 0; page < pages; ++page)
+                {
+                    uint8_t lines = font->height - page * 8;
+                    uint8_t mask  = (lines < 8) ? (uint8_t)((1u << lines) - 1) : 0xFF;
+                    uint8_t bits  = (column < glyph->width) ? bitmap[page * glyph->width + column] : 0;
+
+                    SSD1306_writeColumn(dev,
+                                        (uint8_t)xColumn,
+                                        yPos + page * 8,
+                                        (color == SSD1306_COLOR_COLOR) ? bits : (uint8_t)~bits,
+                                        mask);
+                }
+            }
+        }
+        x += glyph->advance;
+    }
+    return (uint16_t)(x - xPos);
+}
+
+uint16_t SSD1306_drawTextBox (SSD1306_DeviceHandle_t dev,
+                              const SSD1306_Font_t* font,
+                              uint8_t xPos,
+                              uint8_t yPos,
+                              uint8_t width,
+                              uint8_t height,
+                              const char* text,
+                              SSD1306_Color_t color)
+{
+    const char* start = text;
+    uint16_t y = yPos;
+
+    SSD1306_pushClip(dev, xPos, yPos, width, height);
+
+    while ((*text != '\0') && ((y + font->height) <= ((uint16_t)yPos + height)))
+    {
+        uint16_t length = SSD1306_fitString(font, text, width, NULL);
+
+        SSD1306_drawText(dev, font, xPos, y, text, length, color);
+        text += length;
+
+        // Skip the spaces of the line break, and a new line
+        while (*text == ' ') text++;
+        if (*text == '\n')
+        {
+            text++;
+        }
+        else if ((length == 0) && (*text != '\0'))
+        {
+            // A glyph wider than the box must not stop the layout
+            decodeUtf8(&text);
+        }
+
+        y += font->lineHeight;
+    }
+
+    SSD1306_popClip(dev);
+    return (uint16_t)(text - start);
+}
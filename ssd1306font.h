@@ -0,0 +1,173 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef __WARCOMEB_SSD1306_FONT_H
+#define __WARCOMEB_SSD1306_FONT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ssd1306.h"
+
+/*!
+ * \defgroup SSD1306_Font
+ * \ingroup SSD1306
+ * \{
+ */
+
+/*!
+ * Metrics of a single glyph of a proportional font.
+ */
+typedef struct _SSD1306_FontGlyph_t
+{
+    uint16_t code;               /*!< Unicode code point of the glyph */
+    uint16_t offset;             /*!< Position of the bitmap into the font bitmaps */
+    uint8_t width;               /*!< Columns of the bitmap */
+    uint8_t advance;             /*!< Horizontal distance to the next glyph */
+} SSD1306_FontGlyph_t;
+
+/*!
+ * Proportional font.
+ *
+ * The glyphs with code from firstCode to firstCode+directCount-1 are stored
+ * in order at the beginning of the glyphs array, and they are found with a
+ * direct index. The other glyphs follow, sorted by code, and they are found
+ * with a binary search.
+ *
+ * The bitmap of every glyph is page-major, like the display buffer: one byte
+ * for each column of the first 8 lines, then one byte for each column of the
+ * next 8 lines, and so on. The bit 0 is the top line.
+ */
+typedef struct _SSD1306_Font_t
+{
+    uint8_t height;              /*!< Lines of every glyph */
+    uint8_t lineHeight;          /*!< Vertical distance between two lines of text */
+
+    uint16_t firstCode;          /*!< Code of the first glyph with direct index */
+    uint16_t directCount;        /*!< Number of glyphs with direct index */
+    uint16_t glyphCount;         /*!< Total number of glyphs */
+    uint16_t fallback;           /*!< Glyph used for missing codes */
+
+    const SSD1306_FontGlyph_t* glyphs;
+    const uint8_t* bitmaps;
+
+} SSD1306_Font_t;
+
+/*!
+ * The function searches the glyph of a code point.
+ *
+ * \param[in] font: The font.
+ * \param[in] code: The Unicode code point.
+ * \return The glyph of the code, or the fallback glyph when it is missing.
+ */
+const SSD1306_FontGlyph_t* SSD1306_getGlyph (const SSD1306_Font_t* font, uint32_t code);
+
+/*!
+ * The function computes the width of a UTF-8 string, without drawing it.
+ * The string ends with '\\0' or '\\n'.
+ *
+ * \param[in] font: The font.
+ * \param[in] text: The string.
+ * \return The width in pixels.
+ */
+uint16_t SSD1306_measureString (const SSD1306_Font_t* font, const char* text);
+
+/*!
+ * The function computes how much of a UTF-8 string fits into a line with the
+ * selected width, breaking the line after a word. When the first word is too
+ * long, it is broken after the last glyph that fits.
+ * The line ends also with '\\0' or '\\n'.
+ *
+ * \param[in]     font: The font.
+ * \param[in]     text: The string.
+ * \param[in] maxWidth: The width of the line in pixels.
+ * \param[out]   width: The width of the fitting part, it can be NULL.
+ * \return The number of bytes of the fitting part, without the trailing spaces.
+ */
+uint16_t SSD1306_fitString (const SSD1306_Font_t* font,
+                            const char* text,
+                            uint16_t maxWidth,
+                            uint16_t* width);
+
+/*!
+ * The function draws a line of UTF-8 text with a proportional font.
+ * The glyphs are drawn with their background, for the whole advance, so a
+ * text can be drawn over the previous one.
+ * The text ends with '\\0' or '\\n', or after the selected number of bytes.
+ * \note To send the design to the display, you must use \ref SSD1306_flush
+ *
+ * \param[in]    dev: The handle of the device
+ * \param[in]   font: The font
+ * \param[in]   xPos: The x position, it can be out of the display
+ * \param[in]   yPos: The y position of the top line
+ * \param[in]   text: The string to be draw
+ * \param[in] length: The maximum number of bytes to draw
+ * \param[in]  color: The foreground color of the text
+ * \return The width of the text in pixels.
+ */
+uint16_t SSD1306_drawText (SSD1306_DeviceHandle_t dev,
+                           const SSD1306_Font_t* font,
+                           int16_t xPos,
+                           uint8_t yPos,
+                           const char* text,
+                           uint16_t length,
+                           SSD1306_Color_t color);
+
+/*!
+ * The function draws UTF-8 text into a box, with word wrap and new lines.
+ * Every line is measured once and drawn once.
+ * \note To send the design to the display, you must use \ref SSD1306_flush
+ *
+ * \param[in]    dev: The handle of the device
+ * \param[in]   font: The font
+ * \param[in]   xPos: The x position of the box
+ * \param[in]   yPos: The y position of the box
+ * \param[in]  width: The width of the box
+ * \param[in] height: The height of the box
+ * \param[in]   text: The string to be draw
+ * \param[in]  color: The foreground color of the text
+ * \return The number of bytes of the text drawn into the box.
+ */
+uint16_t SSD1306_drawTextBox (SSD1306_DeviceHandle_t dev,
+                              const SSD1306_Font_t* font,
+                              uint8_t xPos,
+                              uint8_t yPos,
+                              uint8_t width,
+                              uint8_t height,
+                              const char* text,
+                              SSD1306_Color_t color);
+
+/*!
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __WARCOMEB_SSD1306_FONT_H
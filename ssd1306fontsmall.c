@@ -0,0 +1,259 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+/*!
+ * \file  /ssd1306fontsmall.c
+ * \brief
+ */
+
+#include "ssd1306fontsmall.h"
+
+/*!
+ * Bitmaps of the glyphs, one page for each column.
+ */
+static const uint8_t mFontSmallBitmaps[] =
+{
+    0x2F, // '!'
+    0x03, 0x00, 0x03, // '"'
+    0x0A, 0x1F, 0x0A, 0x1F, 0x0A, // '#'
+    0x24, 0x2A, 0x7F, 0x2A, 0x12, // '$'
+    0x13, 0x0B, 0x04, 0x1A, 0x19, // '%'
+    0x1A, 0x25, 0x2A, 0x10, 0x28, // '&'
+    0x03, // '\''
+    0x1E, 0x21, // '('
+    0x21, 0x1E, // ')'
+    0x0A, 0x04, 0x0A, // '*'
+    0x08, 0x1C, 0x08, // '+'
+    0x40, 0x20, // ','
+    0x08, 0x08, 0x08, // '-'
+    0x20, // '.'
+    0x30, 0x0C, 0x03, // '/'
+    0x1E, 0x29, 0x25, 0x1E, // '0'
+    0x22, 0x3F, 0x20, // '1'
+    0x32, 0x29, 0x25, 0x22, // '2'
+    0x21, 0x25, 0x25, 0x1A, // '3'
+    0x07, 0x04, 0x04, 0x3F, // '4'
+    0x27, 0x25, 0x25, 0x19, // '5'
+    0x1E, 0x25, 0x25, 0x18, // '6'
+    0x01, 0x39, 0x05, 0x03, // '7'
+    0x1A, 0x25, 0x25, 0x1A, // '8'
+    0x06, 0x29, 0x29, 0x1E, // '9'
+    0x12, // ':'
+    0x20, 0x12, // ';'
+    0x04, 0x0A, 0x11, // '<'
+    0x14, 0x14, 0x14, // '='
+    0x11, 0x0A, 0x04, // '>'
+    0x02, 0x29, 0x05, 0x02, // '?'
+    0x1E, 0x21, 0x3D, 0x35, 0x0E, // '@'
+    0x3E, 0x09, 0x09, 0x3E, // 'A'
+    0x3F, 0x25, 0x25, 0x1A, // 'B'
+    0x1E, 0x21, 0x21, 0x21, // 'C'
+    0x3F, 0x21, 0x21, 0x1E, // 'D'
+    0x3F, 0x25, 0x25, 0x21, // 'E'
+    0x3F, 0x05, 0x05, 0x01, // 'F'
+    0x1E, 0x21, 0x25, 0x3D, // 'G'
+    0x3F, 0x04, 0x04, 0x3F, // 'H'
+    0x21, 0x3F, 0x21, // 'I'
+    0x10, 0x20, 0x21, 0x1F, // 'J'
+    0x3F, 0x04, 0x0A, 0x31, // 'K'
+    0x3F, 0x20, 0x20, 0x20, // 'L'
+    0x3F, 0x02, 0x04, 0x02, 0x3F, // 'M'
+    0x3F, 0x02, 0x04, 0x3F, // 'N'
+    0x1E, 0x21, 0x21, 0x1E, // 'O'
+    0x3F, 0x09, 0x09, 0x06, // 'P'
+    0x1E, 0x21, 0x11, 0x2E, // 'Q'
+    0x3F, 0x09, 0x19, 0x26, // 'R'
+    0x22, 0x25, 0x25, 0x19, // 'S'
+    0x01, 0x01, 0x3F, 0x01, 0x01, // 'T'
+    0x1F, 0x20, 0x20, 0x1F, // 'U'
+    0x07, 0x18, 0x20, 0x18, 0x07, // 'V'
+    0x3F, 0x10, 0x0C, 0x10, 0x3F, // 'W'
+    0x33, 0x0C, 0x0C, 0x33, // 'X'
+    0x01, 0x02, 0x3C, 0x02, 0x01, // 'Y'
+    0x31, 0x29, 0x25, 0x23, // 'Z'
+    0x3F, 0x21, // '['
+    0x03, 0x0C, 0x30, // '\\'
+    0x21, 0x3F, // ']'
+    0x02, 0x01, 0x02, // '^'
+    0x40, 0x40, 0x40, 0x40, // '_'
+    0x01, 0x02, // '`'
+    0x18, 0x24, 0x24, 0x3C, // 'a'
+    0x3F, 0x24, 0x24, 0x18, // 'b'
+    0x18, 0x24, 0x24, // 'c'
+    0x18, 0x24, 0x24, 0x3F, // 'd'
+    0x18, 0x2C, 0x2C, 0x28, // 'e'
+    0x3E, 0x05, 0x05, // 'f'
+    0x18, 0xA4, 0xA4, 0x7C, // 'g'
+    0x3F, 0x04, 0x04, 0x38, // 'h'
+    0x3D, // 'i'
+    0x80, 0x7D, // 'j'
+    0x3F, 0x08, 0x34, // 'k'
+    0x3F, // 'l'
+    0x3C, 0x04, 0x3C, 0x04, 0x38, // 'm'
+    0x3C, 0x04, 0x04, 0x38, // 'n'
+    0x18, 0x24, 0x24, 0x18, // 'o'
+    0xFC, 0x24, 0x24, 0x18, // 'p'
+    0x18, 0x24, 0x24, 0xFC, // 'q'
+    0x3C, 0x08, 0x04, // 'r'
+    0x28, 0x2C, 0x14, // 's'
+    0x04, 0x1F, 0x24, // 't'
+    0x1C, 0x20, 0x20, 0x3C, // 'u'
+    0x1C, 0x20, 0x1C, // 'v'
+    0x1C, 0x20, 0x18, 0x20, 0x1C, // 'w'
+    0x24, 0x18, 0x24, // 'x'
+    0x1C, 0xA0, 0xA0, 0x7C, // 'y'
+    0x24, 0x34, 0x2C, 0x24, // 'z'
+    0x04, 0x3F, 0x21, // '{'
+    0x7F, // '|'
+    0x21, 0x3F, 0x04, // '}'
+    0x04, 0x02, 0x04, 0x02, // '~'
+    0x02, 0x05, 0x02, // U+00B0 degree sign
+    0xFC, 0x20, 0x20, 0x1C, // U+00B5 micro sign
+    0x1E, 0x2D, 0x2D, 0x21, // U+20AC euro sign
+    0x04, 0x04, 0x04, 0x0E, 0x04, // U+2192 rightwards arrow
+    0x3F, 0x21, 0x21, 0x3F, // U+FFFD replacement char
+};
+
+/*!
+ * Glyphs of the printable ASCII chars with direct index, then the sparse
+ * glyphs sorted by code.
+ */
+static const SSD1306_FontGlyph_t mFontSmallGlyphs[] =
+{
+    { 0x0020,    0, 0, 3 }, // ' '
+    { 0x0021,    0, 1, 2 }, // '!'
+    { 0x0022,    1, 3, 4 }, // '"'
+    { 0x0023,    4, 5, 6 }, // '#'
+    { 0x0024,    9, 5, 6 }, // '$'
+    { 0x0025,   14, 5, 6 }, // '%'
+    { 0x0026,   19, 5, 6 }, // '&'
+    { 0x0027,   24, 1, 2 }, // '\''
+    { 0x0028,   25, 2, 3 }, // '('
+    { 0x0029,   27, 2, 3 }, // ')'
+    { 0x002A,   29, 3, 4 }, // '*'
+    { 0x002B,   32, 3, 4 }, // '+'
+    { 0x002C,   35, 2, 3 }, // ','
+    { 0x002D,   37, 3, 4 }, // '-'
+    { 0x002E,   40, 1, 2 }, // '.'
+    { 0x002F,   41, 3, 4 }, // '/'
+    { 0x0030,   44, 4, 5 }, // '0'
+    { 0x0031,   48, 3, 4 }, // '1'
+    { 0x0032,   51, 4, 5 }, // '2'
+    { 0x0033,   55, 4, 5 }, // '3'
+    { 0x0034,   59, 4, 5 }, // '4'
+    { 0x0035,   63, 4, 5 }, // '5'
+    { 0x0036,   67, 4, 5 }, // '6'
+    { 0x0037,   71, 4, 5 }, // '7'
+    { 0x0038,   75, 4, 5 }, // '8'
+    { 0x0039,   79, 4, 5 }, // '9'
+    { 0x003A,   83, 1, 2 }, // ':'
+    { 0x003B,   84, 2, 3 }, // ';'
+    { 0x003C,   86, 3, 4 }, // '<'
+    { 0x003D,   89, 3, 4 }, // '='
+    { 0x003E,   92, 3, 4 }, // '>'
+    { 0x003F,   95, 4, 5 }, // '?'
+    { 0x0040,   99, 5, 6 }, // '@'
+    { 0x0041,  104, 4, 5 }, // 'A'
+    { 0x0042,  108, 4, 5 }, // 'B'
+    { 0x0043,  112, 4, 5 }, // 'C'
+    { 0x0044,  116, 4, 5 }, // 'D'
+    { 0x0045,  120, 4, 5 }, // 'E'
+    { 0x0046,  124, 4, 5 }, // 'F'
+    { 0x0047,  128, 4, 5 }, // 'G'
+    { 0x0048,  132, 4, 5 }, // 'H'
+    { 0x0049,  136, 3, 4 }, // 'I'
+    { 0x004A,  139, 4, 5 }, // 'J'
+    { 0x004B,  143, 4, 5 }, // 'K'
+    { 0x004C,  147, 4, 5 }, // 'L'
+    { 0x004D,  151, 5, 6 }, // 'M'
+    { 0x004E,  156, 4, 5 }, // 'N'
+    { 0x004F,  160, 4, 5 }, // 'O'
+    { 0x0050,  164, 4, 5 }, // 'P'
+    { 0x0051,  168, 4, 5 }, // 'Q'
+    { 0x0052,  172, 4, 5 }, // 'R'
+    { 0x0053,  176, 4, 5 }, // 'S'
+    { 0x0054,  180, 5, 6 }, // 'T'
+    { 0x0055,  185, 4, 5 }, // 'U'
+    { 0x0056,  189, 5, 6 }, // 'V'
+    { 0x0057,  194, 5, 6 }, // 'W'
+    { 0x0058,  199, 4, 5 }, // 'X'
+    { 0x0059,  203, 5, 6 }, // 'Y'
+    { 0x005A,  208, 4, 5 }, // 'Z'
+    { 0x005B,  212, 2, 3 }, // '['
+    { 0x005C,  214, 3, 4 }, // '\\'
+    { 0x005D,  217, 2, 3 }, // ']'
+    { 0x005E,  219, 3, 4 }, // '^'
+    { 0x005F,  222, 4, 5 }, // '_'
+    { 0x0060,  226, 2, 3 }, // '`'
+    { 0x0061,  228, 4, 5 }, // 'a'
+    { 0x0062,  232, 4, 5 }, // 'b'
+    { 0x0063,  236, 3, 4 }, // 'c'
+    { 0x0064,  239, 4, 5 }, // 'd'
+    { 0x0065,  243, 4, 5 }, // 'e'
+    { 0x0066,  247, 3, 4 }, // 'f'
+    { 0x0067,  250, 4, 5 }, // 'g'
+    { 0x0068,  254, 4, 5 }, // 'h'
+    { 0x0069,  258, 1, 2 }, // 'i'
+    { 0x006A,  259, 2, 3 }, // 'j'
+    { 0x006B,  261, 3, 4 }, // 'k'
+    { 0x006C,  264, 1, 2 }, // 'l'
+    { 0x006D,  265, 5, 6 }, // 'm'
+    { 0x006E,  270, 4, 5 }, // 'n'
+    { 0x006F,  274, 4, 5 }, // 'o'
+    { 0x0070,  278, 4, 5 }, // 'p'
+    { 0x0071,  282, 4, 5 }, // 'q'
+    { 0x0072,  286, 3, 4 }, // 'r'
+    { 0x0073,  289, 3, 4 }, // 's'
+    { 0x0074,  292, 3, 4 }, // 't'
+    { 0x0075,  295, 4, 5 }, // 'u'
+    { 0x0076,  299, 3, 4 }, // 'v'
+    { 0x0077,  302, 5, 6 }, // 'w'
+    { 0x0078,  307, 3, 4 }, // 'x'
+    { 0x0079,  310, 4, 5 }, // 'y'
+    { 0x007A,  314, 4, 5 }, // 'z'
+    { 0x007B,  318, 3, 4 }, // '{'
+    { 0x007C,  321, 1, 2 }, // '|'
+    { 0x007D,  322, 3, 4 }, // '}'
+    { 0x007E,  325, 4, 5 }, // '~'
+    { 0x00B0,  329, 3, 4 }, // U+00B0 degree sign
+    { 0x00B5,  332, 4, 5 }, // U+00B5 micro sign
+    { 0x20AC,  336, 4, 5 }, // U+20AC euro sign
+    { 0x2192,  340, 5, 6 }, // U+2192 rightwards arrow
+    { 0xFFFD,  345, 4, 5 }, // U+FFFD replacement char
+};
+
+const SSD1306_Font_t SSD1306_FONT_SMALL =
+{
+    8,                                               // Height
+    9,                                               // Line height
+    0x0020,                                          // First code
+    95,                                              // Direct count
+    sizeof(mFontSmallGlyphs) / sizeof(mFontSmallGlyphs[0]),
+    sizeof(mFontSmallGlyphs) / sizeof(mFontSmallGlyphs[0]) - 1, // U+FFFD
+    mFontSmallGlyphs,
+    mFontSmallBitmaps,
+};
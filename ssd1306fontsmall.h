@@ -0,0 +1,60 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef __WARCOMEB_SSD1306_FONT_SMALL_H
+#define __WARCOMEB_SSD1306_FONT_SMALL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ssd1306font.h"
+
+/*!
+ * \addtogroup SSD1306_Font
+ * \{
+ */
+
+/*!
+ * Small proportional font, 8 lines high: the capitals use the first 6
+ * lines, and the last 2 lines are for the descenders.
+ * It has all printable ASCII chars with direct index, and the sparse codes
+ * U+00B0 (degree sign), U+00B5 (micro sign), U+20AC (euro sign) and U+2192
+ * (rightwards arrow). The missing codes and the wrong UTF-8 sequences are
+ * drawn with U+FFFD, a box.
+ */
+extern const SSD1306_Font_t SSD1306_FONT_SMALL;
+
+/*!
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __WARCOMEB_SSD1306_FONT_SMALL_H
@@ -0,0 +1,189 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+/*!
+ * \file  /ssd1306plot.c
+ * \brief
+ */
+
+#include "ssd1306plot.h"
+
+/*!
+ * The function converts a value to the line of the display.
+ *
+ * \param[in]  plot: The handle of the plot.
+ * \param[in] value: The value.
+ * \return The line, limited to the plot area.
+ */
+static uint8_t getLine (SSD1306_PlotHandle_t plot, int16_t value)
+{
+    if (value <= plot->minimum) return plot->yPos + plot->height - 1;
+    if (value >= plot->maximum) return plot->yPos;
+
+    int32_t offset = ((int32_t)(value - plot->minimum) * (plot->height - 1)) /
+                     ((int32_t)plot->maximum - plot->minimum);
+    return (uint8_t)(plot->yPos + plot->height - 1 - offset);
+}
+
+/*!
+ * The function draws a column of the plot: the column is cleared, and then
+ * a single span is filled from the highest to the lowest sample, joined to
+ * the last sample of the previous column.
+ *
+ * \param[in]    plot: The handle of the plot.
+ * \param[in]  column: The column into the plot.
+ * \param[in] samples: The array of samples.
+ * \param[in]   count: The number of samples.
+ */
+static void drawColumn (SSD1306_PlotHandle_t plot,
+                        uint8_t column,
+                        const int16_t* samples,
+                        uint16_t count)
+{
+    int16_t low  = samples[0];
+    int16_t high = samples[0];
+
+    for (uint16_t i = 1; i < count; ++i)
+    {
+        if (samples[i] < low)  low  = samples[i];
+        if (samples[i] > high) high = samples[i];
+    }
+
+    uint8_t top    = getLine(plot, high);
+    uint8_t bottom = getLine(plot, low);
+    if (!plot->isFirst)
+    {
+        if (plot->lastLine < top)    top    = plot->lastLine;
+        if (plot->lastLine > bottom) bottom = plot->lastLine;
+    }
+    plot->lastLine = getLine(plot, samples[count - 1]);
+    plot->isFirst  = FALSE;
+
+    uint8_t x = plot->xPos + column;
+    SSD1306_drawRectangle(plot->dev, x, plot->yPos, 1, plot->height, SSD1306_COLOR_BLACK, TRUE);
+    SSD1306_drawRectangle(plot->dev, x, top, 1, bottom - top + 1, SSD1306_COLOR_COLOR, TRUE);
+}
+
+void SSD1306_plotInit (SSD1306_PlotHandle_t plot,
+                       SSD1306_DeviceHandle_t dev,
+                       uint8_t xPos,
+                       uint8_t yPos,
+                       uint8_t width,
+                       uint8_t height,
+                       int16_t minimum,
+                       int16_t maximum,
+                       uint8_t gap)
+{
+    ohiassert(plot != NULL);
+    ohiassert(dev != NULL);
+    ohiassert((width > 0) && (height > 0));
+    ohiassert(maximum > minimum);
+
+    memset(plot, 0, sizeof(SSD1306_Plot_t));
+
+    plot->dev     = dev;
+    plot->xPos    = xPos;
+    plot->yPos    = yPos;
+    plot->width   = width;
+    plot->height  = height;
+    plot->minimum = minimum;
+    plot->maximum = maximum;
+    plot->gap     = (gap < width) ? gap : (width - 1);
+    plot->cursor  = 0;
+    plot->isFirst = TRUE;
+
+    SSD1306_drawRectangle(dev, xPos, yPos, width, height, SSD1306_COLOR_BLACK, TRUE);
+}
+
+void SSD1306_plotDraw (SSD1306_PlotHandle_t plot, const int16_t* samples, uint16_t count)
+{
+    SSD1306_drawRectangle(plot->dev, plot->xPos, plot->yPos, plot->width, plot->height,
+                          SSD1306_COLOR_BLACK, TRUE);
+    plot->isFirst = TRUE;
+
+    if (count <= plot->width)
+    {
+        for (uint16_t i = 0; i < count; ++i)
+        {
+            drawColumn(plot, i, &samples[i], 1);
+        }
+        plot->cursor = (count < plot->width) ? count : 0;
+    }
+    else
+    {
+        // Decimation: minimum and maximum of the samples of every column
+        for (uint8_t column = 0; column < plot->width; ++column)
+        {
+            uint16_t first = ((uint32_t)column * count) / plot->width;
+            uint16_t last  = ((uint32_t)(column + 1) * count) / plot->width;
+            drawColumn(plot, column, &samples[first], last - first);
+        }
+        plot->cursor = 0;
+    }
+
+    // The first column is not joined to the last one
+    if (plot->cursor == 0)
+        plot->isFirst = TRUE;
+
+    SSD1306_flushArea(plot->dev, plot->xPos, plot->yPos, plot->width, plot->height);
+}
+
+void SSD1306_plotPushBlock (SSD1306_PlotHandle_t plot, const int16_t* samples, uint16_t count)
+{
+    if ((samples == NULL) || (count == 0))
+        return;
+
+    // The column at the end of the gap is erased
+    uint8_t erased = (plot->cursor + plot->gap) % plot->width;
+    if (plot->gap > 0)
+    {
+        SSD1306_drawRectangle(plot->dev, plot->xPos + erased, plot->yPos, 1, plot->height,
+                              SSD1306_COLOR_BLACK, TRUE);
+    }
+
+    drawColumn(plot, plot->cursor, samples, count);
+
+    // The new column and the erased one are sent together, so the flush
+    // planner can merge them
+    SSD1306_Region_t regions[2] =
+    {
+        { plot->xPos + plot->cursor, plot->yPos, 1, plot->height },
+        { plot->xPos + erased,       plot->yPos, 1, plot->height },
+    };
+    SSD1306_flushAreas(plot->dev, regions, (plot->gap > 0) ? 2 : 1);
+
+    plot->cursor = (plot->cursor + 1) % plot->width;
+
+    // The first column is not joined to the last one
+    if (plot->cursor == 0)
+        plot->isFirst = TRUE;
+}
+
+void SSD1306_plotPush (SSD1306_PlotHandle_t plot, int16_t sample)
+{
+    SSD1306_plotPushBlock(plot, &sample, 1);
+}
@@ -0,0 +1,134 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef __WARCOMEB_SSD1306_PLOT_H
+#define __WARCOMEB_SSD1306_PLOT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ssd1306.h"
+
+/*!
+ * \defgroup SSD1306_Plot
+ * \ingroup SSD1306
+ * \{
+ */
+
+/*!
+ * SSD1306 plot class.
+ * Every column of the plot is drawn as a single vertical span, that covers
+ * the samples of the column and joins the previous column.
+ * New samples are added in sweep mode, like an oscilloscope: the cursor
+ * moves to the right and restarts from the left, and a gap of empty columns
+ * is kept in front of it. Every new column changes only two columns: the new
+ * one and the one erased at the end of the gap.
+ */
+typedef struct _SSD1306_Plot_t
+{
+    SSD1306_DeviceHandle_t dev;
+
+    uint8_t xPos;
+    uint8_t yPos;
+    uint8_t width;
+    uint8_t height;
+
+    int16_t minimum;             /*!< Value on the bottom line */
+    int16_t maximum;             /*!< Value on the top line */
+
+    uint8_t cursor;              /*!< Column of the next sample */
+    uint8_t gap;                 /*!< Empty columns in front of the cursor */
+    uint8_t lastLine;            /*!< Line of the last sample */
+    bool isFirst;                /*!< There is no previous sample */
+
+} SSD1306_Plot_t, *SSD1306_PlotHandle_t;
+
+/*!
+ * The function initialize the plot and clears its area.
+ * \note To send the design to the display, you must use \ref SSD1306_flush
+ *
+ * \param[in]    plot: The handle of the plot.
+ * \param[in]     dev: The handle of the device.
+ * \param[in]    xPos: The x position of the plot.
+ * \param[in]    yPos: The y position of the plot.
+ * \param[in]   width: The width of the plot.
+ * \param[in]  height: The height of the plot.
+ * \param[in] minimum: The value shown on the bottom line.
+ * \param[in] maximum: The value shown on the top line.
+ * \param[in]     gap: The number of empty columns in front of the cursor.
+ */
+void SSD1306_plotInit (SSD1306_PlotHandle_t plot,
+                       SSD1306_DeviceHandle_t dev,
+                       uint8_t xPos,
+                       uint8_t yPos,
+                       uint8_t width,
+                       uint8_t height,
+                       int16_t minimum,
+                       int16_t maximum,
+                       uint8_t gap);
+
+/*!
+ * The function draws a whole array of samples, and sends the plot area.
+ * When there are more samples than columns, every column shows the minimum
+ * and maximum of its samples. When there are less samples than columns, one
+ * sample is drawn for each column, and the cursor is moved after the last one.
+ *
+ * \param[in]    plot: The handle of the plot.
+ * \param[in] samples: The array of samples.
+ * \param[in]   count: The number of samples.
+ */
+void SSD1306_plotDraw (SSD1306_PlotHandle_t plot, const int16_t* samples, uint16_t count);
+
+/*!
+ * The function adds a column at the cursor position, showing the minimum and
+ * maximum of a block of samples, and sends only the changed columns.
+ *
+ * \param[in]    plot: The handle of the plot.
+ * \param[in] samples: The array of samples.
+ * \param[in]   count: The number of samples, at least one.
+ */
+void SSD1306_plotPushBlock (SSD1306_PlotHandle_t plot, const int16_t* samples, uint16_t count);
+
+/*!
+ * The function adds a sample at the cursor position, and sends only the
+ * changed columns.
+ *
+ * \param[in]   plot: The handle of the plot.
+ * \param[in] sample: The new sample.
+ */
+void SSD1306_plotPush (SSD1306_PlotHandle_t plot, int16_t sample);
+
+/*!
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __WARCOMEB_SSD1306_PLOT_H
@@ -0,0 +1,255 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+/*!
+ * \file  /ssd1306sprite.c
+ * \brief
+ */
+
+#include "ssd1306sprite.h"
+
+/*!
+ * The function reads 8 vertical pixels starting from any row, also out of
+ * the display: the missing pixels are zero.
+ *
+ * \param[in]  dev: The handle of the device
+ * \param[in] xPos: The x position
+ * \param[in]  row: The y position of the first pixel
+ * \return The 8 pixels, bit 0 on top
+ */
+static uint8_t readBlock (SSD1306_DeviceHandle_t dev, int16_t xPos, int16_t row)
+{
+    if ((xPos < 0) || (xPos >= dev->gdl.width) || (row <= -8) || (row >= dev->gdl.height))
+        return 0;
+
+    if (row < 0)
+        return (uint8_t)(SSD1306_readColumn(dev, xPos, 0) << (-row));
+
+    return SSD1306_readColumn(dev, xPos, row);
+}
+
+/*!
+ * The function writes 8 vertical pixels starting from any row, also out of
+ * the display: the missing pixels are discarded.
+ *
+ * \param[in]  dev: The handle of the device
+ * \param[in] xPos: The x position
+ * \param[in]  row: The y position of the first pixel
+ * \param[in] bits: The 8 pixels, bit 0 on top
+ * \param[in] mask: The pixels to be changed
+ */
+static void writeBlock (SSD1306_DeviceHandle_t dev,
+                        int16_t xPos,
+                        int16_t row,
+                        uint8_t bits,
+                        uint8_t mask)
+{
+    if ((mask == 0) || (xPos < 0) || (xPos >= dev->gdl.width) || (row <= -8) || (row >= dev->gdl.height))
+        return;
+
+    if (row < 0)
+    {
+        SSD1306_writeColumn(dev, xPos, 0, bits >> (-row), mask >> (-row));
+    }
+    else
+    {
+        SSD1306_writeColumn(dev, xPos, row, bits, mask);
+    }
+}
+
+/*!
+ * The function composites a page-major image into the buffer.
+ *
+ * \param[in]    dev: The handle of the device
+ * \param[in]   xPos: The x position of the top-left corner
+ * \param[in]   yPos: The y position of the top-left corner
+ * \param[in]  width: The width of the image
+ * \param[in] height: The height of the image
+ * \param[in] bitmap: The pixels of the image
+ * \param[in]   mask: The pixels to be drawn, NULL for all
+ * \param[in]  blend: The blend operation
+ */
+static void drawImage (SSD1306_DeviceHandle_t dev,
+                       int16_t xPos,
+                       int16_t yPos,
+                       uint8_t width,
+                       uint8_t height,
+                       const uint8_t* bitmap,
+                       const uint8_t* mask,
+                       SSD1306_Blend_t blend)
+{
+    // Only the columns into the display are drawn
+    int16_t first = (xPos < 0) ? -xPos : 0;
+    int16_t last  = ((xPos + width) > dev->gdl.width) ? (dev->gdl.width - xPos) : width;
+
+    for (uint8_t page = 0; page < ((height + 7) / 8); ++page)
+    {
+        int16_t row = yPos + page * 8;
+        if ((row <= -8) || (row >= dev->gdl.height))
+            continue;
+
+        // Remove the rows out of the image
+        uint8_t rows = ((height - page * 8) < 8) ? (uint8_t)((1u << (height - page * 8)) - 1) : 0xFF;
+        uint16_t index = (uint16_t)page * width;
+
+        for (int16_t column = first; column < last; ++column)
+        {
+            uint8_t bits = bitmap[index + column];
+            uint8_t m    = (mask != NULL) ? (mask[index + column] & rows) : rows;
+
+            switch (blend)
+            {
+            case SSD1306_BLEND_OR:
+                writeBlock(dev, xPos + column, row, 0xFF, bits & m);
+                break;
+            case SSD1306_BLEND_AND_NOT:
+                writeBlock(dev, xPos + column, row, 0x00, bits & m);
+                break;
+            case SSD1306_BLEND_XOR:
+                writeBlock(dev, xPos + column, row, ~readBlock(dev, xPos + column, row), bits & m);
+                break;
+            case SSD1306_BLEND_MASKED:
+                writeBlock(dev, xPos + column, row, bits, m);
+                break;
+            }
+        }
+    }
+}
+
+/*!
+ * The function computes the area of the display covered by a sprite.
+ *
+ * \param[in]  sprite: The handle of the sprite
+ * \param[in]    xPos: The x position of the top-left corner
+ * \param[in]    yPos: The y position of the top-left corner
+ * \param[out] region: The area, without the part on the left and above
+ *                     the display
+ * \return FALSE when the sprite is all out of the display.
+ */
+static bool getRegion (const SSD1306_Sprite_t* sprite, int16_t xPos, int16_t yPos, SSD1306_Region_t* region)
+{
+    int32_t xStart = (xPos < 0) ? 0 : xPos;
+    int32_t yStart = (yPos < 0) ? 0 : yPos;
+    int32_t xStop  = (int32_t)xPos + sprite->width;
+    int32_t yStop  = (int32_t)yPos + sprite->height;
+
+    if ((xStop <= xStart) || (yStop <= yStart))
+        return FALSE;
+
+    region->xPos   = (uint16_t)xStart;
+    region->yPos   = (uint16_t)yStart;
+    region->width  = (uint16_t)(xStop - xStart);
+    region->height = (uint16_t)(yStop - yStart);
+    return TRUE;
+}
+
+void SSD1306_drawSprite (SSD1306_DeviceHandle_t dev,
+                         const SSD1306_Sprite_t* sprite,
+                         int16_t xPos,
+                         int16_t yPos,
+                         SSD1306_Blend_t blend)
+{
+    ohiassert(sprite != NULL);
+    ohiassert(sprite->bitmap != NULL);
+
+    drawImage(dev, xPos, yPos, sprite->width, sprite->height, sprite->bitmap, sprite->mask, blend);
+}
+
+void SSD1306_saveSprite (SSD1306_DeviceHandle_t dev,
+                         const SSD1306_Sprite_t* sprite,
+                         int16_t xPos,
+                         int16_t yPos,
+                         uint8_t* background)
+{
+    ohiassert(sprite != NULL);
+    ohiassert(background != NULL);
+
+    for (uint8_t page = 0; page < ((sprite->height + 7) / 8); ++page)
+    {
+        for (uint8_t column = 0; column < sprite->width; ++column)
+        {
+            *background++ = readBlock(dev, xPos + column, yPos + page * 8);
+        }
+    }
+}
+
+void SSD1306_restoreSprite (SSD1306_DeviceHandle_t dev,
+                            const SSD1306_Sprite_t* sprite,
+                            int16_t xPos,
+                            int16_t yPos,
+                            const uint8_t* background)
+{
+    ohiassert(sprite != NULL);
+    ohiassert(background != NULL);
+
+    drawImage(dev, xPos, yPos, sprite->width, sprite->height, background, NULL, SSD1306_BLEND_MASKED);
+}
+
+void SSD1306_flushSprite (SSD1306_DeviceHandle_t dev,
+                          const SSD1306_Sprite_t* sprite,
+                          int16_t xPos,
+                          int16_t yPos)
+{
+    ohiassert(sprite != NULL);
+
+    SSD1306_Region_t region;
+    if (getRegion(sprite, xPos, yPos, &region))
+    {
+        SSD1306_flushAreas(dev, &region, 1);
+    }
+}
+
+void SSD1306_moveSprite (SSD1306_DeviceHandle_t dev,
+                         const SSD1306_Sprite_t* sprite,
+                         int16_t xOld,
+                         int16_t yOld,
+                         int16_t xNew,
+                         int16_t yNew,
+                         SSD1306_Blend_t blend,
+                         uint8_t* background)
+{
+    ohiassert(sprite != NULL);
+    ohiassert((background != NULL) || (blend == SSD1306_BLEND_XOR));
+
+    if (background != NULL)
+    {
+        SSD1306_restoreSprite(dev, sprite, xOld, yOld, background);
+        SSD1306_saveSprite(dev, sprite, xNew, yNew, background);
+    }
+    else
+    {
+        SSD1306_drawSprite(dev, sprite, xOld, yOld, SSD1306_BLEND_XOR);
+    }
+    SSD1306_drawSprite(dev, sprite, xNew, yNew, blend);
+
+    // Send both positions, the planner merges them when it is cheaper
+    SSD1306_Region_t regions[2];
+    uint8_t count = 0;
+    if (getRegion(sprite, xOld, yOld, &regions[count])) count++;
+    if (getRegion(sprite, xNew, yNew, &regions[count])) count++;
+    SSD1306_flushAreas(dev, regions, count);
+}
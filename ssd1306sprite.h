@@ -0,0 +1,167 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef __WARCOMEB_SSD1306_SPRITE_H
+#define __WARCOMEB_SSD1306_SPRITE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ssd1306.h"
+
+/*!
+ * \defgroup SSD1306_Sprite
+ * \ingroup SSD1306
+ * \{
+ */
+
+/*!
+ * The number of bytes of a page-major image of the selected dimensions, to
+ * be used for the bitmap, the mask and the saved background.
+ */
+#define SSD1306_SPRITE_SIZE(width,height)   ((uint16_t)(width) * (((height) + 7) / 8))
+
+/*!
+ * SSD1306 sprite class.
+ * The bitmap and the mask are page-major, like the display buffer: every
+ * byte holds 8 vertical pixels, bit 0 on top, and a page of width bytes is
+ * followed by the next page.
+ */
+typedef struct _SSD1306_Sprite_t
+{
+    uint8_t width;
+    uint8_t height;
+
+    const uint8_t* bitmap;       /*!< The pixels of the sprite */
+    const uint8_t* mask;         /*!< The pixels to be drawn, NULL for all */
+
+} SSD1306_Sprite_t, *SSD1306_SpriteHandle_t;
+
+/*!
+ * The function composites a sprite into the internal buffer, in any
+ * position, also partially out of the display. Only the pixels selected by
+ * the mask and inside the clip area are changed:
+ * - \ref SSD1306_BLEND_OR sets the pixels of the bitmap,
+ * - \ref SSD1306_BLEND_AND_NOT clears the pixels of the bitmap,
+ * - \ref SSD1306_BLEND_XOR inverts the pixels of the bitmap, and drawing the
+ *   sprite again in the same position erases it,
+ * - \ref SSD1306_BLEND_MASKED copies the bitmap.
+ * \note To send the design to the display, you must use \ref SSD1306_flushSprite
+ *
+ * \param[in]    dev: The handle of the device
+ * \param[in] sprite: The handle of the sprite
+ * \param[in]   xPos: The x position of the top-left corner
+ * \param[in]   yPos: The y position of the top-left corner
+ * \param[in]  blend: The blend operation
+ */
+void SSD1306_drawSprite (SSD1306_DeviceHandle_t dev,
+                         const SSD1306_Sprite_t* sprite,
+                         int16_t xPos,
+                         int16_t yPos,
+                         SSD1306_Blend_t blend);
+
+/*!
+ * The function saves the area of the internal buffer under a sprite.
+ *
+ * \param[in]         dev: The handle of the device
+ * \param[in]      sprite: The handle of the sprite
+ * \param[in]        xPos: The x position of the top-left corner
+ * \param[in]        yPos: The y position of the top-left corner
+ * \param[out] background: The saved area, of \ref SSD1306_SPRITE_SIZE bytes
+ */
+void SSD1306_saveSprite (SSD1306_DeviceHandle_t dev,
+                         const SSD1306_Sprite_t* sprite,
+                         int16_t xPos,
+                         int16_t yPos,
+                         uint8_t* background);
+
+/*!
+ * The function restores the area saved with \ref SSD1306_saveSprite.
+ * \note To send the design to the display, you must use \ref SSD1306_flushSprite
+ *
+ * \param[in]        dev: The handle of the device
+ * \param[in]     sprite: The handle of the sprite
+ * \param[in]       xPos: The x position of the top-left corner
+ * \param[in]       yPos: The y position of the top-left corner
+ * \param[in] background: The saved area
+ */
+void SSD1306_restoreSprite (SSD1306_DeviceHandle_t dev,
+                            const SSD1306_Sprite_t* sprite,
+                            int16_t xPos,
+                            int16_t yPos,
+                            const uint8_t* background);
+
+/*!
+ * The function sends to the display the area covered by a sprite.
+ *
+ * \param[in]    dev: The handle of the device
+ * \param[in] sprite: The handle of the sprite
+ * \param[in]   xPos: The x position of the top-left corner
+ * \param[in]   yPos: The y position of the top-left corner
+ */
+void SSD1306_flushSprite (SSD1306_DeviceHandle_t dev,
+                          const SSD1306_Sprite_t* sprite,
+                          int16_t xPos,
+                          int16_t yPos);
+
+/*!
+ * The function moves a sprite: the old one is erased, restoring the saved
+ * background or, without background, drawing it again with
+ * \ref SSD1306_BLEND_XOR. When a background is used, the area under the
+ * new position is saved before drawing. The areas of the old and the new
+ * position are sent together with \ref SSD1306_flushAreas, so the flush
+ * planner merges them only when it is cheaper.
+ *
+ * \param[in]        dev: The handle of the device
+ * \param[in]     sprite: The handle of the sprite
+ * \param[in]       xOld: The old x position
+ * \param[in]       yOld: The old y position
+ * \param[in]       xNew: The new x position
+ * \param[in]       yNew: The new y position
+ * \param[in]      blend: The blend operation, must be \ref SSD1306_BLEND_XOR
+ *                        without background
+ * \param[in] background: The saved area, or NULL
+ */
+void SSD1306_moveSprite (SSD1306_DeviceHandle_t dev,
+                         const SSD1306_Sprite_t* sprite,
+                         int16_t xOld,
+                         int16_t yOld,
+                         int16_t xNew,
+                         int16_t yNew,
+                         SSD1306_Blend_t blend,
+                         uint8_t* background);
+
+/*!
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __WARCOMEB_SSD1306_SPRITE_H
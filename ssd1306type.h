@@ -49,6 +49,48 @@ typedef enum _SSD1306_Color_t
     SSD1306_COLOR_COLOR
 } SSD1306_Color_t;
 
+/*!
+ * List of possible display orientations, managed by the driver
+ */
+typedef enum _SSD1306_Orientation_t
+{
+    SSD1306_ORIENTATION_NORMAL     = 0x00,
+    SSD1306_ORIENTATION_MIRROR_X   = 0x01,
+    SSD1306_ORIENTATION_MIRROR_Y   = 0x02,
+    SSD1306_ORIENTATION_ROTATE_180 = 0x03,
+} SSD1306_Orientation_t;
+
+/*!
+ * List of possible clockwise rotations of an area
+ */
+typedef enum _SSD1306_Rotation_t
+{
+    SSD1306_ROTATION_90,
+    SSD1306_ROTATION_180,
+    SSD1306_ROTATION_270,
+} SSD1306_Rotation_t;
+
+/*!
+ * List of possible dithering algorithms for grayscale pictures
+ */
+typedef enum _SSD1306_Dither_t
+{
+    SSD1306_DITHER_THRESHOLD,          /*!< Fixed threshold at half scale */
+    SSD1306_DITHER_BAYER,              /*!< Ordered dithering, 8x8 Bayer matrix */
+    SSD1306_DITHER_FLOYD_STEINBERG,    /*!< Error diffusion */
+} SSD1306_Dither_t;
+
+/*!
+ * List of possible blend operations of a sprite into the buffer
+ */
+typedef enum _SSD1306_Blend_t
+{
+    SSD1306_BLEND_OR,                  /*!< Sets the pixels of the sprite */
+    SSD1306_BLEND_AND_NOT,             /*!< Clears the pixels of the sprite */
+    SSD1306_BLEND_XOR,                 /*!< Inverts the pixels of the sprite */
+    SSD1306_BLEND_MASKED,              /*!< Copies the sprite where the mask is set */
+} SSD1306_Blend_t;
+
 /*!
  * \defgroup SSD1306_Type_Product
  * \{
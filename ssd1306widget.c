@@ -0,0 +1,449 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+/*!
+ * \file  /ssd1306widget.c
+ * \brief
+ */
+
+#include "ssd1306widget.h"
+
+#define SSD1306_WIDGET_GAUGE_STEPS             64
+
+/*!
+ * Sine of a quarter circle, in 32 steps, scaled to 255.
+ */
+static const uint8_t mSineTable[(SSD1306_WIDGET_GAUGE_STEPS/2) + 1] =
+{
+      0,  13,  25,  37,  50,  62,  74,  86,  98, 109, 120,
+    131, 142, 152, 162, 171, 180, 189, 197, 205, 212, 219,
+    225, 231, 236, 240, 244, 247, 250, 252, 254, 255, 255,
+};
+
+/*!
+ * The function initialize the common part of a widget.
+ */
+static void initWidget (SSD1306_WidgetHandle_t widget,
+                        SSD1306_DeviceHandle_t dev,
+                        SSD1306_WidgetType_t type,
+                        uint8_t xPos,
+                        uint8_t yPos,
+                        uint8_t width,
+                        uint8_t height)
+{
+    ohiassert(widget != NULL);
+    ohiassert(dev != NULL);
+
+    memset(widget, 0, sizeof(SSD1306_Widget_t));
+
+    widget->dev     = dev;
+    widget->type    = type;
+    widget->xPos    = xPos;
+    widget->yPos    = yPos;
+    widget->width   = width;
+    widget->height  = height;
+    widget->isDrawn = FALSE;
+}
+
+/*!
+ * The function computes the level of a value into a range.
+ *
+ * \param[in] widget: The handle of the widget.
+ * \param[in]  steps: The number of steps of the full range.
+ * \return The level, from 0 to steps.
+ */
+static uint8_t getLevel (SSD1306_WidgetHandle_t widget, uint8_t steps)
+{
+    if (widget->value <= widget->minimum) return 0;
+    if (widget->value >= widget->maximum) return steps;
+
+    return (uint8_t)(((int64_t)(widget->value - widget->minimum) * steps) /
+                     (widget->maximum - widget->minimum));
+}
+
+/*!
+ * The function draws the changed chars of a label or a numeric field, and
+ * sends together all of them.
+ *
+ * \param[in] widget: The handle of the widget.
+ * \return TRUE when something was drawn.
+ */
+static bool updateText (SSD1306_WidgetHandle_t widget)
+{
+    int16_t first = -1;
+    int16_t last  = -1;
+
+    for (uint8_t i = 0; i < widget->chars; ++i)
+    {
+        if (widget->text[i] != widget->shown[i])
+        {
+            SSD1306_drawChar(widget->dev,
+                             widget->xPos + (uint16_t)i * SSD1306_WIDGET_CHAR_WIDTH,
+                             widget->yPos,
+                             widget->text[i],
+                             SSD1306_COLOR_COLOR,
+                             1);
+            widget->shown[i] = widget->text[i];
+
+            if (first < 0) first = i;
+            last = i;
+        }
+    }
+
+    if (first < 0) return FALSE;
+
+    SSD1306_flushArea(widget->dev,
+                      widget->xPos + first * SSD1306_WIDGET_CHAR_WIDTH,
+                      widget->yPos,
+                      (last - first + 1) * SSD1306_WIDGET_CHAR_WIDTH,
+                      SSD1306_WIDGET_CHAR_HEIGHT);
+    return TRUE;
+}
+
+/*!
+ * The function draws the changed part of a progress bar.
+ *
+ * \param[in] widget: The handle of the widget.
+ * \return TRUE when something was drawn.
+ */
+static bool updateProgress (SSD1306_WidgetHandle_t widget)
+{
+    uint8_t inner = widget->width - 2;
+    uint8_t level = getLevel(widget, inner);
+
+    if (!widget->isDrawn)
+    {
+        SSD1306_drawRectangle(widget->dev, widget->xPos, widget->yPos,
+                              widget->width, widget->height, SSD1306_COLOR_BLACK, TRUE);
+        SSD1306_drawRectangle(widget->dev, widget->xPos, widget->yPos,
+                              widget->width, widget->height, SSD1306_COLOR_COLOR, FALSE);
+        widget->level = 0;
+    }
+    else if (level == widget->level)
+    {
+        return FALSE;
+    }
+
+    // Only the columns between the old and the new level are changed
+    uint8_t start = (level > widget->level) ? widget->level : level;
+    uint8_t stop  = (level > widget->level) ? level : widget->level;
+    SSD1306_drawRectangle(widget->dev,
+                          widget->xPos + 1 + start,
+                          widget->yPos + 1,
+                          stop - start,
+                          widget->height - 2,
+                          (level > widget->level) ? SSD1306_COLOR_COLOR : SSD1306_COLOR_BLACK,
+                          TRUE);
+    widget->level = level;
+
+    if (!widget->isDrawn)
+    {
+        SSD1306_flushArea(widget->dev, widget->xPos, widget->yPos, widget->width, widget->height);
+    }
+    else
+    {
+        SSD1306_flushArea(widget->dev, widget->xPos + 1 + start, widget->yPos, stop - start, widget->height);
+    }
+    return TRUE;
+}
+
+/*!
+ * The function draws the needle of a gauge, or a new needle.
+ *
+ * \param[in] widget: The handle of the widget.
+ * \return TRUE when something was drawn.
+ */
+static bool updateGauge (SSD1306_WidgetHandle_t widget)
+{
+    uint8_t radius  = widget->height - 1;
+    uint8_t xCenter = widget->xPos + radius;
+    uint8_t yCenter = widget->yPos + radius;
+    uint8_t length  = (radius > 2) ? (radius - 2) : 1;
+    uint8_t level   = getLevel(widget, SSD1306_WIDGET_GAUGE_STEPS);
+
+    if (widget->isDrawn && (level == widget->level))
+        return FALSE;
+
+    // The bottom half of circles is out of the clip area
+    SSD1306_pushClip(widget->dev, widget->xPos, widget->yPos, widget->width, widget->height);
+
+    if (!widget->isDrawn)
+    {
+        // Half circle ring
+        SSD1306_fillCircle(widget->dev, xCenter, yCenter, radius, SSD1306_COLOR_COLOR);
+        SSD1306_fillCircle(widget->dev, xCenter, yCenter, radius - 1, SSD1306_COLOR_BLACK);
+    }
+
+    // Needle direction, from left (level 0) to right
+    int16_t cosine, sine;
+    if (level <= (SSD1306_WIDGET_GAUGE_STEPS/2))
+    {
+        cosine = -(int16_t)mSineTable[(SSD1306_WIDGET_GAUGE_STEPS/2) - level];
+        sine   = mSineTable[level];
+    }
+    else
+    {
+        cosine = mSineTable[level - (SSD1306_WIDGET_GAUGE_STEPS/2)];
+        sine   = mSineTable[SSD1306_WIDGET_GAUGE_STEPS - level];
+    }
+    uint8_t xNeedle = (uint8_t)(xCenter + (cosine * length + (cosine < 0 ? -127 : 127)) / 255);
+    uint8_t yNeedle = (uint8_t)(yCenter - (sine * length + 127) / 255);
+
+    // Bounding box of the old and new needle
+    uint8_t xMin = (xNeedle < xCenter) ? xNeedle : xCenter;
+    uint8_t xMax = (xNeedle > xCenter) ? xNeedle : xCenter;
+    uint8_t yMin = yNeedle;
+
+    if (widget->isDrawn)
+    {
+        SSD1306_drawLine(widget->dev, xCenter, yCenter, widget->xNeedle, widget->yNeedle, SSD1306_COLOR_BLACK);
+        if (widget->xNeedle < xMin) xMin = widget->xNeedle;
+        if (widget->xNeedle > xMax) xMax = widget->xNeedle;
+        if (widget->yNeedle < yMin) yMin = widget->yNeedle;
+    }
+    SSD1306_drawLine(widget->dev, xCenter, yCenter, xNeedle, yNeedle, SSD1306_COLOR_COLOR);
+    SSD1306_fillCircle(widget->dev, xCenter, yCenter, 1, SSD1306_COLOR_COLOR);
+
+    SSD1306_popClip(widget->dev);
+
+    widget->level   = level;
+    widget->xNeedle = xNeedle;
+    widget->yNeedle = yNeedle;
+
+    if (!widget->isDrawn)
+    {
+        SSD1306_flushArea(widget->dev, widget->xPos, widget->yPos, widget->width, widget->height);
+    }
+    else
+    {
+        // The hub is one pixel larger than the needle start
+        if (xMin > 0) xMin--;
+        SSD1306_flushArea(widget->dev, xMin, yMin, xMax - xMin + 2, yCenter - yMin + 1);
+    }
+    return TRUE;
+}
+
+/*!
+ * The function draws the current icon.
+ *
+ * \param[in] widget: The handle of the widget.
+ * \return TRUE when something was drawn.
+ */
+static bool updateIcon (SSD1306_WidgetHandle_t widget)
+{
+    uint8_t level = (widget->value < 0) ? 0 :
+                    (widget->value >= widget->iconCount) ? (widget->iconCount - 1) : (uint8_t)widget->value;
+
+    if (widget->isDrawn && (level == widget->level))
+        return FALSE;
+
+    const uint8_t* icon = widget->icons[level];
+    uint8_t pages = (widget->height + 7) / 8;
+
+    for (uint8_t page = 0; page < pages; ++page)
+    {
+        uint8_t lines = widget->height - page * 8;
+        uint8_t mask  = (lines < 8) ? (uint8_t)((1u << lines) - 1) : 0xFF;
+
+        for (uint8_t x = 0; x < widget->width; ++x)
+        {
+            SSD1306_writeColumn(widget->dev,
+                                widget->xPos + x,
+                                widget->yPos + page * 8,
+                                icon[page * widget->width + x],
+                                mask);
+        }
+    }
+    widget->level = level;
+
+    SSD1306_flushArea(widget->dev, widget->xPos, widget->yPos, widget->width, widget->height);
+    return TRUE;
+}
+
+void SSD1306_widgetLabel (SSD1306_WidgetHandle_t widget,
+                          SSD1306_DeviceHandle_t dev,
+                          uint8_t xPos,
+                          uint8_t yPos,
+                          uint8_t chars)
+{
+    if (chars > SSD1306_WIDGET_MAX_CHARS) chars = SSD1306_WIDGET_MAX_CHARS;
+
+    initWidget(widget, dev, SSD1306_WIDGETTYPE_LABEL, xPos, yPos,
+               chars * SSD1306_WIDGET_CHAR_WIDTH, SSD1306_WIDGET_CHAR_HEIGHT);
+    widget->chars = chars;
+    memset(widget->text, ' ', sizeof(widget->text));
+}
+
+void SSD1306_widgetNumber (SSD1306_WidgetHandle_t widget,
+                           SSD1306_DeviceHandle_t dev,
+                           uint8_t xPos,
+                           uint8_t yPos,
+                           uint8_t chars)
+{
+    ohiassert(chars > 0);
+
+    SSD1306_widgetLabel(widget, dev, xPos, yPos, chars);
+    widget->type = SSD1306_WIDGETTYPE_NUMBER;
+    SSD1306_widgetSetValue(widget, 0);
+}
+
+void SSD1306_widgetProgress (SSD1306_WidgetHandle_t widget,
+                             SSD1306_DeviceHandle_t dev,
+                             uint8_t xPos,
+                             uint8_t yPos,
+                             uint8_t width,
+                             uint8_t height,
+                             int32_t minimum,
+                             int32_t maximum)
+{
+    ohiassert((width > 2) && (height > 2));
+    ohiassert(maximum > minimum);
+
+    initWidget(widget, dev, SSD1306_WIDGETTYPE_PROGRESS, xPos, yPos, width, height);
+    widget->minimum = minimum;
+    widget->maximum = maximum;
+    widget->value   = minimum;
+}
+
+void SSD1306_widgetGauge (SSD1306_WidgetHandle_t widget,
+                          SSD1306_DeviceHandle_t dev,
+                          uint8_t xPos,
+                          uint8_t yPos,
+                          uint8_t radius,
+                          int32_t minimum,
+                          int32_t maximum)
+{
+    ohiassert(radius > 1);
+    ohiassert(maximum > minimum);
+
+    initWidget(widget, dev, SSD1306_WIDGETTYPE_GAUGE, xPos, yPos, 2 * radius + 1, radius + 1);
+    widget->minimum = minimum;
+    widget->maximum = maximum;
+    widget->value   = minimum;
+}
+
+void SSD1306_widgetIcon (SSD1306_WidgetHandle_t widget,
+                         SSD1306_DeviceHandle_t dev,
+                         uint8_t xPos,
+                         uint8_t yPos,
+                         uint8_t width,
+                         uint8_t height,
+                         const uint8_t* const* icons,
+                         uint8_t iconCount)
+{
+    ohiassert((icons != NULL) && (iconCount > 0));
+
+    initWidget(widget, dev, SSD1306_WIDGETTYPE_ICON, xPos, yPos, width, height);
+    widget->icons     = icons;
+    widget->iconCount = iconCount;
+}
+
+void SSD1306_widgetSetValue (SSD1306_WidgetHandle_t widget, int32_t value)
+{
+    widget->value = value;
+
+    if ((widget->type == SSD1306_WIDGETTYPE_NUMBER) && (widget->chars > 0))
+    {
+        // Right aligned digits, the unused chars are spaces
+        uint32_t number = (value < 0) ? (uint32_t)(-(int64_t)value) : (uint32_t)value;
+        int16_t i = widget->chars - 1;
+
+        do
+        {
+            widget->text[i--] = '0' + (number % 10);
+            number /= 10;
+        } while ((number > 0) && (i >= 0));
+
+        if ((value < 0) && (i >= 0))
+        {
+            widget->text[i--] = '-';
+        }
+        else if ((number > 0) || (value < 0))
+        {
+            // The number does not fit
+            memset(widget->text, '#', widget->chars);
+        }
+
+        while (i >= 0)
+        {
+            widget->text[i--] = ' ';
+        }
+    }
+}
+
+void SSD1306_widgetSetText (SSD1306_WidgetHandle_t widget, const char* text)
+{
+    uint8_t i = 0;
+
+    while ((i < widget->chars) && (text[i] != '\0'))
+    {
+        widget->text[i] = text[i];
+        i++;
+    }
+    while (i < widget->chars)
+    {
+        widget->text[i++] = ' ';
+    }
+}
+
+void SSD1306_widgetInvalidate (SSD1306_WidgetHandle_t widget)
+{
+    widget->isDrawn = FALSE;
+}
+
+bool SSD1306_widgetUpdate (SSD1306_WidgetHandle_t widget)
+{
+    bool isChanged = FALSE;
+
+    switch (widget->type)
+    {
+    case SSD1306_WIDGETTYPE_LABEL:
+    case SSD1306_WIDGETTYPE_NUMBER:
+        if (!widget->isDrawn)
+        {
+            // No char can be equal to the shown ones
+            memset(widget->shown, 0, sizeof(widget->shown));
+        }
+        isChanged = updateText(widget);
+        break;
+    case SSD1306_WIDGETTYPE_PROGRESS:
+        isChanged = updateProgress(widget);
+        break;
+    case SSD1306_WIDGETTYPE_GAUGE:
+        isChanged = updateGauge(widget);
+        break;
+    case SSD1306_WIDGETTYPE_ICON:
+        isChanged = updateIcon(widget);
+        break;
+    default:
+        ohiassert(0);
+        break;
+    }
+
+    widget->isDrawn = TRUE;
+    return isChanged;
+}
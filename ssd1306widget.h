@@ -0,0 +1,233 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef __WARCOMEB_SSD1306_WIDGET_H
+#define __WARCOMEB_SSD1306_WIDGET_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ssd1306.h"
+
+/*!
+ * \defgroup SSD1306_Widget
+ * \ingroup SSD1306
+ * \{
+ */
+
+#define SSD1306_WIDGET_CHAR_WIDTH                GDL_DEFAULT_FONT_WIDTH
+#define SSD1306_WIDGET_CHAR_HEIGHT               8
+#define SSD1306_WIDGET_MAX_CHARS                 (SSD1306_MAX_DISPLAY_WIDTH/SSD1306_WIDGET_CHAR_WIDTH)
+
+/*!
+ * List of possible widget types
+ */
+typedef enum _SSD1306_WidgetType_t
+{
+    SSD1306_WIDGETTYPE_LABEL,
+    SSD1306_WIDGETTYPE_NUMBER,
+    SSD1306_WIDGETTYPE_PROGRESS,
+    SSD1306_WIDGETTYPE_GAUGE,
+    SSD1306_WIDGETTYPE_ICON,
+} SSD1306_WidgetType_t;
+
+/*!
+ * SSD1306 widget class.
+ * Every widget remembers its bounding box and what is drawn, so a new value
+ * is drawn and sent to the display only when the visible content changes,
+ * and only for the changed part.
+ */
+typedef struct _SSD1306_Widget_t
+{
+    SSD1306_DeviceHandle_t dev;
+
+    SSD1306_WidgetType_t type;
+
+    uint8_t xPos;                /*!< Bounding box: x position */
+    uint8_t yPos;                /*!< Bounding box: y position */
+    uint8_t width;               /*!< Bounding box: width */
+    uint8_t height;              /*!< Bounding box: height */
+
+    int32_t value;               /*!< Current value */
+    int32_t minimum;             /*!< Minimum value for progress bar and gauge */
+    int32_t maximum;             /*!< Maximum value for progress bar and gauge */
+
+    bool isDrawn;                /*!< The widget is drawn into the buffer */
+
+    uint8_t chars;               /*!< Chars of label or number */
+    char text [SSD1306_WIDGET_MAX_CHARS];     /*!< Chars to be shown */
+    char shown [SSD1306_WIDGET_MAX_CHARS];    /*!< Chars drawn into the buffer */
+
+    uint8_t level;               /*!< Drawn level: bar width, needle angle or icon */
+    uint8_t xNeedle;             /*!< Drawn needle end point: x position */
+    uint8_t yNeedle;             /*!< Drawn needle end point: y position */
+
+    const uint8_t* const* icons; /*!< Icon set, page-major bitmaps */
+    uint8_t iconCount;
+
+} SSD1306_Widget_t, *SSD1306_WidgetHandle_t;
+
+/*!
+ * The function initialize a text label, drawn with the default font.
+ *
+ * \param[in] widget: The handle of the widget.
+ * \param[in]    dev: The handle of the device.
+ * \param[in]   xPos: The x position.
+ * \param[in]   yPos: The y position.
+ * \param[in]  chars: The maximum number of chars.
+ */
+void SSD1306_widgetLabel (SSD1306_WidgetHandle_t widget,
+                          SSD1306_DeviceHandle_t dev,
+                          uint8_t xPos,
+                          uint8_t yPos,
+                          uint8_t chars);
+
+/*!
+ * The function initialize a numeric field, right aligned and drawn with the
+ * default font.
+ *
+ * \param[in] widget: The handle of the widget.
+ * \param[in]    dev: The handle of the device.
+ * \param[in]   xPos: The x position.
+ * \param[in]   yPos: The y position.
+ * \param[in]  chars: The number of chars, sign included, at least one.
+ */
+void SSD1306_widgetNumber (SSD1306_WidgetHandle_t widget,
+                           SSD1306_DeviceHandle_t dev,
+                           uint8_t xPos,
+                           uint8_t yPos,
+                           uint8_t chars);
+
+/*!
+ * The function initialize a horizontal progress bar with a frame.
+ *
+ * \param[in]  widget: The handle of the widget.
+ * \param[in]     dev: The handle of the device.
+ * \param[in]    xPos: The x position.
+ * \param[in]    yPos: The y position.
+ * \param[in]   width: The width of the bar.
+ * \param[in]  height: The height of the bar.
+ * \param[in] minimum: The value of the empty bar.
+ * \param[in] maximum: The value of the full bar.
+ */
+void SSD1306_widgetProgress (SSD1306_WidgetHandle_t widget,
+                             SSD1306_DeviceHandle_t dev,
+                             uint8_t xPos,
+                             uint8_t yPos,
+                             uint8_t width,
+                             uint8_t height,
+                             int32_t minimum,
+                             int32_t maximum);
+
+/*!
+ * The function initialize a half circle gauge with a needle.
+ * The bounding box is (2 * radius + 1) x (radius + 1) pixels, and the needle
+ * moves from left (minimum) to right (maximum).
+ *
+ * \param[in]  widget: The handle of the widget.
+ * \param[in]     dev: The handle of the device.
+ * \param[in]    xPos: The x position of the bounding box.
+ * \param[in]    yPos: The y position of the bounding box.
+ * \param[in]  radius: The radius of the gauge.
+ * \param[in] minimum: The value of the needle on the left.
+ * \param[in] maximum: The value of the needle on the right.
+ */
+void SSD1306_widgetGauge (SSD1306_WidgetHandle_t widget,
+                          SSD1306_DeviceHandle_t dev,
+                          uint8_t xPos,
+                          uint8_t yPos,
+                          uint8_t radius,
+                          int32_t minimum,
+                          int32_t maximum);
+
+/*!
+ * The function initialize an icon, chosen by the value from a set of icons.
+ *
+ * \param[in]    widget: The handle of the widget.
+ * \param[in]       dev: The handle of the device.
+ * \param[in]      xPos: The x position.
+ * \param[in]      yPos: The y position.
+ * \param[in]     width: The width of every icon.
+ * \param[in]    height: The height of every icon.
+ * \param[in]     icons: The icon set. Every icon is page-major: one byte for
+ *                       each column of the first 8 lines, then the next 8 lines.
+ * \param[in] iconCount: The number of icons.
+ */
+void SSD1306_widgetIcon (SSD1306_WidgetHandle_t widget,
+                         SSD1306_DeviceHandle_t dev,
+                         uint8_t xPos,
+                         uint8_t yPos,
+                         uint8_t width,
+                         uint8_t height,
+                         const uint8_t* const* icons,
+                         uint8_t iconCount);
+
+/*!
+ * The function sets the value of a numeric field, progress bar, gauge or
+ * icon. Nothing is drawn until \ref SSD1306_widgetUpdate.
+ *
+ * \param[in] widget: The handle of the widget.
+ * \param[in]  value: The new value.
+ */
+void SSD1306_widgetSetValue (SSD1306_WidgetHandle_t widget, int32_t value);
+
+/*!
+ * The function sets the text of a label. The text is cut to the label
+ * dimension. Nothing is drawn until \ref SSD1306_widgetUpdate.
+ *
+ * \param[in] widget: The handle of the widget.
+ * \param[in]   text: The new text.
+ */
+void SSD1306_widgetSetText (SSD1306_WidgetHandle_t widget, const char* text);
+
+/*!
+ * The function forces a complete redraw at the next update, for example
+ * after the display was cleared.
+ *
+ * \param[in] widget: The handle of the widget.
+ */
+void SSD1306_widgetInvalidate (SSD1306_WidgetHandle_t widget);
+
+/*!
+ * The function draws the changed part of the widget, and sends only that
+ * part to the display with \ref SSD1306_flushArea.
+ *
+ * \param[in] widget: The handle of the widget.
+ * \return TRUE when something was drawn, FALSE when nothing was changed.
+ */
+bool SSD1306_widgetUpdate (SSD1306_WidgetHandle_t widget);
+
+/*!
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __WARCOMEB_SSD1306_WIDGET_H
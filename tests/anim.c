@@ -0,0 +1,399 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+/*!
+ * \file  /tests/anim.c
+ * \brief Converter and benchmark of the delta-encoded animations.
+ *
+ * With a file, the program converts the frames to an animation, written as C
+ * source:
+ *
+ *     ssd1306-anim <frames.pbm> <frame count> <name> <output.c>
+ *
+ * The file is a binary PBM (P4) with the frames one under the other. Then,
+ * or without arguments with a built-in spinner, the animation is played on
+ * the simulated controller: every frame on the display is compared with the
+ * source one, and the flash size, the bus usage and the CPU time are
+ * compared with full frames drawn with SSD1306_drawPicture and
+ * SSD1306_flush.
+ */
+
+#include "harness.h"
+#include "reference.h"
+#include "ssd1306anim.h"
+
+#include <stdlib.h>
+#include <math.h>
+
+#define ANIM_MAX_FRAMES                          256
+#define ANIM_MAX_SIZE                            SSD1306_BUFFER_DIMENSION
+#define ANIM_LOOPS                               3
+
+#define ANIM_SPINNER_SIDE                        32
+#define ANIM_SPINNER_FRAMES                      12
+
+static SSD1306_Device_t mDevice;
+static uint8_t mFrames [ANIM_MAX_FRAMES * ANIM_MAX_SIZE];
+static uint8_t mDeltas [ANIM_MAX_FRAMES * (ANIM_MAX_SIZE + 8)];
+
+/*!
+ * The function returns a pixel of a page-major frame.
+ */
+static bool getPixel (const uint8_t* frame, uint8_t width, uint8_t xPos, uint8_t yPos)
+{
+    return (frame[(yPos / 8) * width + xPos] >> (yPos % 8)) & 0x01;
+}
+
+/*!
+ * The function draws the built-in spinner: a dot that turns around a ring.
+ */
+static void drawSpinner (uint8_t* width, uint8_t* height, uint16_t* count)
+{
+    static Reference_Screen_t screen;
+    uint16_t size = ANIM_SPINNER_SIDE * ANIM_SPINNER_SIDE / 8;
+
+    *width  = ANIM_SPINNER_SIDE;
+    *height = ANIM_SPINNER_SIDE;
+    *count  = ANIM_SPINNER_FRAMES;
+
+    for (uint16_t frame = 0; frame < ANIM_SPINNER_FRAMES; ++frame)
+    {
+        double angle = 2.0 * 3.14159265358979 * frame / ANIM_SPINNER_FRAMES;
+        int32_t x = 16 + (int32_t)lround(11 * cos(angle));
+        int32_t y = 16 + (int32_t)lround(11 * sin(angle));
+
+        Reference_init(&screen, ANIM_SPINNER_SIDE, ANIM_SPINNER_SIDE);
+        Reference_fillEllipse(&screen, 16, 16, 14, 14, TRUE);
+        Reference_fillEllipse(&screen, 16, 16, 12, 12, FALSE);
+        Reference_fillEllipse(&screen, x, y, 4, 4, TRUE);
+        Reference_fillEllipse(&screen, x, y, 2, 2, FALSE);
+
+        uint8_t* data = &mFrames[frame * size];
+        memset(data, 0, size);
+        for (int32_t py = 0; py < ANIM_SPINNER_SIDE; ++py)
+            for (int32_t px = 0; px < ANIM_SPINNER_SIDE; ++px)
+                if (screen.pixels[py][px])
+                    data[(py / 8) * ANIM_SPINNER_SIDE + px] |= 1u << (py % 8);
+    }
+}
+
+/*!
+ * The function reads the frames from a binary PBM file.
+ */
+static bool readFrames (const char* name, uint16_t count, uint8_t* width, uint8_t* height)
+{
+    FILE* file = fopen(name, "rb");
+    unsigned w = 0, h = 0;
+
+    if ((file == NULL) || (fscanf(file, "P4 %u %u", &w, &h) != 2) || (fgetc(file) == EOF) ||
+        (count == 0) || (count > ANIM_MAX_FRAMES) || ((h % count) != 0) ||
+        (w == 0) || (w > SSD1306_MAX_DISPLAY_WIDTH) || ((h / count) > SSD1306_MAX_DISPLAY_HEIGHT))
+    {
+        fprintf(stderr, "%s: not a P4 file with %u frames of 128x64 at most\n", name, count);
+        if (file != NULL) fclose(file);
+        return FALSE;
+    }
+
+    *width  = w;
+    *height = h / count;
+    uint16_t size   = (uint16_t)w * ((*height + 7) / 8);
+    uint16_t stride = (w + 7) / 8;
+    uint8_t row [SSD1306_MAX_DISPLAY_WIDTH / 8];
+
+    memset(mFrames, 0, (uint32_t)count * size);
+    for (uint32_t line = 0; line < h; ++line)
+    {
+        if (fread(row, 1, stride, file) != stride)
+        {
+            fprintf(stderr, "%s: truncated file\n", name);
+            fclose(file);
+            return FALSE;
+        }
+
+        // From row-major, most significant bit on the left, to page-major
+        uint8_t* frame = &mFrames[(line / *height) * size];
+        uint8_t y = line % *height;
+        for (uint8_t x = 0; x < w; ++x)
+            if ((row[x / 8] >> (7 - (x % 8))) & 0x01)
+                frame[(y / 8) * w + x] |= 1u << (y % 8);
+    }
+    fclose(file);
+    return TRUE;
+}
+
+static void writeArray (FILE* file, const char* name, const uint8_t* data, uint32_t length)
+{
+    fprintf(file, "static const uint8_t %s [%u] =\n{", name, (unsigned)length);
+    for (uint32_t i = 0; i < length; ++i)
+        fprintf(file, "%s0x%02X,", ((i % 12) == 0) ? "\n    " : " ", data[i]);
+    fprintf(file, "\n};\n\n");
+}
+
+static bool writeAnimation (const char* fileName, const char* name,
+                            const SSD1306_Animation_t* animation, uint32_t deltas)
+{
+    FILE* file = fopen(fileName, "w");
+    char array [96];
+
+    if (file == NULL)
+    {
+        fprintf(stderr, "%s: cannot be written\n", fileName);
+        return FALSE;
+    }
+
+    fprintf(file, "#include \"ssd1306anim.h\"\n\n");
+    snprintf(array, sizeof(array), "%sKeyframe", name);
+    writeArray(file, array, animation->keyframe, (uint32_t)animation->width * ((animation->height + 7) / 8));
+    snprintf(array, sizeof(array), "%sDeltas", name);
+    writeArray(file, array, animation->deltas, deltas);
+
+    fprintf(file, "const SSD1306_Animation_t %s =\n{\n", name);
+    fprintf(file, "    .width      = %u,\n", animation->width);
+    fprintf(file, "    .height     = %u,\n", animation->height);
+    fprintf(file, "    .frameCount = %u,\n", animation->frameCount);
+    fprintf(file, "    .keyframe   = %sKeyframe,\n", name);
+    fprintf(file, "    .deltas     = %sDeltas,\n", name);
+    fprintf(file, "};\n");
+    fclose(file);
+    return TRUE;
+}
+
+/*!
+ * The function checks that the display shows a frame of the animation.
+ */
+static void checkFrame (const SSD1306_Animation_t* animation, uint16_t frame, uint16_t xPos, uint16_t yPos)
+{
+    const uint8_t* data = &mFrames[(uint32_t)frame * animation->width * ((animation->height + 7) / 8)];
+
+    TEST_CHECK(Simulator_get()->errors == 0, "frame %u: transactions rejected", frame);
+    for (uint8_t y = 0; y < animation->height; ++y)
+    {
+        for (uint8_t x = 0; x < animation->width; ++x)
+        {
+            // The part out of the display is not drawn
+            if (((xPos + x) >= mDevice.gdl.width) || ((yPos + y) >= mDevice.gdl.height))
+                continue;
+
+            if (Simulator_getPixel(xPos + x, yPos + y) != getPixel(data, animation->width, x, y))
+            {
+                TEST_CHECK(FALSE, "frame %u: display pixel %u,%u", frame, xPos + x, yPos + y);
+                return;
+            }
+        }
+    }
+}
+
+/*!
+ * The function checks that nothing is drawn out of the animation area.
+ */
+static void checkOutside (uint16_t xPos, uint16_t yPos, const char* name)
+{
+    for (uint8_t y = 0; y < mDevice.gdl.height; ++y)
+    {
+        for (uint8_t x = 0; x < mDevice.gdl.width; ++x)
+        {
+            if (((x >= xPos) && (y >= yPos)) || !Test_getBufferPixel(&mDevice, x, y))
+                continue;
+
+            TEST_CHECK(FALSE, "%s: pixel %u,%u out of the animation", name, x, y);
+            return;
+        }
+    }
+}
+
+/*!
+ * The function plays the animation partly out of the display, where the
+ * columns must be clipped and never wrapped, and then with the flush
+ * governor, that must send the frames.
+ */
+static void testPlayer (const SSD1306_Animation_t* animation)
+{
+    SSD1306_AnimationPlayer_t player;
+    static const uint8_t positions [][2] = { { 110, 50 }, { 127, 0 }, { 200, 10 }, { 10, 240 } };
+
+    for (uint8_t i = 0; i < (sizeof(positions) / sizeof(positions[0])); ++i)
+    {
+        uint8_t xPos = positions[i][0], yPos = positions[i][1];
+        Test_initDevice(&mDevice, SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1);
+        SSD1306_flush(&mDevice);
+
+        SSD1306_animationInit(&player, &mDevice, animation, xPos, yPos, 25, TRUE);
+        SSD1306_animationStart(&player);
+        for (uint32_t frame = 1; frame <= (2u * animation->frameCount); ++frame)
+        {
+            Simulator_advance(player.frameTime);
+            SSD1306_animationProcess(&player);
+            checkFrame(animation, frame % animation->frameCount, xPos, yPos);
+            checkOutside(xPos, yPos, "clipped player");
+        }
+    }
+
+    // The governor sends at 10 fps, the animation runs at 25 fps
+    Test_initDevice(&mDevice, SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1);
+    SSD1306_setFrameRate(&mDevice, 10, 10);
+    SSD1306_animationInit(&player, &mDevice, animation, 40, 20, 25, TRUE);
+    SSD1306_animationStart(&player);
+    SSD1306_forceFlush(&mDevice);
+
+    uint32_t sent = 0;
+    for (uint32_t frame = 1; frame <= (2u * animation->frameCount); ++frame)
+    {
+        Simulator_resetCounters();
+        Simulator_advance(player.frameTime);
+        SSD1306_animationProcess(&player);
+        TEST_CHECK(Simulator_get()->transactions == 0, "governed player: frame %u sent at once", frame);
+
+        if (SSD1306_processFlush(&mDevice))
+        {
+            sent++;
+            checkFrame(animation, frame % animation->frameCount, 40, 20);
+        }
+    }
+    uint32_t expected = (2u * animation->frameCount * player.frameTime) / 100;
+    TEST_CHECK((sent + 1 >= expected) && (sent <= expected), "governed player: %u frames sent, %u expected",
+               sent, expected);
+}
+
+/*!
+ * The function plays the animation with the delta player, and with full
+ * frames, and prints the comparison.
+ */
+static void benchmark (const SSD1306_Animation_t* animation, uint32_t deltas, bool isBuiltIn)
+{
+    SSD1306_AnimationPlayer_t player;
+    uint32_t frames = (uint32_t)animation->frameCount * ANIM_LOOPS;
+    uint32_t frameSize = (uint32_t)animation->width * ((animation->height + 7) / 8);
+    uint32_t bitmapSize = (uint32_t)((animation->width + 7) / 8) * animation->height;
+
+    // Not aligned to the pages, with the start line moved
+    uint8_t xPos = (SSD1306_MAX_DISPLAY_WIDTH - animation->width) / 2;
+    uint8_t yPos = (animation->height <= 51) ? 13 : 0;
+    Test_initDevice(&mDevice, SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1);
+    SSD1306_scrollLines(&mDevice, 21);
+    SSD1306_flush(&mDevice);
+
+    SSD1306_animationInit(&player, &mDevice, animation, xPos, yPos, 25, TRUE);
+    SSD1306_animationStart(&player);
+    checkFrame(animation, 0, xPos, yPos);
+
+    uint32_t start = Test_startScenario(&mDevice);
+    uint32_t worst = 0;
+    for (uint32_t i = 1; i <= frames; ++i)
+    {
+        uint32_t before = mDevice.statistics.commandBytes + mDevice.statistics.dataBytes;
+        Simulator_advance(player.frameTime);
+        TEST_CHECK(SSD1306_animationProcess(&player), "frame %u: the player stopped", (unsigned)i);
+        checkFrame(animation, i % animation->frameCount, xPos, yPos);
+
+        uint32_t bytes = mDevice.statistics.commandBytes + mDevice.statistics.dataBytes - before;
+        if (bytes > worst) worst = bytes;
+    }
+    uint32_t deltaTime = Test_now() - start;
+    SSD1306_Statistics_t delta = mDevice.statistics;
+    Test_Budget_t budget = { "delta player", 0, 0, 0 };
+
+    // Full frames, from row-major bitmaps
+    static uint8_t bitmap [SSD1306_BUFFER_DIMENSION];
+    start = Test_startScenario(&mDevice);
+    for (uint32_t i = 1; i <= frames; ++i)
+    {
+        const uint8_t* data = &mFrames[(i % animation->frameCount) * frameSize];
+        memset(bitmap, 0, bitmapSize);
+        for (uint8_t y = 0; y < animation->height; ++y)
+            for (uint8_t x = 0; x < animation->width; ++x)
+                if (getPixel(data, animation->width, x, y))
+                    bitmap[y * ((animation->width + 7) / 8) + x / 8] |= 0x80 >> (x % 8);
+        SSD1306_drawPicture(&mDevice, xPos, yPos, animation->width, animation->height, bitmap);
+        SSD1306_flush(&mDevice);
+        checkFrame(animation, i % animation->frameCount, xPos, yPos);
+    }
+    uint32_t fullTime = Test_now() - start;
+    SSD1306_Statistics_t full = mDevice.statistics;
+
+    printf("%ux%u, %u frames\n", animation->width, animation->height, animation->frameCount);
+    printf("                  flash   transactions/frame   bytes/frame   us/frame\n");
+    printf("full frames    %8u   %18.1f   %11.1f   %8.2f\n",
+            (unsigned)(bitmapSize * animation->frameCount), (double)full.transactions / frames,
+            (double)(full.commandBytes + full.dataBytes) / frames, (double)fullTime / frames);
+    printf("delta player   %8u   %18.1f   %11.1f   %8.2f\n",
+            (unsigned)(frameSize + deltas), (double)delta.transactions / frames,
+            (double)(delta.commandBytes + delta.dataBytes) / frames, (double)deltaTime / frames);
+    printf("worst delta frame: %u bytes\n", (unsigned)worst);
+
+    // The built-in spinner has budgets: the bytes of the worst frame and
+    // the totals of the player
+    if (isBuiltIn)
+    {
+        budget.transactions = 4 * frames;
+        budget.bytes        = 60 * frames;
+        budget.microseconds = 20 * frames;
+        mDevice.statistics  = delta;
+        Simulator_get()->transactions = delta.transactions;
+        Simulator_get()->commandBytes = delta.commandBytes;
+        Simulator_get()->dataBytes    = delta.dataBytes;
+        Test_checkBudget(&budget, &mDevice, Test_now() - deltaTime);
+        TEST_CHECK(worst <= 80, "worst delta frame %u bytes, budget 80", (unsigned)worst);
+        TEST_CHECK((frameSize + deltas) < (bitmapSize * animation->frameCount),
+                   "animation %u bytes, full frames %u", (unsigned)(frameSize + deltas),
+                   (unsigned)(bitmapSize * animation->frameCount));
+    }
+}
+
+int main (int argc, char** argv)
+{
+    SSD1306_Animation_t animation;
+    bool isBuiltIn = (argc < 5);
+
+    if (isBuiltIn)
+    {
+        drawSpinner(&animation.width, &animation.height, &animation.frameCount);
+    }
+    else
+    {
+        animation.frameCount = (uint16_t)atoi(argv[2]);
+        if (!readFrames(argv[1], animation.frameCount, &animation.width, &animation.height))
+            return 2;
+    }
+
+    uint32_t deltas = SSD1306_encodeAnimation(mFrames, animation.frameCount, animation.width,
+                                              animation.height, mDeltas, sizeof(mDeltas));
+    if (deltas == 0)
+    {
+        fprintf(stderr, "the animation cannot be encoded\n");
+        return 2;
+    }
+    animation.keyframe = mFrames;
+    animation.deltas   = mDeltas;
+
+    if (!isBuiltIn && !writeAnimation(argv[4], argv[3], &animation, deltas))
+        return 2;
+
+    if (isBuiltIn)
+        testPlayer(&animation);
+    benchmark(&animation, deltas, isBuiltIn);
+    return Test_end("anim");
+}
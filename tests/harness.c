@@ -0,0 +1,161 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+/*!
+ * \file  /tests/harness.c
+ * \brief Checks, random numbers, timing and budgets of the host tests.
+ */
+
+#include "harness.h"
+
+#include <stdarg.h>
+#include <time.h>
+
+#define TEST_MAX_PRINTED_FAILURES                20
+
+static uint32_t mFailures = 0;
+static uint32_t mRandom = 1;
+
+void Test_fail (const char* file, int line, const char* format, ...)
+{
+    mFailures++;
+    if (mFailures > TEST_MAX_PRINTED_FAILURES)
+        return;
+
+    va_list args;
+    va_start(args, format);
+    fprintf(stderr, "%s:%d: ", file, line);
+    vfprintf(stderr, format, args);
+    fprintf(stderr, "\n");
+    va_end(args);
+}
+
+uint32_t Test_getFailures (void)
+{
+    return mFailures;
+}
+
+int Test_end (const char* name)
+{
+    if (mFailures > 0)
+    {
+        printf("%s: FAILED, %u failures\n", name, (unsigned)mFailures);
+        return 1;
+    }
+    printf("%s: PASSED\n", name);
+    return 0;
+}
+
+void Test_seed (uint32_t seed)
+{
+    mRandom = (seed != 0) ? seed : 1;
+}
+
+uint32_t Test_random (void)
+{
+    // Xorshift, the same sequence on every host
+    mRandom ^= mRandom << 13;
+    mRandom ^= mRandom >> 17;
+    mRandom ^= mRandom << 5;
+    return mRandom;
+}
+
+int32_t Test_range (int32_t minimum, int32_t maximum)
+{
+    return minimum + (int32_t)(Test_random() % (uint32_t)(maximum - minimum + 1));
+}
+
+uint32_t Test_now (void)
+{
+    return (uint32_t)(((uint64_t)clock() * 1000000u) / CLOCKS_PER_SEC);
+}
+
+void Test_initDevice (SSD1306_DeviceHandle_t dev, uint16_t product)
+{
+    // Any handle: the simulated bus has a single controller
+    static int bus;
+    SSD1306_Config_t config;
+
+    memset(&config, 0, sizeof(config));
+    config.product = product;
+    config.iicDev  = (Iic_DeviceHandle)&bus;
+
+    Simulator_reset();
+    SSD1306_init(dev, &config);
+    SSD1306_resetStatistics(dev);
+    Simulator_resetCounters();
+}
+
+bool Test_getBufferPixel (SSD1306_DeviceHandle_t dev, uint8_t xPos, uint8_t yPos)
+{
+    uint8_t row = (yPos + dev->startLine) & (SIMULATOR_ROWS - 1);
+    return (dev->buffer[(row / 8) * dev->gdl.width + xPos] >> (row % 8)) & 0x01;
+}
+
+uint32_t Test_startScenario (SSD1306_DeviceHandle_t dev)
+{
+    SSD1306_resetStatistics(dev);
+    Simulator_resetCounters();
+    return Test_now();
+}
+
+void Test_checkBudget (const Test_Budget_t* budget,
+                       SSD1306_DeviceHandle_t dev,
+                       uint32_t start)
+{
+    uint32_t elapsed = Test_now() - start;
+    const SSD1306_Statistics_t* statistics = &dev->statistics;
+    const Simulator_Controller_t* bus = Simulator_get();
+    uint32_t bytes = statistics->commandBytes + statistics->dataBytes;
+
+    // The CPU time depends on the host and on its load: it is only reported
+    printf("%-32s %6u/%-6u transactions %7u/%-7u bytes %8u/%-8u us%s\n",
+           budget->name,
+           (unsigned)statistics->transactions, (unsigned)budget->transactions,
+           (unsigned)bytes, (unsigned)budget->bytes,
+           (unsigned)elapsed, (unsigned)budget->microseconds,
+           (elapsed > budget->microseconds) ? " (slow)" : "");
+
+    // The statistics must describe what the controller received
+    TEST_CHECK(statistics->transactions == bus->transactions,
+               "%s: %u transactions counted, %u on the bus",
+               budget->name, (unsigned)statistics->transactions, (unsigned)bus->transactions);
+    TEST_CHECK(statistics->commandBytes == bus->commandBytes,
+               "%s: %u command bytes counted, %u on the bus",
+               budget->name, (unsigned)statistics->commandBytes, (unsigned)bus->commandBytes);
+    TEST_CHECK(statistics->dataBytes == bus->dataBytes,
+               "%s: %u data bytes counted, %u on the bus",
+               budget->name, (unsigned)statistics->dataBytes, (unsigned)bus->dataBytes);
+    TEST_CHECK(bus->errors == 0, "%s: %u transactions rejected by the controller",
+               budget->name, (unsigned)bus->errors);
+
+    TEST_CHECK(statistics->transactions <= budget->transactions,
+               "%s: %u transactions, budget %u",
+               budget->name, (unsigned)statistics->transactions, (unsigned)budget->transactions);
+    TEST_CHECK(bytes <= budget->bytes, "%s: %u bytes, budget %u",
+               budget->name, (unsigned)bytes, (unsigned)budget->bytes);
+}
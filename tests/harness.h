@@ -0,0 +1,151 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+/*!
+ * \file  /tests/harness.h
+ * \brief Checks, random numbers, timing and budgets of the host tests.
+ */
+
+#ifndef __WARCOMEB_SSD1306_TESTS_HARNESS_H
+#define __WARCOMEB_SSD1306_TESTS_HARNESS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+
+#include "ssd1306.h"
+#include "simulator.h"
+
+/*!
+ * The macro checks a condition: when it is false, the message is printed and
+ * the test fails, but it goes on.
+ */
+#define TEST_CHECK(condition, ...)                                           \
+    do                                                                       \
+    {                                                                        \
+        if (!(condition))                                                    \
+        {                                                                    \
+            Test_fail(__FILE__, __LINE__, __VA_ARGS__);                      \
+        }                                                                    \
+    } while (0)
+
+/*!
+ * Budget of a scenario: every field is the maximum allowed value. The CPU
+ * time is only reported, because it depends on the host and on its load.
+ */
+typedef struct _Test_Budget_t
+{
+    const char* name;
+    uint32_t transactions;       /*!< Bus transactions */
+    uint32_t bytes;              /*!< Command and data bytes */
+    uint32_t microseconds;       /*!< CPU time */
+} Test_Budget_t;
+
+/*!
+ * The function records a failure, with a printf-like message.
+ */
+void Test_fail (const char* file, int line, const char* format, ...);
+
+/*!
+ * The function returns the number of failures.
+ */
+uint32_t Test_getFailures (void);
+
+/*!
+ * The function prints the result of the test.
+ *
+ * \param[in] name: The name of the test
+ * \return The exit status of the program.
+ */
+int Test_end (const char* name);
+
+/*!
+ * The function sets the seed of the random generator, so every run of a
+ * test draws the same scenarios.
+ */
+void Test_seed (uint32_t seed);
+
+/*!
+ * The function returns a random number.
+ */
+uint32_t Test_random (void);
+
+/*!
+ * The function returns a random number from minimum to maximum, both included.
+ */
+int32_t Test_range (int32_t minimum, int32_t maximum);
+
+/*!
+ * The function returns the CPU time, in microseconds.
+ */
+uint32_t Test_now (void);
+
+/*!
+ * The function initializes a device connected to the simulated controller.
+ * The controller is reset and the bus statistics are cleared.
+ *
+ * \param[in]     dev: The handle of the device
+ * \param[in] product: The product
+ */
+void Test_initDevice (SSD1306_DeviceHandle_t dev, uint16_t product);
+
+/*!
+ * The function reads a pixel from the internal buffer of the device,
+ * following the layout of the display RAM.
+ */
+bool Test_getBufferPixel (SSD1306_DeviceHandle_t dev, uint8_t xPos, uint8_t yPos);
+
+/*!
+ * The function starts a scenario with a budget: the statistics of the device
+ * and the bus counters of the simulated controller are cleared.
+ *
+ * \param[in] dev: The handle of the device
+ * \return The CPU time at the start of the scenario.
+ */
+uint32_t Test_startScenario (SSD1306_DeviceHandle_t dev);
+
+/*!
+ * The function checks the statistics of a scenario against its budget, and
+ * against the bus counters of the simulated controller. The result is
+ * printed, and the test fails when a bus budget is exceeded: a CPU time over
+ * its budget is marked as slow, without failing.
+ *
+ * \param[in] budget: The budget of the scenario
+ * \param[in]    dev: The handle of the device
+ * \param[in]  start: The CPU time at the start of the scenario
+ */
+void Test_checkBudget (const Test_Budget_t* budget,
+                       SSD1306_DeviceHandle_t dev,
+                       uint32_t start);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __WARCOMEB_SSD1306_TESTS_HARNESS_H
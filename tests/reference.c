@@ -0,0 +1,459 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+/*!
+ * \file  /tests/reference.c
+ * \brief Reference rasterizers, one pixel at time.
+ */
+
+#include "reference.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+void Reference_init (Reference_Screen_t* screen, int32_t width, int32_t height)
+{
+    memset(screen, 0, sizeof(Reference_Screen_t));
+    screen->width  = width;
+    screen->height = height;
+    Reference_setClip(screen, 0, 0, width, height);
+}
+
+void Reference_setClip (Reference_Screen_t* screen,
+                        int32_t xStart,
+                        int32_t yStart,
+                        int32_t xStop,
+                        int32_t yStop)
+{
+    screen->xStart = xStart;
+    screen->yStart = yStart;
+    screen->xStop  = xStop;
+    screen->yStop  = yStop;
+}
+
+void Reference_drawPixel (Reference_Screen_t* screen, int32_t xPos, int32_t yPos, bool color)
+{
+    if ((xPos < screen->xStart) || (xPos >= screen->xStop) ||
+        (yPos < screen->yStart) || (yPos >= screen->yStop))
+        return;
+
+    screen->pixels[yPos][xPos] = color;
+}
+
+bool Reference_getPixel (const Reference_Screen_t* screen, int32_t xPos, int32_t yPos)
+{
+    if ((xPos < 0) || (xPos >= screen->width) || (yPos < 0) || (yPos >= screen->height))
+        return FALSE;
+
+    return screen->pixels[yPos][xPos];
+}
+
+void Reference_fillRectangle (Reference_Screen_t* screen,
+                              int32_t xPos,
+                              int32_t yPos,
+                              int32_t width,
+                              int32_t height,
+                              bool color)
+{
+    for (int32_t y = yPos; y < (yPos + height); ++y)
+    {
+        for (int32_t x = xPos; x < (xPos + width); ++x)
+        {
+            Reference_drawPixel(screen, x, y, color);
+        }
+    }
+}
+
+void Reference_drawRectangle (Reference_Screen_t* screen,
+                              int32_t xPos,
+                              int32_t yPos,
+                              int32_t width,
+                              int32_t height,
+                              bool color)
+{
+    for (int32_t y = yPos; y < (yPos + height); ++y)
+    {
+        for (int32_t x = xPos; x < (xPos + width); ++x)
+        {
+            if ((x == xPos) || (x == (xPos + width - 1)) ||
+                (y == yPos) || (y == (yPos + height - 1)))
+            {
+                Reference_drawPixel(screen, x, y, color);
+            }
+        }
+    }
+}
+
+void Reference_drawLine (Reference_Screen_t* screen,
+                         int32_t xStart,
+                         int32_t yStart,
+                         int32_t xStop,
+                         int32_t yStop,
+                         bool color)
+{
+    int32_t dx = abs(xStop - xStart);
+    int32_t dy = -abs(yStop - yStart);
+    int32_t sx = (xStart < xStop) ? 1 : -1;
+    int32_t sy = (yStart < yStop) ? 1 : -1;
+    int32_t error = dx + dy;
+
+    for (;;)
+    {
+        Reference_drawPixel(screen, xStart, yStart, color);
+        if ((xStart == xStop) && (yStart == yStop)) break;
+
+        int32_t e2 = 2 * error;
+        if (e2 >= dy)
+        {
+            error  += dy;
+            xStart += sx;
+        }
+        if (e2 <= dx)
+        {
+            error  += dx;
+            yStart += sy;
+        }
+    }
+}
+
+void Reference_writeColumn (Reference_Screen_t* screen,
+                            int32_t xPos,
+                            int32_t yPos,
+                            uint8_t bits,
+                            uint8_t mask)
+{
+    for (int32_t i = 0; i < 8; ++i)
+    {
+        if ((mask >> i) & 0x01)
+        {
+            Reference_drawPixel(screen, xPos, yPos + i, (bits >> i) & 0x01);
+        }
+    }
+}
+
+void Reference_drawPicture (Reference_Screen_t* screen,
+                            int32_t xPos,
+                            int32_t yPos,
+                            int32_t width,
+                            int32_t height,
+                            const uint8_t* picture)
+{
+    int32_t stride = (width + 7) / 8;
+
+    for (int32_t y = 0; y < height; ++y)
+    {
+        for (int32_t x = 0; x < width; ++x)
+        {
+            bool bit = (picture[y * stride + x / 8] >> (7 - (x % 8))) & 0x01;
+            Reference_drawPixel(screen, xPos + x, yPos + y, bit);
+        }
+    }
+}
+
+void Reference_drawChar (Reference_Screen_t* screen,
+                         int32_t xPos,
+                         int32_t yPos,
+                         char c,
+                         bool color,
+                         uint8_t size)
+{
+    int32_t scale = (size == 0) ? 1 : size;
+
+    for (int32_t y = 0; y < (8 * scale); ++y)
+    {
+        for (int32_t x = 0; x < (6 * scale); ++x)
+        {
+            int32_t column = x / scale;
+            int32_t line   = y / scale;
+            bool isBox = (c != ' ') && (column < 5) && (line < 7) &&
+                         ((column == 0) || (column == 4) || (line == 0) || (line == 6));
+
+            Reference_drawPixel(screen, xPos + x, yPos + y, isBox ? color : !color);
+        }
+    }
+}
+
+int32_t Reference_drawText (Reference_Screen_t* screen,
+                            const SSD1306_Font_t* font,
+                            int32_t xPos,
+                            int32_t yPos,
+                            const uint32_t* codes,
+                            int32_t count,
+                            bool color)
+{
+    int32_t x = xPos;
+
+    for (int32_t i = 0; i < count; ++i)
+    {
+        const SSD1306_FontGlyph_t* glyph = &font->glyphs[font->fallback];
+        for (uint16_t k = 0; k < font->glyphCount; ++k)
+        {
+            if (font->glyphs[k].code == codes[i])
+            {
+                glyph = &font->glyphs[k];
+                break;
+            }
+        }
+
+        for (int32_t column = 0; column < glyph->advance; ++column)
+        {
+            for (int32_t line = 0; line < font->height; ++line)
+            {
+                bool bit = FALSE;
+                if (column < glyph->width)
+                {
+                    uint8_t data = font->bitmaps[glyph->offset + (line / 8) * glyph->width + column];
+                    bit = (data >> (line % 8)) & 0x01;
+                }
+                Reference_drawPixel(screen, x + column, yPos + line, bit ? color : !color);
+            }
+        }
+        x += glyph->advance;
+    }
+    return x - xPos;
+}
+
+void Reference_fillEllipse (Reference_Screen_t* screen,
+                            int32_t xCenter,
+                            int32_t yCenter,
+                            int32_t xRadius,
+                            int32_t yRadius,
+                            bool color)
+{
+    int64_t a = (int64_t)xRadius * xRadius + xRadius;
+    int64_t b = (int64_t)yRadius * yRadius + yRadius;
+
+    for (int32_t dy = -yRadius; dy <= yRadius; ++dy)
+    {
+        for (int32_t dx = -xRadius; dx <= xRadius; ++dx)
+        {
+            if (((int64_t)dx * dx * b + (int64_t)dy * dy * a) <= (a * b))
+            {
+                Reference_drawPixel(screen, xCenter + dx, yCenter + dy, color);
+            }
+        }
+    }
+}
+
+void Reference_fillRoundRectangle (Reference_Screen_t* screen,
+                                   int32_t xPos,
+                                   int32_t yPos,
+                                   int32_t width,
+                                   int32_t height,
+                                   int32_t radius,
+                                   bool color)
+{
+    if ((width <= 0) || (height <= 0))
+        return;
+
+    if (radius > ((width - 1) / 2))  radius = (width - 1) / 2;
+    if (radius > ((height - 1) / 2)) radius = (height - 1) / 2;
+
+    // Only the pixels of the screen are tested
+    int32_t xFirst = (xPos < 0) ? -xPos : 0;
+    int32_t yFirst = (yPos < 0) ? -yPos : 0;
+    int32_t xLast  = (width < (screen->width - xPos)) ? width : (screen->width - xPos);
+    int32_t yLast  = (height < (screen->height - yPos)) ? height : (screen->height - yPos);
+
+    for (int32_t y = yFirst; y < yLast; ++y)
+    {
+        for (int32_t x = xFirst; x < xLast; ++x)
+        {
+            // Distance from the center of the nearest corner, 0 out of the corners
+            int32_t dx = 0;
+            int32_t dy = 0;
+            if (x < radius)                dx = radius - x;
+            if (x > (width - 1 - radius))  dx = x - (width - 1 - radius);
+            if (y < radius)                dy = radius - y;
+            if (y > (height - 1 - radius)) dy = y - (height - 1 - radius);
+
+            if ((dx * dx + dy * dy) <= (radius * radius + radius))
+            {
+                Reference_drawPixel(screen, xPos + x, yPos + y, color);
+            }
+        }
+    }
+}
+
+void Reference_fillPolygon (Reference_Screen_t* screen,
+                            const SSD1306_Point_t* points,
+                            uint8_t count,
+                            bool color)
+{
+    for (int32_t x = 0; x < screen->width; ++x)
+    {
+        bool isCrossed = FALSE;
+        int32_t low  = 0;
+        int32_t high = 0;
+
+        for (uint8_t i = 0; i < count; ++i)
+        {
+            const SSD1306_Point_t* p0 = &points[i];
+            const SSD1306_Point_t* p1 = &points[(i + 1) % count];
+            int32_t xMin = (p0->x < p1->x) ? p0->x : p1->x;
+            int32_t xMax = (p0->x < p1->x) ? p1->x : p0->x;
+
+            if ((x < xMin) || (x > xMax))
+                continue;
+
+            int32_t yA, yB;
+            if (p0->x == p1->x)
+            {
+                // Vertical edge: both its ends cross the column
+                yA = p0->y;
+                yB = p1->y;
+            }
+            else
+            {
+                double y = p0->y + (double)(p1->y - p0->y) * (x - p0->x) / (p1->x - p0->x);
+                yA = (int32_t)floor(y + 0.5);
+                yB = yA;
+            }
+
+            int32_t minimum = (yA < yB) ? yA : yB;
+            int32_t maximum = (yA < yB) ? yB : yA;
+            if (!isCrossed || (minimum < low))  low  = minimum;
+            if (!isCrossed || (maximum > high)) high = maximum;
+            isCrossed = TRUE;
+        }
+
+        for (int32_t y = 0; isCrossed && (y < screen->height); ++y)
+        {
+            if ((y >= low) && (y <= high))
+            {
+                Reference_drawPixel(screen, x, y, color);
+            }
+        }
+    }
+}
+
+/*!
+ * The function returns the entry of the 8x8 Bayer matrix, built from the
+ * bits of the position instead of a table.
+ */
+static int32_t getBayer (int32_t x, int32_t y)
+{
+    int32_t value = 0;
+    for (int32_t bit = 0; bit < 3; ++bit)
+    {
+        value |= (((x ^ y) >> bit) & 0x01) << (2 * (2 - bit) + 1);
+        value |= ((y >> bit) & 0x01) << (2 * (2 - bit));
+    }
+    return value;
+}
+
+void Reference_drawGrayscale (Reference_Screen_t* screen,
+                              int32_t xPos,
+                              int32_t yPos,
+                              int32_t width,
+                              int32_t height,
+                              const uint8_t* picture,
+                              SSD1306_Dither_t dither)
+{
+    static int32_t error [REFERENCE_MAX_HEIGHT + 1][REFERENCE_MAX_WIDTH + 2];
+
+    if ((xPos >= screen->width) || (yPos >= screen->height))
+        return;
+
+    if (dither != SSD1306_DITHER_FLOYD_STEINBERG)
+    {
+        for (int32_t y = 0; y < height; ++y)
+        {
+            for (int32_t x = 0; x < width; ++x)
+            {
+                int32_t threshold = 127;
+                if (dither == SSD1306_DITHER_BAYER)
+                    threshold = getBayer((xPos + x) % 8, (yPos + y) % 8) * 4 + 2;
+                Reference_drawPixel(screen, xPos + x, yPos + y, picture[y * width + x] > threshold);
+            }
+        }
+        return;
+    }
+
+    // Visible columns and lines, in the picture coordinates
+    int32_t xStart = ((screen->xStart > xPos) ? screen->xStart : xPos) - xPos;
+    int32_t xStop  = ((screen->xStop < (xPos + width)) ? screen->xStop : (xPos + width)) - xPos;
+    int32_t yStop  = ((screen->yStop < (yPos + height)) ? screen->yStop : (yPos + height)) - yPos;
+    if ((xStart >= xStop) || (yStop <= 0) || (yPos + height <= screen->yStart))
+        return;
+
+    // One more column on both sides, so the lost errors need no test
+    memset(error, 0, sizeof(error));
+    for (int32_t y = 0; y < yStop; ++y)
+    {
+        for (int32_t x = xStart; x < xStop; ++x)
+        {
+            int32_t value = picture[y * width + x] + error[y][x - xStart + 1];
+            bool isOn = (value > 127);
+            int32_t e  = isOn ? (value - 255) : value;
+            int32_t e7 = (e * 7) / 16;
+            int32_t e3 = (e * 3) / 16;
+            int32_t e5 = (e * 5) / 16;
+
+            if ((x + 1) < xStop) error[y][x - xStart + 2] += e7;
+            if (x > xStart)      error[y + 1][x - xStart] += e3;
+            error[y + 1][x - xStart + 1] += e5;
+            if ((x + 1) < xStop) error[y + 1][x - xStart + 2] += e - e7 - e3 - e5;
+
+            Reference_drawPixel(screen, xPos + x, yPos + y, isOn);
+        }
+    }
+}
+
+void Reference_rotate (Reference_Screen_t* screen, int32_t xPos, int32_t yPos, int32_t size, int32_t turns)
+{
+    static bool area [SSD1306_MAX_DISPLAY_HEIGHT][SSD1306_MAX_DISPLAY_HEIGHT];
+    static bool rotated [SSD1306_MAX_DISPLAY_HEIGHT][SSD1306_MAX_DISPLAY_HEIGHT];
+
+    for (int32_t j = 0; j < size; ++j)
+        for (int32_t i = 0; i < size; ++i)
+            area[j][i] = screen->pixels[yPos + j][xPos + i];
+
+    for (int32_t turn = 0; turn < turns; ++turn)
+    {
+        for (int32_t j = 0; j < size; ++j)
+            for (int32_t i = 0; i < size; ++i)
+                rotated[i][size - 1 - j] = area[j][i];
+        memcpy(area, rotated, sizeof(area));
+    }
+
+    for (int32_t j = 0; j < size; ++j)
+        for (int32_t i = 0; i < size; ++i)
+            Reference_drawPixel(screen, xPos + i, yPos + j, area[j][i]);
+}
+
+void Reference_scroll (Reference_Screen_t* screen, int32_t lines)
+{
+    for (int32_t y = 0; y < screen->height; ++y)
+    {
+        for (int32_t x = 0; x < screen->width; ++x)
+        {
+            int32_t from = y + lines;
+            screen->pixels[y][x] = (from < screen->height) ? screen->pixels[from][x] : FALSE;
+        }
+    }
+}
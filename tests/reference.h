@@ -0,0 +1,237 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+/*!
+ * \file  /tests/reference.h
+ * \brief Reference rasterizers, one pixel at time.
+ *
+ * Every function tests each pixel of the bounding box against the rule
+ * documented in ssd1306.h, on a plain array of pixels: no span, no byte
+ * mask and no display RAM layout is shared with the library.
+ */
+
+#ifndef __WARCOMEB_SSD1306_TESTS_REFERENCE_H
+#define __WARCOMEB_SSD1306_TESTS_REFERENCE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ssd1306.h"
+#include "ssd1306font.h"
+
+#define REFERENCE_MAX_WIDTH                      128
+#define REFERENCE_MAX_HEIGHT                     64
+
+/*!
+ * Reference screen, with its clip area.
+ */
+typedef struct _Reference_Screen_t
+{
+    int32_t width;
+    int32_t height;
+
+    int32_t xStart;              /*!< First column inside the clip area */
+    int32_t yStart;              /*!< First line inside the clip area */
+    int32_t xStop;               /*!< First column after the clip area */
+    int32_t yStop;               /*!< First line after the clip area */
+
+    bool pixels [REFERENCE_MAX_HEIGHT][REFERENCE_MAX_WIDTH];
+} Reference_Screen_t;
+
+/*!
+ * The function initializes a black screen, without clip area.
+ */
+void Reference_init (Reference_Screen_t* screen, int32_t width, int32_t height);
+
+/*!
+ * The function sets the clip area, the stop positions are excluded.
+ */
+void Reference_setClip (Reference_Screen_t* screen,
+                        int32_t xStart,
+                        int32_t yStart,
+                        int32_t xStop,
+                        int32_t yStop);
+
+/*!
+ * The function sets a pixel, when it is inside the clip area.
+ */
+void Reference_drawPixel (Reference_Screen_t* screen, int32_t xPos, int32_t yPos, bool color);
+
+/*!
+ * The function returns a pixel, 0 out of the screen.
+ */
+bool Reference_getPixel (const Reference_Screen_t* screen, int32_t xPos, int32_t yPos);
+
+/*!
+ * The function fills a rectangle, from xPos to xPos+width-1 and from yPos
+ * to yPos+height-1.
+ */
+void Reference_fillRectangle (Reference_Screen_t* screen,
+                              int32_t xPos,
+                              int32_t yPos,
+                              int32_t width,
+                              int32_t height,
+                              bool color);
+
+/*!
+ * The function draws the border of a rectangle, one pixel wide.
+ */
+void Reference_drawRectangle (Reference_Screen_t* screen,
+                              int32_t xPos,
+                              int32_t yPos,
+                              int32_t width,
+                              int32_t height,
+                              bool color);
+
+/*!
+ * The function draws a line, both ends included, with the Bresenham
+ * algorithm of GDL.
+ */
+void Reference_drawLine (Reference_Screen_t* screen,
+                         int32_t xStart,
+                         int32_t yStart,
+                         int32_t xStop,
+                         int32_t yStop,
+                         bool color);
+
+/*!
+ * The function draws 8 vertical pixels, selected by the mask.
+ */
+void Reference_writeColumn (Reference_Screen_t* screen,
+                            int32_t xPos,
+                            int32_t yPos,
+                            uint8_t bits,
+                            uint8_t mask);
+
+/*!
+ * The function draws a picture with one bit for pixel, 8 pixels of the
+ * same row for each byte, the most significant bit on the left.
+ */
+void Reference_drawPicture (Reference_Screen_t* screen,
+                            int32_t xPos,
+                            int32_t yPos,
+                            int32_t width,
+                            int32_t height,
+                            const uint8_t* picture);
+
+/*!
+ * The function draws a char of the stub font: a 5x7 hollow box for every
+ * char except the space, on the background color.
+ */
+void Reference_drawChar (Reference_Screen_t* screen,
+                         int32_t xPos,
+                         int32_t yPos,
+                         char c,
+                         bool color,
+                         uint8_t size);
+
+/*!
+ * The function draws a line of text with a proportional font, from the code
+ * points already decoded: every glyph is found with a linear search, and it
+ * is drawn with its background for the whole advance.
+ *
+ * \return The width of the text.
+ */
+int32_t Reference_drawText (Reference_Screen_t* screen,
+                            const SSD1306_Font_t* font,
+                            int32_t xPos,
+                            int32_t yPos,
+                            const uint32_t* codes,
+                            int32_t count,
+                            bool color);
+
+/*!
+ * The function fills an ellipse: a pixel is inside when
+ * dx^2/(a^2+a) + dy^2/(b^2+b) <= 1.
+ */
+void Reference_fillEllipse (Reference_Screen_t* screen,
+                            int32_t xCenter,
+                            int32_t yCenter,
+                            int32_t xRadius,
+                            int32_t yRadius,
+                            bool color);
+
+/*!
+ * The function fills a rectangle with rounded corners: the radius is
+ * limited to half of the smaller side, and the pixels of the corners are
+ * inside when dx^2 + dy^2 <= r^2 + r from the center of the corner.
+ */
+void Reference_fillRoundRectangle (Reference_Screen_t* screen,
+                                   int32_t xPos,
+                                   int32_t yPos,
+                                   int32_t width,
+                                   int32_t height,
+                                   int32_t radius,
+                                   bool color);
+
+/*!
+ * The function fills a polygon: in every column, a pixel is inside when it
+ * is between the lowest and the highest crossing point of the edges,
+ * rounded to the nearest line with the halves rounded up.
+ */
+void Reference_fillPolygon (Reference_Screen_t* screen,
+                            const SSD1306_Point_t* points,
+                            uint8_t count,
+                            bool color);
+
+/*!
+ * The function draws a grayscale picture, 8 bits for pixel, row by row:
+ * \li threshold: a pixel is on when its value is greater than 127;
+ * \li Bayer: a pixel is on when its value is greater than 4*M+2, where M is
+ *     the entry of the 8x8 Bayer matrix at the display position;
+ * \li Floyd-Steinberg: the error of every pixel is diffused to its
+ *     neighbours with the weights 7/16, 3/16, 5/16, rounded toward zero, and
+ *     the remainder; the visible columns are processed from the first row of
+ *     the picture, and the errors that go out of them are lost.
+ */
+void Reference_drawGrayscale (Reference_Screen_t* screen,
+                              int32_t xPos,
+                              int32_t yPos,
+                              int32_t width,
+                              int32_t height,
+                              const uint8_t* picture,
+                              SSD1306_Dither_t dither);
+
+/*!
+ * The function rotates clockwise a square area by the selected quarter
+ * turns: the pixel at column i and row j of the area goes to column
+ * size-1-j and row i. Only the pixels into the clip area are changed.
+ */
+void Reference_rotate (Reference_Screen_t* screen, int32_t xPos, int32_t yPos, int32_t size, int32_t turns);
+
+/*!
+ * The function moves the screen up by the selected lines, and clears the
+ * new lines at the bottom.
+ */
+void Reference_scroll (Reference_Screen_t* screen, int32_t lines);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __WARCOMEB_SSD1306_TESTS_REFERENCE_H
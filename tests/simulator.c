@@ -0,0 +1,333 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+/*!
+ * \file  /tests/simulator.c
+ * \brief Simulated SSD1306 controller on the I2C bus.
+ */
+
+#include "simulator.h"
+
+#define SIMULATOR_CONTROL_COMMAND                0x00
+#define SIMULATOR_CONTROL_DATA                   0x40
+
+#define SIMULATOR_HORIZONTAL_MODE                0x00
+#define SIMULATOR_VERTICAL_MODE                  0x01
+#define SIMULATOR_PAGE_MODE                      0x02
+
+static Simulator_Controller_t mController;
+static uint32_t mTick = 0;
+
+/*!
+ * The function returns the number of parameters of a command.
+ */
+static uint8_t getParameters (uint8_t command)
+{
+    switch (command)
+    {
+    case 0x20: // Addressing mode
+    case 0x23: // Fade out and blinking
+    case 0x81: // Contrast
+    case 0x8D: // Charge pump
+    case 0xA8: // Multiplex ratio
+    case 0xAD: // Internal IREF
+    case 0xD3: // Display offset
+    case 0xD5: // Display clock
+    case 0xD6: // Zoom in
+    case 0xD9: // Pre-charge period
+    case 0xDA: // COM pins
+    case 0xDB: // De-select level
+        return 1;
+    case 0x21: // Column address
+    case 0x22: // Page address
+    case 0xA3: // Vertical scroll area
+        return 2;
+    case 0x29: // Vertical and horizontal scroll
+    case 0x2A:
+        return 5;
+    case 0x26: // Horizontal scroll
+    case 0x27:
+        return 6;
+    default:
+        return 0;
+    }
+}
+
+static void executeCommand (const uint8_t* command)
+{
+    Simulator_Controller_t* c = &mController;
+    uint8_t code = command[0];
+
+    if (code <= 0x0F)
+    {
+        // Lower nibble of the page mode start column
+        if (c->addressingMode != SIMULATOR_PAGE_MODE) c->errors++;
+        c->columnStart = (c->columnStart & 0xF0) | code;
+        c->column      = c->columnStart;
+    }
+    else if (code <= 0x1F)
+    {
+        // Higher nibble of the page mode start column
+        if (c->addressingMode != SIMULATOR_PAGE_MODE) c->errors++;
+        c->columnStart = (uint8_t)(((code & 0x07) << 4) | (c->columnStart & 0x0F));
+        c->column      = c->columnStart;
+    }
+    else if (code == 0x20)
+    {
+        if (command[1] > SIMULATOR_PAGE_MODE) c->errors++;
+        else c->addressingMode = command[1];
+    }
+    else if ((code == 0x21) || (code == 0x22))
+    {
+        // The windows are used only by horizontal and vertical modes
+        if (c->addressingMode == SIMULATOR_PAGE_MODE) c->errors++;
+        if (code == 0x21)
+        {
+            c->columnStart = command[1] & 0x7F;
+            c->columnEnd   = command[2] & 0x7F;
+            c->column      = c->columnStart;
+        }
+        else
+        {
+            c->pageStart = command[1] & 0x07;
+            c->pageEnd   = command[2] & 0x07;
+            c->page      = c->pageStart;
+        }
+    }
+    else if ((code >= 0x40) && (code <= 0x7F))
+    {
+        c->startLine = code & 0x3F;
+    }
+    else if (code == 0x81)
+    {
+        c->contrast = command[1];
+    }
+    else if (code == 0x8D)
+    {
+        c->isChargePump = (command[1] & 0x04) != 0;
+    }
+    else if ((code == 0xA0) || (code == 0xA1))
+    {
+        c->isSegmentRemap = (code == 0xA1);
+    }
+    else if ((code == 0xA6) || (code == 0xA7))
+    {
+        c->isInverse = (code == 0xA7);
+    }
+    else if ((code == 0xAE) || (code == 0xAF))
+    {
+        c->isOn = (code == 0xAF);
+    }
+    else if ((code >= 0xB0) && (code <= 0xB7))
+    {
+        // Page mode start page
+        if (c->addressingMode != SIMULATOR_PAGE_MODE) c->errors++;
+        c->page = code & 0x07;
+    }
+    else if ((code == 0xC0) || (code == 0xC8))
+    {
+        c->isComScanDown = (code == 0xC8);
+    }
+}
+
+static void writeCommand (uint8_t value)
+{
+    Simulator_Controller_t* c = &mController;
+
+    if (c->commandLength == 0)
+    {
+        c->commandExpected = getParameters(value);
+    }
+    else
+    {
+        c->commandExpected--;
+    }
+    c->command[c->commandLength++] = value;
+
+    if (c->commandExpected == 0)
+    {
+        executeCommand(c->command);
+        c->commandLength = 0;
+    }
+}
+
+static void writeData (uint8_t value)
+{
+    Simulator_Controller_t* c = &mController;
+
+    c->ram[c->page][c->column] = value;
+    c->modeBytes[c->addressingMode]++;
+
+    switch (c->addressingMode)
+    {
+    case SIMULATOR_HORIZONTAL_MODE:
+        if (c->column == c->columnEnd)
+        {
+            c->column = c->columnStart;
+            c->page   = (c->page == c->pageEnd) ? c->pageStart : ((c->page + 1) & 0x07);
+        }
+        else
+        {
+            c->column = (c->column + 1) & 0x7F;
+        }
+        break;
+    case SIMULATOR_VERTICAL_MODE:
+        if (c->page == c->pageEnd)
+        {
+            c->page   = c->pageStart;
+            c->column = (c->column == c->columnEnd) ? c->columnStart : ((c->column + 1) & 0x7F);
+        }
+        else
+        {
+            c->page = (c->page + 1) & 0x07;
+        }
+        break;
+    default:
+        // Page mode: the page never changes
+        c->column = (c->column == (SIMULATOR_COLUMNS - 1)) ? c->columnStart : (c->column + 1);
+        break;
+    }
+}
+
+Simulator_Controller_t* Simulator_get (void)
+{
+    return &mController;
+}
+
+void Simulator_reset (void)
+{
+    Simulator_Controller_t* c = &mController;
+
+    c->addressingMode  = SIMULATOR_PAGE_MODE;
+    c->columnStart     = 0;
+    c->columnEnd       = SIMULATOR_COLUMNS - 1;
+    c->pageStart       = 0;
+    c->pageEnd         = SIMULATOR_PAGES - 1;
+    c->column          = 0;
+    c->page            = 0;
+    c->startLine       = 0;
+    c->contrast        = 0x7F;
+    c->isOn            = FALSE;
+    c->isInverse       = FALSE;
+    c->isSegmentRemap  = FALSE;
+    c->isComScanDown   = FALSE;
+    c->isChargePump    = FALSE;
+    c->commandLength   = 0;
+    c->commandExpected = 0;
+    Simulator_resetCounters();
+}
+
+void Simulator_resetCounters (void)
+{
+    mController.transactions = 0;
+    mController.commandBytes = 0;
+    mController.dataBytes    = 0;
+    memset(mController.modeBytes, 0, sizeof(mController.modeBytes));
+    mController.errors       = 0;
+}
+
+bool Simulator_getPixel (uint8_t xPos, uint8_t yPos)
+{
+    uint8_t row = (yPos + mController.startLine) & (SIMULATOR_ROWS - 1);
+    return (mController.ram[row / 8][xPos] >> (row % 8)) & 0x01;
+}
+
+void Simulator_advance (uint32_t ms)
+{
+    mTick += ms;
+}
+
+System_Errors Iic_init (Iic_DeviceHandle dev, Iic_Config* config)
+{
+    (void)dev;
+    (void)config;
+    return ERRORS_NO_ERROR;
+}
+
+System_Errors Iic_writeRegister (Iic_DeviceHandle dev,
+                                 uint16_t address,
+                                 uint16_t registerAddress,
+                                 Iic_RegisterAddressSize registerAddressSize,
+                                 const uint8_t* data,
+                                 uint8_t length,
+                                 uint32_t timeout)
+{
+    Simulator_Controller_t* c = &mController;
+    (void)timeout;
+
+    c->transactions++;
+    if ((dev == NULL) || (address != SIMULATOR_ADDRESS) ||
+        (registerAddressSize != IIC_REGISTERADDRESSSIZE_8BIT) || (length == 0))
+    {
+        c->errors++;
+        return ERRORS_IIC_NO_ACK;
+    }
+
+    switch (registerAddress)
+    {
+    case SIMULATOR_CONTROL_COMMAND:
+        c->commandBytes += length;
+        for (uint8_t i = 0; i < length; ++i) writeCommand(data[i]);
+        break;
+    case SIMULATOR_CONTROL_DATA:
+        // The data cannot interrupt a command with parameters
+        if (c->commandLength != 0) c->errors++;
+        c->dataBytes += length;
+        for (uint8_t i = 0; i < length; ++i) writeData(data[i]);
+        break;
+    default:
+        c->errors++;
+        return ERRORS_IIC_NO_ACK;
+    }
+    return ERRORS_NO_ERROR;
+}
+
+void Gpio_config (Gpio_Pins pin, uint16_t options)
+{
+    (void)pin;
+    (void)options;
+}
+
+void Gpio_set (Gpio_Pins pin)
+{
+    (void)pin;
+}
+
+void Gpio_clear (Gpio_Pins pin)
+{
+    (void)pin;
+}
+
+void System_delay (uint32_t msDelay)
+{
+    mTick += msDelay;
+}
+
+uint32_t System_currentTick (void)
+{
+    return mTick;
+}
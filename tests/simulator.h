@@ -0,0 +1,124 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+/*!
+ * \file  /tests/simulator.h
+ * \brief Simulated SSD1306 controller on the I2C bus.
+ *
+ * The simulator implements the libohiboard functions used by the library,
+ * and decodes the commands and the data like the controller: addressing
+ * modes, column and page windows, page mode start addresses and display
+ * start line. The tests compare its display RAM with the expected image.
+ */
+
+#ifndef __WARCOMEB_SSD1306_TESTS_SIMULATOR_H
+#define __WARCOMEB_SSD1306_TESTS_SIMULATOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "libohiboard.h"
+
+#define SIMULATOR_ADDRESS                        0x3C
+#define SIMULATOR_PAGES                          8
+#define SIMULATOR_COLUMNS                        128
+#define SIMULATOR_ROWS                           64
+
+/*!
+ * State of the simulated controller.
+ */
+typedef struct _Simulator_Controller_t
+{
+    uint8_t ram [SIMULATOR_PAGES][SIMULATOR_COLUMNS];
+
+    uint8_t addressingMode;
+    uint8_t columnStart;         /*!< Column window, or page mode start column */
+    uint8_t columnEnd;
+    uint8_t pageStart;
+    uint8_t pageEnd;
+    uint8_t column;              /*!< Current column pointer */
+    uint8_t page;                /*!< Current page pointer */
+
+    uint8_t startLine;
+    uint8_t contrast;
+    bool isOn;
+    bool isInverse;
+    bool isSegmentRemap;
+    bool isComScanDown;
+    bool isChargePump;
+
+    uint8_t command [8];         /*!< Command waiting for its parameters */
+    uint8_t commandLength;
+    uint8_t commandExpected;
+
+    uint32_t transactions;
+    uint32_t commandBytes;
+    uint32_t dataBytes;
+    uint32_t modeBytes [3];      /*!< Data bytes for each addressing mode */
+    uint32_t errors;             /*!< Transactions that the controller rejects */
+} Simulator_Controller_t;
+
+/*!
+ * The function returns the simulated controller.
+ */
+Simulator_Controller_t* Simulator_get (void);
+
+/*!
+ * The function sets the controller to its reset state: RAM not cleared,
+ * horizontal addressing mode and start line 0. The tick is not changed.
+ */
+void Simulator_reset (void);
+
+/*!
+ * The function clears the bus counters.
+ */
+void Simulator_resetCounters (void);
+
+/*!
+ * The function returns a pixel of the display, as the driver addresses it:
+ * the line is remapped through the display start line, the segment re-map
+ * and the COM scan direction are not applied.
+ *
+ * \param[in] xPos: The column
+ * \param[in] yPos: The display line
+ * \return The pixel.
+ */
+bool Simulator_getPixel (uint8_t xPos, uint8_t yPos);
+
+/*!
+ * The function moves the system tick forward.
+ *
+ * \param[in] ms: The elapsed time in ms.
+ */
+void Simulator_advance (uint32_t ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __WARCOMEB_SSD1306_TESTS_SIMULATOR_H
@@ -0,0 +1,125 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+/*!
+ * \file  /tests/stubs/GDL/gdl.c
+ * \brief Host stub of GDL.
+ */
+
+#include "gdl.h"
+
+typedef GDL_Errors_t (*GDL_DrawPixel_t) (void* dev, uint8_t xPos, uint8_t yPos, uint8_t color);
+
+static void drawPixel (GDL_Device_t* dev, int32_t xPos, int32_t yPos, uint8_t color)
+{
+    // The callback takes 8 bit positions
+    if ((xPos > 0xFF) || (yPos > 0xFF))
+        return;
+
+    ((GDL_DrawPixel_t)dev->drawPixel)(dev, (uint8_t)xPos, (uint8_t)yPos, color);
+}
+
+void GDL_drawLine (GDL_Device_t* dev,
+                   uint16_t xStart,
+                   uint16_t yStart,
+                   uint16_t xStop,
+                   uint16_t yStop,
+                   uint8_t color)
+{
+    int32_t dx = (xStop > xStart) ? (xStop - xStart) : (xStart - xStop);
+    int32_t dy = (yStop > yStart) ? (yStart - yStop) : (yStop - yStart);
+    int32_t sx = (xStart < xStop) ? 1 : -1;
+    int32_t sy = (yStart < yStop) ? 1 : -1;
+    int32_t error = dx + dy;
+    int32_t x = xStart;
+    int32_t y = yStart;
+
+    for (;;)
+    {
+        drawPixel(dev, x, y, color);
+        if ((x == xStop) && (y == yStop)) break;
+
+        int32_t e2 = 2 * error;
+        if (e2 >= dy)
+        {
+            error += dy;
+            x += sx;
+        }
+        if (e2 <= dx)
+        {
+            error += dx;
+            y += sy;
+        }
+    }
+}
+
+GDL_Errors_t GDL_drawChar (GDL_Device_t* dev,
+                           uint16_t xPos,
+                           uint16_t yPos,
+                           uint8_t c,
+                           uint8_t color,
+                           uint8_t background,
+                           uint8_t size)
+{
+    uint8_t scale = (size == 0) ? 1 : size;
+
+    for (int32_t i = 0; i < (GDL_DEFAULT_FONT_WIDTH * scale); ++i)
+    {
+        for (int32_t j = 0; j < (8 * scale); ++j)
+        {
+            int32_t column = i / scale;
+            int32_t line   = j / scale;
+            bool isBox = (column < 5) && (line < 7) &&
+                         ((column == 0) || (column == 4) || (line == 0) || (line == 6));
+
+            drawPixel(dev, xPos + i, yPos + j, ((c != ' ') && isBox) ? color : background);
+        }
+    }
+    return GDL_ERRORS_SUCCESS;
+}
+
+GDL_Errors_t GDL_drawPicture (void* dev,
+                              uint16_t xPos,
+                              uint16_t yPos,
+                              uint16_t width,
+                              uint16_t height,
+                              const uint8_t* picture,
+                              GDL_PictureType_t type)
+{
+    uint16_t stride = (width + 7) / 8;
+    (void)type;
+
+    for (int32_t j = 0; j < height; ++j)
+    {
+        for (int32_t i = 0; i < width; ++i)
+        {
+            uint8_t bit = (picture[j * stride + i / 8] >> (7 - (i % 8))) & 0x01;
+            drawPixel((GDL_Device_t*)dev, xPos + i, yPos + j, bit);
+        }
+    }
+    return GDL_ERRORS_SUCCESS;
+}
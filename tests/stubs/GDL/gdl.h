@@ -0,0 +1,83 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+/*!
+ * \file  /tests/stubs/GDL/gdl.h
+ * \brief Host stub of GDL: the generic algorithms draw through the pixel
+ *        callback of the device, like the real library.
+ */
+
+#ifndef __WARCOMEB_GDL_H
+#define __WARCOMEB_GDL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "gdltype.h"
+
+#define GDL_DEFAULT_FONT_WIDTH                   6
+
+/*!
+ * The function draws a line with the Bresenham algorithm, both ends included.
+ */
+void GDL_drawLine (GDL_Device_t* dev,
+                   uint16_t xStart,
+                   uint16_t yStart,
+                   uint16_t xStop,
+                   uint16_t yStop,
+                   uint8_t color);
+
+/*!
+ * The function draws a char of the default font, with the background.
+ * The stub font draws a 5x7 hollow box for every char except the space.
+ */
+GDL_Errors_t GDL_drawChar (GDL_Device_t* dev,
+                           uint16_t xPos,
+                           uint16_t yPos,
+                           uint8_t c,
+                           uint8_t color,
+                           uint8_t background,
+                           uint8_t size);
+
+/*!
+ * The function draws a picture with one bit for pixel: every byte is 8
+ * pixels of the same row, the most significant bit on the left.
+ */
+GDL_Errors_t GDL_drawPicture (void* dev,
+                              uint16_t xPos,
+                              uint16_t yPos,
+                              uint16_t width,
+                              uint16_t height,
+                              const uint8_t* picture,
+                              GDL_PictureType_t type);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __WARCOMEB_GDL_H
@@ -0,0 +1,80 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+/*!
+ * \file  /tests/stubs/GDL/gdltype.h
+ * \brief Host stub of the GDL types, with only the parts used by the library.
+ */
+
+#ifndef __WARCOMEB_GDL_TYPE_H
+#define __WARCOMEB_GDL_TYPE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "libohiboard.h"
+
+#define GDL_MODELTYPE_SSD1306                    0x0100
+
+typedef enum _GDL_Errors_t
+{
+    GDL_ERRORS_SUCCESS,
+    GDL_ERRORS_WRONG_POSITION,
+} GDL_Errors_t;
+
+typedef enum _GDL_ProtocolType_t
+{
+    GDL_PROTOCOLTYPE_PARALLEL,
+    GDL_PROTOCOLTYPE_I2C,
+    GDL_PROTOCOLTYPE_SPI,
+} GDL_ProtocolType_t;
+
+typedef enum _GDL_PictureType_t
+{
+    GDL_PICTURETYPE_1BIT,
+} GDL_PictureType_t;
+
+/*!
+ * Common part of every device.
+ * The drawing callback is called with the handle of the whole device, as
+ * GDL_Errors_t drawPixel (void* dev, uint8_t xPos, uint8_t yPos, uint8_t color).
+ */
+typedef struct _GDL_Device_t
+{
+    uint16_t width;
+    uint16_t height;
+    uint8_t model;
+    bool useCustomFont;
+    void* drawPixel;
+} GDL_Device_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __WARCOMEB_GDL_TYPE_H
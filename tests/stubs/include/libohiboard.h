@@ -0,0 +1,109 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+/*!
+ * \file  /tests/stubs/include/libohiboard.h
+ * \brief Host stub of libohiboard, with only the parts used by the library.
+ *
+ * The bus and the system functions are implemented by the simulated
+ * controller, see simulator.h.
+ */
+
+#ifndef __LIBOHIBOARD_H
+#define __LIBOHIBOARD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#define LIBOHIBOARD_IIC
+
+#ifndef TRUE
+#define TRUE                                     true
+#endif
+#ifndef FALSE
+#define FALSE                                    false
+#endif
+
+#define ohiassert(condition)                     ((void)(condition))
+
+typedef enum _System_Errors
+{
+    ERRORS_NO_ERROR,
+    ERRORS_IIC_TIMEOUT,
+    ERRORS_IIC_NO_ACK,
+} System_Errors;
+
+void System_delay (uint32_t msDelay);
+uint32_t System_currentTick (void);
+
+typedef uint16_t Gpio_Pins;
+
+#define GPIO_PINS_NONE                           0
+
+typedef enum _Gpio_Configs
+{
+    GPIO_PINS_INPUT,
+    GPIO_PINS_OUTPUT,
+} Gpio_Configs;
+
+void Gpio_config (Gpio_Pins pin, uint16_t options);
+void Gpio_set (Gpio_Pins pin);
+void Gpio_clear (Gpio_Pins pin);
+
+typedef struct _Iic_Device* Iic_DeviceHandle;
+
+typedef struct _Iic_Config
+{
+    uint32_t baudrate;
+} Iic_Config;
+
+typedef enum _Iic_RegisterAddressSize
+{
+    IIC_REGISTERADDRESSSIZE_8BIT,
+    IIC_REGISTERADDRESSSIZE_16BIT,
+} Iic_RegisterAddressSize;
+
+System_Errors Iic_init (Iic_DeviceHandle dev, Iic_Config* config);
+System_Errors Iic_writeRegister (Iic_DeviceHandle dev,
+                                 uint16_t address,
+                                 uint16_t registerAddress,
+                                 Iic_RegisterAddressSize registerAddressSize,
+                                 const uint8_t* data,
+                                 uint8_t length,
+                                 uint32_t timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __LIBOHIBOARD_H
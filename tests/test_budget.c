@@ -0,0 +1,516 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+/*!
+ * \file  /tests/test_budget.c
+ * \brief Bus and CPU budgets of the main scenarios.
+ *
+ * The bus budgets are the cost of the command sequences chosen by the flush
+ * planner with the I2C cost model, so a change that sends more is caught.
+ * The CPU times are only reported: they depend on the host, and a slow one
+ * is marked without failing. Every scenario checks also that the statistics
+ * match the bus counters of the simulated controller, and that the display
+ * shows the internal buffer.
+ */
+
+#include "harness.h"
+#include "ssd1306canvas.h"
+#include "ssd1306console.h"
+#include "ssd1306fade.h"
+#include "ssd1306fontsmall.h"
+#include "ssd1306plot.h"
+#include "ssd1306sprite.h"
+#include "ssd1306widget.h"
+
+#define BUDGET_DRAW_COUNT                        1000
+
+static SSD1306_Device_t mDevice;
+
+static void fillRandom (void)
+{
+    for (uint32_t i = 0; i < SSD1306_BUFFER_DIMENSION; ++i)
+        mDevice.buffer[i] = Test_random();
+}
+
+/*!
+ * The function checks that the area on the display is the same of the
+ * internal buffer.
+ */
+static void checkDisplay (const char* name, uint16_t xPos, uint16_t yPos, uint16_t width, uint16_t height)
+{
+    for (uint16_t y = yPos; (y < (yPos + height)) && (y < mDevice.gdl.height); ++y)
+    {
+        for (uint16_t x = xPos; (x < (xPos + width)) && (x < mDevice.gdl.width); ++x)
+        {
+            if (Simulator_getPixel(x, y) != Test_getBufferPixel(&mDevice, x, y))
+            {
+                TEST_CHECK(FALSE, "%s: display pixel %u,%u is not the buffer one", name, x, y);
+                return;
+            }
+        }
+    }
+}
+
+static void checkFlush (const Test_Budget_t* budget, uint16_t xPos, uint16_t yPos, uint16_t width, uint16_t height)
+{
+    fillRandom();
+    uint32_t start = Test_startScenario(&mDevice);
+    SSD1306_flushArea(&mDevice, xPos, yPos, width, height);
+    Test_checkBudget(budget, &mDevice, start);
+    checkDisplay(budget->name, xPos, yPos, width, height);
+}
+
+static void testFlush (void)
+{
+    static const Test_Budget_t full       = { "flush 128x64",                 9, 1030, 2000 };
+    static const Test_Budget_t pixel      = { "flushArea 1x1",                2,    6, 1000 };
+    static const Test_Budget_t column     = { "flushArea 1x64",               2,   16, 1000 };
+    static const Test_Budget_t unaligned  = { "flushArea 20x10 start line 5", 2,   46, 1000 };
+    static const Test_Budget_t wrapped    = { "flushArea 128x16 wrapped",     4,  264, 1000 };
+
+    Test_initDevice(&mDevice, SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1);
+    Test_seed(0x0B06E7);
+
+    SSD1306_Region_t all = { 0, 0, mDevice.gdl.width, mDevice.gdl.height };
+    checkFlush(&full, all.xPos, all.yPos, all.width, all.height);
+    checkFlush(&pixel, 77, 13, 1, 1);
+    checkFlush(&column, 5, 0, 1, 64);
+
+    // The areas start on rows that are not aligned to the pages
+    SSD1306_scrollLines(&mDevice, 5);
+    SSD1306_flush(&mDevice);
+    checkFlush(&unaligned, 30, 20, 20, 10);
+
+    // The area wraps around the end of the display RAM
+    SSD1306_scrollLines(&mDevice, 51);
+    SSD1306_flush(&mDevice);
+    checkFlush(&wrapped, 0, 0, 128, 16);
+}
+
+static void testFlushSmall (void)
+{
+    static const Test_Budget_t full = { "flush 128x32", 5, 518, 2000 };
+
+    Test_initDevice(&mDevice, SSD1306_PRODUCT_ADAFRUIT_931);
+    Test_seed(0x931);
+    checkFlush(&full, 0, 0, mDevice.gdl.width, mDevice.gdl.height);
+}
+
+static void testRegions (void)
+{
+    static const Test_Budget_t scattered = { "flushRegions 8 scattered",   16,  88, 1000 };
+    static const Test_Budget_t scroll    = { "scroll 8 lines and new row",  3, 134, 1000 };
+
+    Test_initDevice(&mDevice, SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1);
+    Test_seed(0x8E610);
+
+    SSD1306_Region_t regions [8];
+    for (uint8_t i = 0; i < 8; ++i)
+    {
+        regions[i].xPos   = Test_range(0, 120);
+        regions[i].yPos   = Test_range(0, 56);
+        regions[i].width  = Test_range(1, 8);
+        regions[i].height = Test_range(1, 8);
+    }
+    fillRandom();
+    uint32_t start = Test_startScenario(&mDevice);
+    SSD1306_flushRegions(&mDevice, regions, 8);
+    Test_checkBudget(&scattered, &mDevice, start);
+    for (uint8_t i = 0; i < 8; ++i)
+        checkDisplay(scattered.name, regions[i].xPos, regions[i].yPos, regions[i].width, regions[i].height);
+
+    // A console that scrolls by one row of text
+    SSD1306_flush(&mDevice);
+    start = Test_startScenario(&mDevice);
+    SSD1306_scrollLines(&mDevice, 8);
+    SSD1306_flushArea(&mDevice, 0, 56, 128, 8);
+    Test_checkBudget(&scroll, &mDevice, start);
+    TEST_CHECK(Simulator_get()->startLine == 8, "%s: start line %u", scroll.name, Simulator_get()->startLine);
+    checkDisplay(scroll.name, 0, 0, 128, 64);
+}
+
+static void testConsole (void)
+{
+    static SSD1306_Console_t console;
+    static const Test_Budget_t print = { "console print 20 lines",     0,    0, 1000 };
+    static const Test_Budget_t flush = { "console flush of 20 lines",  17, 1049, 1000 };
+    static const Test_Budget_t blank = { "console new empty line",     3,  132, 1000 };
+    char line [24];
+
+    Test_initDevice(&mDevice, SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1);
+    SSD1306_consoleInit(&console, &mDevice, TRUE);
+    for (uint8_t i = 0; i < console.rows; ++i)
+    {
+        snprintf(line, sizeof(line), "row %u\n", i);
+        SSD1306_consolePrint(&console, line);
+    }
+    SSD1306_consoleFlush(&console);
+
+    // Printing only changes the grid, the lines are sent by the flush
+    uint32_t start = Test_startScenario(&mDevice);
+    for (uint8_t i = 0; i < 20; ++i)
+    {
+        snprintf(line, sizeof(line), "line %u: %u\n", i, i * 7919u);
+        SSD1306_consolePrint(&console, line);
+    }
+    Test_checkBudget(&print, &mDevice, start);
+
+    start = Test_startScenario(&mDevice);
+    SSD1306_consoleFlush(&console);
+    Test_checkBudget(&flush, &mDevice, start);
+    checkDisplay(flush.name, 0, 0, 128, 64);
+
+    // The new row was blank, so only the start line and the row are sent
+    start = Test_startScenario(&mDevice);
+    SSD1306_consolePutChar(&console, '\n');
+    SSD1306_consoleFlush(&console);
+    Test_checkBudget(&blank, &mDevice, start);
+    checkDisplay(blank.name, 0, 0, 128, 64);
+}
+
+static void testPlot (void)
+{
+    static SSD1306_Plot_t plot;
+    static const Test_Budget_t push = { "plot 256 samples with gap 1", 516, 5646, 1000 };
+
+    Test_initDevice(&mDevice, SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1);
+    Test_seed(0x9107);
+    SSD1306_plotInit(&plot, &mDevice, 0, 0, 128, 64, -100, 100, 1);
+    SSD1306_flush(&mDevice);
+
+    // Every sample sends the new column and the erased one, next to it, so
+    // the planner sends them with one window
+    uint32_t start = Test_startScenario(&mDevice);
+    for (uint16_t i = 0; i < 256; ++i)
+        SSD1306_plotPush(&plot, Test_range(-120, 120));
+    Test_checkBudget(&push, &mDevice, start);
+    checkDisplay(push.name, 0, 0, 128, 64);
+}
+
+static void testSprite (void)
+{
+    static const Test_Budget_t jump = { "sprite 16x16 jump across", 4, 108, 1000 };
+    static const Test_Budget_t step = { "sprite 16x16 step of 1",   2,  57, 1000 };
+    static uint8_t bitmap [32];
+    static uint8_t background [SSD1306_SPRITE_SIZE(16, 16)];
+    SSD1306_Sprite_t sprite = { 16, 16, bitmap, NULL };
+
+    Test_initDevice(&mDevice, SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1);
+    Test_seed(0x5991);
+    for (uint8_t i = 0; i < sizeof(bitmap); ++i)
+        bitmap[i] = Test_random();
+    fillRandom();
+    SSD1306_flush(&mDevice);
+    SSD1306_saveSprite(&mDevice, &sprite, 4, 2, background);
+    SSD1306_drawSprite(&mDevice, &sprite, 4, 2, SSD1306_BLEND_MASKED);
+    SSD1306_flushSprite(&mDevice, &sprite, 4, 2);
+
+    // Only the two positions are sent, not their bounding box
+    uint32_t start = Test_startScenario(&mDevice);
+    SSD1306_moveSprite(&mDevice, &sprite, 4, 2, 100, 44, SSD1306_BLEND_MASKED, background);
+    Test_checkBudget(&jump, &mDevice, start);
+    checkDisplay(jump.name, 0, 0, 128, 64);
+
+    // The two positions overlap, they are merged
+    start = Test_startScenario(&mDevice);
+    SSD1306_moveSprite(&mDevice, &sprite, 100, 44, 101, 44, SSD1306_BLEND_MASKED, background);
+    Test_checkBudget(&step, &mDevice, start);
+    checkDisplay(step.name, 0, 0, 128, 64);
+
+    // Without background the sprite is erased with a XOR
+    static const Test_Budget_t xor = { "sprite 16x16 XOR step of 1", 2, 57, 1000 };
+    start = Test_startScenario(&mDevice);
+    SSD1306_moveSprite(&mDevice, &sprite, 30, 21, 31, 22, SSD1306_BLEND_XOR, NULL);
+    Test_checkBudget(&xor, &mDevice, start);
+    checkDisplay(xor.name, 0, 0, 128, 64);
+}
+
+static void testText (void)
+{
+    static const Test_Budget_t box    = { "drawTextBox 3 lines and flush", 5, 406, 1000 };
+    static const Test_Budget_t rotate = { "rotateArea 32x32 and flush",    2, 136, 1000 };
+
+    Test_initDevice(&mDevice, SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1);
+    Test_seed(0x7E87);
+    fillRandom();
+    SSD1306_flush(&mDevice);
+
+    uint32_t start = Test_startScenario(&mDevice);
+    SSD1306_drawTextBox(&mDevice, &SSD1306_FONT_SMALL, 4, 10, 100, 27,
+                        "The quick brown fox jumps over the lazy dog", SSD1306_COLOR_COLOR);
+    SSD1306_flushArea(&mDevice, 4, 10, 100, 27);
+    Test_checkBudget(&box, &mDevice, start);
+    checkDisplay(box.name, 0, 0, 128, 64);
+
+    // A widget drawn and then rotated to be shown vertically
+    start = Test_startScenario(&mDevice);
+    SSD1306_rotateArea(&mDevice, 48, 16, 32, SSD1306_ROTATION_90);
+    SSD1306_flushArea(&mDevice, 48, 16, 32, 32);
+    Test_checkBudget(&rotate, &mDevice, start);
+    checkDisplay(rotate.name, 0, 0, 128, 64);
+}
+
+static void testWidgets (void)
+{
+    static const Test_Budget_t label    = { "widget label 1 char changed",    2, 11, 1000 };
+    static const Test_Budget_t progress = { "widget progress step of 1",      2, 10, 1000 };
+    static const Test_Budget_t gauge    = { "widget gauge needle step of 1",  2, 45, 1000 };
+    static const Test_Budget_t icon     = { "widget icon 16x16 changed",      2, 38, 1000 };
+    static uint8_t icons [2][SSD1306_SPRITE_SIZE(16, 16)];
+    static const uint8_t* const iconSet [2] = { icons[0], icons[1] };
+    static SSD1306_Widget_t widgets [4];
+
+    Test_initDevice(&mDevice, SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1);
+    Test_seed(0x3D9E7);
+    SSD1306_flush(&mDevice);
+    for (uint8_t i = 0; i < sizeof(icons[0]); ++i)
+    {
+        icons[0][i] = Test_random();
+        icons[1][i] = Test_random();
+    }
+    SSD1306_widgetLabel(&widgets[0], &mDevice, 0, 0, 10);
+    SSD1306_widgetProgress(&widgets[1], &mDevice, 0, 12, 100, 8, 0, 98);
+    SSD1306_widgetGauge(&widgets[2], &mDevice, 0, 30, 20, 0, 64);
+    SSD1306_widgetIcon(&widgets[3], &mDevice, 100, 40, 16, 16, iconSet, 2);
+    SSD1306_widgetSetText(&widgets[0], "TEMP 21.5");
+    SSD1306_widgetSetValue(&widgets[1], 40);
+    SSD1306_widgetSetValue(&widgets[2], 20);
+    for (uint8_t i = 0; i < 4; ++i)
+        SSD1306_widgetUpdate(&widgets[i]);
+
+    // Only the changed part is sent
+    uint32_t start = Test_startScenario(&mDevice);
+    SSD1306_widgetSetText(&widgets[0], "TEMP 21 5");
+    SSD1306_widgetUpdate(&widgets[0]);
+    Test_checkBudget(&label, &mDevice, start);
+
+    start = Test_startScenario(&mDevice);
+    SSD1306_widgetSetValue(&widgets[1], 41);
+    SSD1306_widgetUpdate(&widgets[1]);
+    Test_checkBudget(&progress, &mDevice, start);
+
+    start = Test_startScenario(&mDevice);
+    SSD1306_widgetSetValue(&widgets[2], 21);
+    SSD1306_widgetUpdate(&widgets[2]);
+    Test_checkBudget(&gauge, &mDevice, start);
+
+    start = Test_startScenario(&mDevice);
+    SSD1306_widgetSetValue(&widgets[3], 1);
+    SSD1306_widgetUpdate(&widgets[3]);
+    Test_checkBudget(&icon, &mDevice, start);
+    checkDisplay(icon.name, 0, 0, 128, 64);
+}
+
+static void testFade (void)
+{
+    static const Test_Budget_t fadeOut = { "fadeOut 1 s with steps of 20 ms", 52, 103, 1000 };
+    static SSD1306_Fade_t fade;
+
+    Test_initDevice(&mDevice, SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1);
+    SSD1306_setContrast(&mDevice, 0xFF);
+    SSD1306_fadeInit(&fade, &mDevice, 20);
+
+    // One contrast command for each step, the display OFF at the end
+    uint32_t start = Test_startScenario(&mDevice);
+    SSD1306_fadeOut(&fade, 1000);
+    for (uint16_t i = 0; i <= 1000; ++i)
+    {
+        SSD1306_fadeProcess(&fade);
+        Simulator_advance(1);
+    }
+    Test_checkBudget(&fadeOut, &mDevice, start);
+    TEST_CHECK((Simulator_get()->contrast == 0) && !Simulator_get()->isOn, "%s: contrast %u, display on %d",
+               fadeOut.name, Simulator_get()->contrast, Simulator_get()->isOn);
+}
+
+static void testCanvas (void)
+{
+    static const Test_Budget_t pan = { "canvas pan by 1 column", 9, 1030, 1000 };
+    static uint8_t buffer [SSD1306_CANVAS_SIZE(512, 64)];
+    SSD1306_Canvas_t canvas;
+
+    Test_initDevice(&mDevice, SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1);
+    Test_seed(0xCA4);
+    SSD1306_canvasInit(&canvas, buffer, 512, 64);
+    SSD1306_canvasAddPanel(&canvas, &mDevice);
+    for (uint32_t i = 0; i < sizeof(buffer); ++i)
+        buffer[i] = Test_random();
+    SSD1306_canvasUpdate(&canvas);
+
+    // A chart that scrolls: one new column after the right edge, then the
+    // viewport moves. The panel is sent full width, only one column is copied
+    uint32_t start = Test_startScenario(&mDevice);
+    SSD1306_canvasFillRectangle(&canvas, 128, 0, 1, 64, SSD1306_COLOR_BLACK);
+    SSD1306_canvasDrawPixel(&canvas, 128, Test_range(0, 63), SSD1306_COLOR_COLOR);
+    SSD1306_canvasPan(&canvas, 1, 0);
+    SSD1306_canvasUpdate(&canvas);
+    Test_checkBudget(&pan, &mDevice, start);
+    checkDisplay(pan.name, 0, 0, 128, 64);
+}
+
+static void testGovernor (void)
+{
+    static const Test_Budget_t merged = { "governor 50 ms of requests", 4, 80, 1000 };
+
+    Test_initDevice(&mDevice, SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1);
+    Test_seed(0x60F);
+    SSD1306_setFrameRate(&mDevice, 25, 50);
+    SSD1306_processFlush(&mDevice);
+
+    // The small updates of 50 ms are sent with two frames at 25 fps
+    fillRandom();
+    uint32_t start = Test_startScenario(&mDevice);
+    for (uint8_t i = 0; i < 50; ++i)
+    {
+        SSD1306_flushArea(&mDevice, 40 + (i % 10), 8 + (i % 20), 10, 4);
+        Simulator_advance(1);
+        SSD1306_processFlush(&mDevice);
+    }
+    Test_checkBudget(&merged, &mDevice, start);
+    checkDisplay(merged.name, 40, 8, 19, 23);
+    // The mirror is sent at once, the buffer with the next frame
+    static const Test_Budget_t mirror = { "governor setOrientation", 2, 2, 1000 };
+    static const Test_Budget_t frame  = { "governor frame after setOrientation", 9, 1030, 1000 };
+    Simulator_advance(100);
+    SSD1306_processFlush(&mDevice);
+    start = Test_startScenario(&mDevice);
+    SSD1306_setOrientation(&mDevice, SSD1306_ORIENTATION_MIRROR_X);
+    Test_checkBudget(&mirror, &mDevice, start);
+    TEST_CHECK(Simulator_get()->isSegmentRemap != mDevice.isSegmentRemap, "%s: no segment re-map", mirror.name);
+
+    Simulator_advance(100);
+    start = Test_startScenario(&mDevice);
+    SSD1306_processFlush(&mDevice);
+    Test_checkBudget(&frame, &mDevice, start);
+    checkDisplay(frame.name, 0, 0, 128, 64);
+}
+
+static void testCommands (void)
+{
+    static const Test_Budget_t contrast = { "setContrast", 1, 2, 1000 };
+
+    Test_initDevice(&mDevice, SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1);
+    uint32_t start = Test_startScenario(&mDevice);
+    SSD1306_setContrast(&mDevice, 0x42);
+    Test_checkBudget(&contrast, &mDevice, start);
+    TEST_CHECK(Simulator_get()->contrast == 0x42, "%s: contrast 0x%02X", contrast.name, Simulator_get()->contrast);
+
+    // The charge pump is stopped and started only when the product uses it
+    static const Test_Budget_t suspendPump  = { "suspend with charge pump", 2, 3, 1000 };
+    static const Test_Budget_t resumePump   = { "resume with charge pump",  2, 3, 1000 };
+    static const Test_Budget_t suspendPanel = { "suspend without charge pump", 1, 1, 1000 };
+    static const Test_Budget_t resumePanel  = { "resume without charge pump",  1, 1, 1000 };
+
+    start = Test_startScenario(&mDevice);
+    SSD1306_suspend(&mDevice);
+    Test_checkBudget(&suspendPanel, &mDevice, start);
+    start = Test_startScenario(&mDevice);
+    SSD1306_resume(&mDevice);
+    Test_checkBudget(&resumePanel, &mDevice, start);
+    TEST_CHECK(Simulator_get()->isOn && !Simulator_get()->isChargePump, "%s: wrong state", resumePanel.name);
+
+    Test_initDevice(&mDevice, SSD1306_PRODUCT_ADAFRUIT_931);
+    // The initialization does not send the charge pump setting: running
+    Simulator_get()->isChargePump = TRUE;
+    start = Test_startScenario(&mDevice);
+    SSD1306_suspend(&mDevice);
+    Test_checkBudget(&suspendPump, &mDevice, start);
+    TEST_CHECK(!Simulator_get()->isOn && !Simulator_get()->isChargePump, "%s: wrong state", suspendPump.name);
+    start = Test_startScenario(&mDevice);
+    SSD1306_resume(&mDevice);
+    Test_checkBudget(&resumePump, &mDevice, start);
+    TEST_CHECK(Simulator_get()->isOn && Simulator_get()->isChargePump, "%s: wrong state", resumePump.name);
+
+    // After a power loss the configuration and the whole buffer are sent
+    static const Test_Budget_t restore = { "restore 128x32", 25, 540, 1000 };
+    fillRandom();
+    Simulator_reset();
+    start = Test_startScenario(&mDevice);
+    SSD1306_restore(&mDevice);
+    Test_checkBudget(&restore, &mDevice, start);
+    TEST_CHECK(Simulator_get()->isOn && Simulator_get()->isChargePump, "%s: wrong state", restore.name);
+    checkDisplay(restore.name, 0, 0, 128, 32);
+}
+
+static void testDrawing (void)
+{
+    static const Test_Budget_t circles    = { "draw 1000 circles",    0, 0, 20000 };
+    static const Test_Budget_t polygons   = { "draw 1000 triangles",  0, 0, 20000 };
+    static const Test_Budget_t rectangles = { "draw 1000 rectangles", 0, 0, 20000 };
+    static const Test_Budget_t lines      = { "draw 1000 lines",      0, 0, 20000 };
+
+    Test_initDevice(&mDevice, SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1);
+    Test_seed(0xD4A7);
+    SSD1306_scrollLines(&mDevice, 3);
+
+    uint32_t start = Test_startScenario(&mDevice);
+    for (uint32_t i = 0; i < BUDGET_DRAW_COUNT; ++i)
+        SSD1306_fillCircle(&mDevice, Test_range(-10, 137), Test_range(-10, 73), Test_range(0, 40), i & 0x01);
+    Test_checkBudget(&circles, &mDevice, start);
+
+    start = Test_startScenario(&mDevice);
+    for (uint32_t i = 0; i < BUDGET_DRAW_COUNT; ++i)
+        SSD1306_fillTriangle(&mDevice, Test_range(-10, 137), Test_range(-10, 73),
+                             Test_range(-10, 137), Test_range(-10, 73),
+                             Test_range(-10, 137), Test_range(-10, 73), i & 0x01);
+    Test_checkBudget(&polygons, &mDevice, start);
+
+    start = Test_startScenario(&mDevice);
+    for (uint32_t i = 0; i < BUDGET_DRAW_COUNT; ++i)
+        SSD1306_drawRectangle(&mDevice, Test_range(0, 127), Test_range(0, 63),
+                              Test_range(1, 128), Test_range(1, 64), i & 0x01, i & 0x02);
+    Test_checkBudget(&rectangles, &mDevice, start);
+
+    start = Test_startScenario(&mDevice);
+    for (uint32_t i = 0; i < BUDGET_DRAW_COUNT; ++i)
+        SSD1306_drawLine(&mDevice, Test_range(0, 127), Test_range(0, 63),
+                         Test_range(0, 127), Test_range(0, 63), i & 0x01);
+    Test_checkBudget(&lines, &mDevice, start);
+}
+
+int main (void)
+{
+    testFlush();
+    testFlushSmall();
+    testRegions();
+    testConsole();
+    testPlot();
+    testSprite();
+    testText();
+    testWidgets();
+    testFade();
+    testCanvas();
+    testGovernor();
+    testCommands();
+    testDrawing();
+
+#if defined (SSD1306_REFERENCE_RENDERER)
+    return Test_end("budget (reference renderer)");
+#else
+    return Test_end("budget");
+#endif
+}
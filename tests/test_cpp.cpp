@@ -0,0 +1,243 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+/*!
+ * \file  /tests/test_cpp.cpp
+ * \brief C++ front-end against the C API.
+ *
+ * The drawing of single pixels and the full flush of ssd1306::Display are
+ * compared with the C functions: the buffer must be the same, with random
+ * clip areas and start lines, and the display must show the buffer, also
+ * when the visible lines wrap around the end of the display RAM. The C API
+ * is used on the handle of the display between the C++ calls. Then the
+ * pixels and the flush of both are timed, and the gain is printed.
+ */
+
+#include "harness.h"
+#include "ssd1306.hpp"
+
+#define CPP_CASES                                2000
+#define CPP_BENCHMARK_FRAMES                     400
+#define CPP_BENCHMARK_FLUSHES                    20000
+
+/*! The C++ pixels must not be slower than the C ones, in per cent */
+#define CPP_PIXEL_RATIO                          100
+
+static SSD1306_Device_t mDevice;
+static int mBus;
+
+template <uint8_t Width, uint8_t Height>
+using IicDisplay = ssd1306::Display<Width, Height, ssd1306::IicTransport>;
+
+static SSD1306_Config_t getConfig (uint16_t product)
+{
+    SSD1306_Config_t config;
+
+    memset(&config, 0, sizeof(config));
+    config.product = product;
+    config.iicDev  = reinterpret_cast<Iic_DeviceHandle>(&mBus);
+    return config;
+}
+
+/*!
+ * The function checks that the display shows the visible lines of the
+ * buffer.
+ */
+static void checkDisplay (SSD1306_DeviceHandle_t dev, const char* name, uint32_t index)
+{
+    TEST_CHECK(Simulator_get()->errors == 0, "%s %u: transactions rejected", name, index);
+    for (uint8_t y = 0; y < dev->gdl.height; ++y)
+    {
+        for (uint8_t x = 0; x < dev->gdl.width; ++x)
+        {
+            if (Simulator_getPixel(x, y) != Test_getBufferPixel(dev, x, y))
+            {
+                TEST_CHECK(false, "%s %u: display pixel %u,%u", name, index, x, y);
+                return;
+            }
+        }
+    }
+}
+
+template <uint8_t Width, uint8_t Height>
+static void testDisplay (uint16_t product, const char* name)
+{
+    // The same device through the C API; the simulated controller belongs
+    // to the C++ display, it is saved around the few C transfers
+    Test_initDevice(&mDevice, product);
+
+    Simulator_reset();
+    SSD1306_Config_t config = getConfig(product);
+    IicDisplay<Width, Height> display(config);
+    SSD1306_DeviceHandle_t dev = display.handle();
+
+    for (uint32_t i = 0; i < CPP_CASES; ++i)
+    {
+        switch (Test_range(0, 9))
+        {
+        case 0:
+        {
+            uint8_t lines = Test_range(0, 63);
+            SSD1306_scrollLines(dev, lines);
+            SSD1306_scrollLines(&mDevice, lines);
+            break;
+        }
+        case 1:
+        {
+            uint16_t x = Test_range(0, Width + 8), y = Test_range(0, Height + 8);
+            uint16_t w = Test_range(0, Width), h = Test_range(0, Height);
+            SSD1306_pushClip(dev, x, y, w, h);
+            SSD1306_pushClip(&mDevice, x, y, w, h);
+            break;
+        }
+        case 2:
+            SSD1306_resetClip(dev);
+            SSD1306_resetClip(&mDevice);
+            break;
+        case 3:
+        {
+            // The C API on the handle: the planner may change the addressing
+            // mode under the C++ flush
+            uint16_t x = Test_range(0, Width - 1), y = Test_range(0, Height - 1);
+            uint16_t w = Test_range(1, 16), h = Test_range(1, Height);
+            SSD1306_fillCircle(dev, x, y, w, SSD1306_COLOR_COLOR);
+            SSD1306_fillCircle(&mDevice, x, y, w, SSD1306_COLOR_COLOR);
+            SSD1306_flushArea(dev, x, y, w, h);
+            break;
+        }
+        default:
+            for (uint8_t n = 0; n < 50; ++n)
+            {
+                uint8_t x = Test_range(0, Width + 4), y = Test_range(0, Height + 4);
+                SSD1306_Color_t color = Test_range(0, 1) ? SSD1306_COLOR_COLOR : SSD1306_COLOR_BLACK;
+                display.drawPixel(x, y, color);
+                SSD1306_drawPixel(&mDevice, x, y, color);
+            }
+            break;
+        }
+
+        if (memcmp(display.buffer(), mDevice.buffer, display.bufferSize) != 0)
+        {
+            TEST_CHECK(false, "%s %u: the buffer is not the C one", name, i);
+            return;
+        }
+
+        uint8_t x = Test_range(0, Width - 1), y = Test_range(0, Height - 1);
+        TEST_CHECK((display.getPixel(x, y) == SSD1306_COLOR_COLOR) == Test_getBufferPixel(&mDevice, x, y),
+                   "%s %u: pixel %u,%u", name, i, x, y);
+
+        if (Test_range(0, 7) == 0)
+        {
+            // The C++ flush sends what the C one sends
+            SSD1306_resetStatistics(dev);
+            Simulator_resetCounters();
+            display.flush();
+            checkDisplay(dev, name, i);
+            SSD1306_Statistics_t cpp = dev->statistics;
+            Simulator_Controller_t* c = Simulator_get();
+            TEST_CHECK((cpp.transactions == c->transactions) && (cpp.commandBytes == c->commandBytes) &&
+                       (cpp.dataBytes == c->dataBytes), "%s %u: statistics are not the bus", name, i);
+
+            Simulator_Controller_t saved = *c;
+            SSD1306_flush(&mDevice);
+            *c = saved;
+            TEST_CHECK(cpp.dataBytes == mDevice.statistics.dataBytes, "%s %u: %u data bytes, C %u",
+                       name, i, (unsigned)cpp.dataBytes, (unsigned)mDevice.statistics.dataBytes);
+            TEST_CHECK(cpp.transactions <= mDevice.statistics.transactions, "%s %u: %u transactions, C %u",
+                       name, i, (unsigned)cpp.transactions, (unsigned)mDevice.statistics.transactions);
+            SSD1306_resetStatistics(&mDevice);
+        }
+    }
+}
+
+static void benchmark (void)
+{
+    Test_initDevice(&mDevice, SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1);
+    Simulator_reset();
+    SSD1306_Config_t config = getConfig(SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1);
+    IicDisplay<128, 64> display(config);
+
+    // The same start line, so the pixels need the remap
+    SSD1306_scrollLines(display.handle(), 5);
+    SSD1306_scrollLines(&mDevice, 5);
+
+    uint32_t pixels = CPP_BENCHMARK_FRAMES * 128u * 64u;
+    uint32_t start = Test_now();
+    for (uint32_t frame = 0; frame < CPP_BENCHMARK_FRAMES; ++frame)
+        for (uint8_t y = 0; y < 64; ++y)
+            for (uint8_t x = 0; x < 128; ++x)
+                SSD1306_drawPixel(&mDevice, x, y, ((x ^ y ^ frame) & 1) ? SSD1306_COLOR_COLOR : SSD1306_COLOR_BLACK);
+    uint32_t cTime = Test_now() - start + 1;
+
+    start = Test_now();
+    for (uint32_t frame = 0; frame < CPP_BENCHMARK_FRAMES; ++frame)
+        for (uint8_t y = 0; y < 64; ++y)
+            for (uint8_t x = 0; x < 128; ++x)
+                display.drawPixel(x, y, ((x ^ y ^ frame) & 1) ? SSD1306_COLOR_COLOR : SSD1306_COLOR_BLACK);
+    uint32_t cppTime = Test_now() - start + 1;
+
+    // The work is used, so it is not removed
+    TEST_CHECK(memcmp(display.buffer(), mDevice.buffer, display.bufferSize) == 0, "benchmark: the buffers differ");
+
+    printf("drawPixel   C %7.1f Mpixel/s   C++ %7.1f Mpixel/s   gain x%.2f\n",
+           (double)pixels / cTime, (double)pixels / cppTime, (double)cTime / cppTime);
+    TEST_CHECK((cppTime * 100) <= (cTime * CPP_PIXEL_RATIO), "benchmark: C++ pixels %u us, C %u us",
+               (unsigned)cppTime, (unsigned)cTime);
+
+    SSD1306_resetStatistics(&mDevice);
+    start = Test_now();
+    for (uint32_t i = 0; i < CPP_BENCHMARK_FLUSHES; ++i)
+        SSD1306_flush(&mDevice);
+    cTime = Test_now() - start + 1;
+    SSD1306_Statistics_t cStatistics = mDevice.statistics;
+
+    SSD1306_resetStatistics(display.handle());
+    start = Test_now();
+    for (uint32_t i = 0; i < CPP_BENCHMARK_FLUSHES; ++i)
+        display.flush();
+    cppTime = Test_now() - start + 1;
+    SSD1306_Statistics_t cppStatistics = display.handle()->statistics;
+
+    printf("flush       C %7.2f us           C++ %7.2f us           gain x%.2f\n",
+           (double)cTime / CPP_BENCHMARK_FLUSHES, (double)cppTime / CPP_BENCHMARK_FLUSHES, (double)cTime / cppTime);
+    printf("            C %u transactions %u bytes, C++ %u transactions %u bytes for each flush\n",
+           (unsigned)(cStatistics.transactions / CPP_BENCHMARK_FLUSHES),
+           (unsigned)((cStatistics.commandBytes + cStatistics.dataBytes) / CPP_BENCHMARK_FLUSHES),
+           (unsigned)(cppStatistics.transactions / CPP_BENCHMARK_FLUSHES),
+           (unsigned)((cppStatistics.commandBytes + cppStatistics.dataBytes) / CPP_BENCHMARK_FLUSHES));
+    TEST_CHECK(cppStatistics.dataBytes == cStatistics.dataBytes, "benchmark: the flushes send different data");
+    checkDisplay(display.handle(), "benchmark", 0);
+}
+
+int main (void)
+{
+    Test_seed(0x40);
+    testDisplay<128, 64>(SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1, "128x64");
+    testDisplay<128, 32>(SSD1306_PRODUCT_ADAFRUIT_931, "128x32");
+    benchmark();
+    return Test_end("cpp");
+}
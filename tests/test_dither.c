@@ -0,0 +1,203 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+/*!
+ * \file  /tests/test_dither.c
+ * \brief Comparison of the dithering kernels with the reference, and their
+ *        throughput.
+ *
+ * The pictures are drawn at random positions, with random clip areas and
+ * start lines, and compared with the reference one pixel at time. Then the
+ * throughput of every kernel is measured on full frames, together with the
+ * throughput of a row-major bitmap sent with SSD1306_drawPicture.
+ */
+
+#include "harness.h"
+#include "reference.h"
+
+#define DITHER_CASES                             3000
+#define DITHER_FRAMES                            2000
+#define DITHER_MAX_SIDE                          96
+
+static SSD1306_Device_t mDevice;
+static Reference_Screen_t mScreen;
+static uint8_t mPicture [DITHER_MAX_SIDE * DITHER_MAX_SIDE];
+
+static const char* mNames [] = { "threshold", "Bayer", "Floyd-Steinberg" };
+
+/*!
+ * The function fills the picture with noise, a gradient or flat areas.
+ */
+static void fillPicture (int32_t width, int32_t height)
+{
+    int32_t kind = Test_range(0, 2);
+    uint8_t level = Test_random();
+
+    for (int32_t y = 0; y < height; ++y)
+    {
+        for (int32_t x = 0; x < width; ++x)
+        {
+            uint8_t* pixel = &mPicture[y * width + x];
+            if (kind == 0)      *pixel = Test_random();
+            else if (kind == 1) *pixel = (uint8_t)((x * 255) / width + (y * 3));
+            else                *pixel = ((x / 7 + y / 5) % 2) ? level : (255 - level);
+        }
+    }
+}
+
+static void testCorrectness (uint16_t product)
+{
+    Test_initDevice(&mDevice, product);
+    Reference_init(&mScreen, mDevice.gdl.width, mDevice.gdl.height);
+    Test_seed(0xD17E + product);
+
+    for (uint32_t i = 0; i < DITHER_CASES; ++i)
+    {
+        SSD1306_Dither_t dither = (SSD1306_Dither_t)(i % 3);
+        int32_t width  = Test_range(1, DITHER_MAX_SIDE);
+        int32_t height = Test_range(1, DITHER_MAX_SIDE);
+        int32_t xPos   = Test_range(0, mScreen.width + 2);
+        int32_t yPos   = Test_range(0, mScreen.height + 2);
+
+        // Random start line, background and clip area
+        SSD1306_resetClip(&mDevice);
+        SSD1306_scrollLines(&mDevice, Test_range(0, 63));
+        for (uint32_t k = 0; k < SSD1306_BUFFER_DIMENSION; ++k)
+            mDevice.buffer[k] = Test_random();
+        Reference_setClip(&mScreen, 0, 0, mScreen.width, mScreen.height);
+        for (int32_t y = 0; y < mScreen.height; ++y)
+            for (int32_t x = 0; x < mScreen.width; ++x)
+                mScreen.pixels[y][x] = Test_getBufferPixel(&mDevice, x, y);
+        if (Test_range(0, 1))
+        {
+            int32_t x = Test_range(0, mScreen.width - 1), y = Test_range(0, mScreen.height - 1);
+            int32_t w = Test_range(1, mScreen.width - x), h = Test_range(1, mScreen.height - y);
+            SSD1306_pushClip(&mDevice, x, y, w, h);
+            Reference_setClip(&mScreen, x, y, x + w, y + h);
+        }
+
+        fillPicture(width, height);
+        SSD1306_drawGrayscale(&mDevice, xPos, yPos, width, height, mPicture, dither);
+        Reference_drawGrayscale(&mScreen, xPos, yPos, width, height, mPicture, dither);
+
+        for (int32_t y = 0; y < mScreen.height; ++y)
+        {
+            for (int32_t x = 0; x < mScreen.width; ++x)
+            {
+                if (Reference_getPixel(&mScreen, x, y) != Test_getBufferPixel(&mDevice, x, y))
+                {
+                    TEST_CHECK(FALSE, "case %u, %s %dx%d at %d,%d, clip %u,%u-%u,%u, start line %u: pixel %d,%d",
+                               (unsigned)i, mNames[dither], width, height, xPos, yPos,
+                               mDevice.clip.xStart, mDevice.clip.yStart, mDevice.clip.xStop,
+                               mDevice.clip.yStop, mDevice.startLine, x, y);
+                    y = mScreen.height;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/*!
+ * The function converts a grayscale picture to a row-major bitmap with the
+ * Bayer matrix, as it was done before the kernels.
+ */
+static void convertBitmap (const uint8_t* picture, uint8_t* bitmap, int32_t width, int32_t height)
+{
+    static const uint8_t bayer [8][8] =
+    {
+        {  0, 32,  8, 40,  2, 34, 10, 42 },
+        { 48, 16, 56, 24, 50, 18, 58, 26 },
+        { 12, 44,  4, 36, 14, 46,  6, 38 },
+        { 60, 28, 52, 20, 62, 30, 54, 22 },
+        {  3, 35, 11, 43,  1, 33,  9, 41 },
+        { 51, 19, 59, 27, 49, 17, 57, 25 },
+        { 15, 47,  7, 39, 13, 45,  5, 37 },
+        { 63, 31, 55, 23, 61, 29, 53, 21 },
+    };
+    int32_t stride = (width + 7) / 8;
+
+    memset(bitmap, 0, stride * height);
+    for (int32_t y = 0; y < height; ++y)
+        for (int32_t x = 0; x < width; ++x)
+            if (picture[y * width + x] > (bayer[y % 8][x % 8] * 4 + 2))
+                bitmap[y * stride + x / 8] |= 0x80 >> (x % 8);
+}
+
+static double getThroughput (uint32_t pixels, uint32_t microseconds)
+{
+    return (microseconds > 0) ? ((double)pixels / microseconds) : 0.0;
+}
+
+static void testThroughput (void)
+{
+    // Minimum throughput of the kernels, in Mpixel/s, and the same budget
+    // expressed as CPU time of the frames
+    static const double minimum = 10.0;
+    static uint8_t bitmap [SSD1306_MAX_DISPLAY_WIDTH * SSD1306_MAX_DISPLAY_HEIGHT / 8];
+
+    Test_initDevice(&mDevice, SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1);
+    Test_seed(0xFA57);
+    int32_t width  = mDevice.gdl.width;
+    int32_t height = mDevice.gdl.height;
+    uint32_t pixels = (uint32_t)width * height * DITHER_FRAMES;
+    for (int32_t i = 0; i < width * height; ++i)
+        mPicture[i] = Test_random();
+
+    for (uint8_t d = 0; d < 3; ++d)
+    {
+        Test_Budget_t budget = { mNames[d], 0, 0, (uint32_t)(pixels / minimum) };
+        uint32_t start = Test_startScenario(&mDevice);
+        for (uint32_t frame = 0; frame < DITHER_FRAMES; ++frame)
+        {
+            mPicture[frame % (width * height)] ^= 0x55;
+            SSD1306_drawGrayscale(&mDevice, 0, 0, width, height, mPicture, (SSD1306_Dither_t)d);
+        }
+        uint32_t elapsed = Test_now() - start;
+        printf("%-16s %8.1f Mpixel/s\n", mNames[d], getThroughput(pixels, elapsed));
+        Test_checkBudget(&budget, &mDevice, start);
+    }
+
+    uint32_t start = Test_now();
+    for (uint32_t frame = 0; frame < DITHER_FRAMES; ++frame)
+    {
+        mPicture[frame % (width * height)] ^= 0x55;
+        convertBitmap(mPicture, bitmap, width, height);
+        SSD1306_drawPicture(&mDevice, 0, 0, width, height, bitmap);
+    }
+    printf("%-16s %8.1f Mpixel/s (row-major bitmap and drawPicture)\n", "Bayer",
+           getThroughput(pixels, Test_now() - start));
+}
+
+int main (void)
+{
+    testCorrectness(SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1);
+    testCorrectness(SSD1306_PRODUCT_ADAFRUIT_931);
+    testThroughput();
+
+    return Test_end("dither");
+}
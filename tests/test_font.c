@@ -0,0 +1,354 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+/*!
+ * \file  /tests/test_font.c
+ * \brief Checks of the proportional font engine with the small font.
+ *
+ * The measure and the line fitting are checked on ASCII, multi-byte and
+ * wrong UTF-8 strings, with the expected widths computed by hand from the
+ * advances of the glyphs. The text lines and boxes are built from tokens
+ * with known code points, drawn on a random background with a random start
+ * line, and compared pixel by pixel with the reference.
+ */
+
+#include "harness.h"
+#include "reference.h"
+#include "ssd1306fontsmall.h"
+
+#include <string.h>
+
+#define FONT_STEPS                               3000
+#define FONT_MAX_TOKENS                          40
+
+/*!
+ * A piece of UTF-8 text, with the code point decoded from it.
+ */
+typedef struct _Font_Token_t
+{
+    const char* text;
+    uint32_t code;
+} Font_Token_t;
+
+static const Font_Token_t mTokens [] =
+{
+    { "A", 'A' }, { "b", 'b' }, { "W", 'W' }, { "i", 'i' }, { "j", 'j' }, { "m", 'm' },
+    { "0", '0' }, { "7", '7' }, { ".", '.' }, { "?", '?' }, { "~", '~' }, { "|", '|' },
+    { " ", ' ' }, { " ", ' ' }, { " ", ' ' }, { " ", ' ' }, { "\n", '\n' },
+    { "\xC2\xB0", 0x00B0 },      // Degree sign
+    { "\xC2\xB5", 0x00B5 },      // Micro sign
+    { "\xE2\x82\xAC", 0x20AC },  // Euro sign
+    { "\xE2\x86\x92", 0x2192 },  // Rightwards arrow
+    { "\xE4\xB8\xAD", 0x4E2D },  // Missing into the font
+    { "\xFF", 0xFFFD },          // Wrong first byte
+    { "\x80", 0xFFFD },          // Continuation byte without start
+    { "\xE2\x82", 0xFFFD },      // Truncated sequence
+};
+
+static SSD1306_Device_t mDevice;
+static Reference_Screen_t mScreen;
+
+static char mText [FONT_MAX_TOKENS * 3 + 1];
+static uint32_t mCodes [FONT_MAX_TOKENS];
+static uint16_t mPositions [FONT_MAX_TOKENS + 1];   // First byte of every token
+static int32_t mCount;
+
+/*!
+ * The function builds a random text, at the end mPositions[mCount] is its
+ * length.
+ */
+static void buildText (void)
+{
+    mCount = Test_range(0, FONT_MAX_TOKENS);
+    mPositions[0] = 0;
+    for (int32_t i = 0; i < mCount; ++i)
+    {
+        const Font_Token_t* token = &mTokens[Test_range(0, sizeof(mTokens) / sizeof(mTokens[0]) - 1)];
+
+        // A continuation byte after a truncated sequence would complete it
+        if ((token->text[0] == '\x80') && (i > 0) && ((mPositions[i] - mPositions[i - 1]) == 2) &&
+            (mCodes[i - 1] == 0xFFFD))
+            token = &mTokens[0];
+        mCodes[i] = token->code;
+        strcpy(&mText[mPositions[i]], token->text);
+        mPositions[i + 1] = mPositions[i] + strlen(token->text);
+    }
+    mText[mPositions[mCount]] = '\0';
+}
+
+static int32_t getAdvance (uint32_t code)
+{
+    return SSD1306_getGlyph(&SSD1306_FONT_SMALL, code)->advance;
+}
+
+/*!
+ * The function prepares a check: random background and start line.
+ */
+static void beginCase (void)
+{
+    SSD1306_resetClip(&mDevice);
+    SSD1306_scrollLines(&mDevice, Test_range(0, SIMULATOR_ROWS - 1));
+    for (uint32_t i = 0; i < SSD1306_BUFFER_DIMENSION; ++i)
+        mDevice.buffer[i] = Test_random();
+
+    Reference_setClip(&mScreen, 0, 0, mScreen.width, mScreen.height);
+    for (int32_t y = 0; y < mScreen.height; ++y)
+        for (int32_t x = 0; x < mScreen.width; ++x)
+            mScreen.pixels[y][x] = Test_getBufferPixel(&mDevice, x, y);
+}
+
+static void endCase (const char* operation)
+{
+    for (int32_t y = 0; y < mScreen.height; ++y)
+    {
+        for (int32_t x = 0; x < mScreen.width; ++x)
+        {
+            if (Reference_getPixel(&mScreen, x, y) != Test_getBufferPixel(&mDevice, x, y))
+            {
+                TEST_CHECK(FALSE, "%s, start line %u: pixel %d,%d is %d",
+                           operation, mDevice.startLine, x, y, !Reference_getPixel(&mScreen, x, y));
+                return;
+            }
+        }
+    }
+}
+
+static void testGlyphs (void)
+{
+    const SSD1306_Font_t* font = &SSD1306_FONT_SMALL;
+    const SSD1306_FontGlyph_t* fallback = &font->glyphs[font->fallback];
+
+    TEST_CHECK(fallback->code == 0xFFFD, "fallback glyph U+%04X", fallback->code);
+    TEST_CHECK(SSD1306_getGlyph(font, 'A')->code == 'A', "direct glyph");
+    TEST_CHECK(SSD1306_getGlyph(font, '~')->code == '~', "last direct glyph");
+    TEST_CHECK(SSD1306_getGlyph(font, 0x00B0)->code == 0x00B0, "first sparse glyph");
+    TEST_CHECK(SSD1306_getGlyph(font, 0x20AC)->code == 0x20AC, "sparse glyph");
+    TEST_CHECK(SSD1306_getGlyph(font, 0x4E2D) == fallback, "missing glyph");
+    TEST_CHECK(SSD1306_getGlyph(font, 0x1F) == fallback, "glyph before the direct range");
+    TEST_CHECK(SSD1306_getGlyph(font, 0x7F) == fallback, "glyph after the direct range");
+    TEST_CHECK(SSD1306_getGlyph(font, 0x1F600) == fallback, "glyph after the sparse codes");
+
+    // The sparse glyphs must be sorted for the binary search
+    for (uint16_t i = font->directCount + 1; i < font->glyphCount; ++i)
+        TEST_CHECK(font->glyphs[i - 1].code < font->glyphs[i].code, "glyph %u not sorted", i);
+}
+
+static void testMeasure (void)
+{
+    static const struct
+    {
+        const char* text;
+        uint16_t width;
+    } cases [] =
+    {
+        { "",                     0 },
+        { "Hi",                   5 + 2 },
+        { "A b",                  5 + 3 + 5 },
+        { "AB\nCD",               5 + 5 },
+        { "\xC2\xB0" "C",         4 + 5 },
+        { "\xE2\x86\x92",         6 },
+        { "1\xE2\x82\xAC",        4 + 5 },
+        { "\xE4\xB8\xAD",         5 },
+        { "\xFF",                 5 },
+        { "\x80" "A",             5 + 5 },
+        { "\xE2\x82" "A",         5 + 5 },
+        { "\xF0\x9F\x98\x80",     5 },
+        { "\xC2",                 5 },
+    };
+
+    for (uint32_t i = 0; i < (sizeof(cases) / sizeof(cases[0])); ++i)
+    {
+        uint16_t width = SSD1306_measureString(&SSD1306_FONT_SMALL, cases[i].text);
+        TEST_CHECK(width == cases[i].width, "measureString case %u: width %u, expected %u",
+                   (unsigned)i, width, cases[i].width);
+    }
+}
+
+static void testFit (void)
+{
+    static const struct
+    {
+        const char* text;
+        uint16_t maxWidth;
+        uint16_t length;
+        uint16_t width;
+    } cases [] =
+    {
+        { "AB CD",                           30,  5, 23 },
+        { "AB CD",                           12,  2, 10 },
+        { "AB  ",                            30,  2, 10 },
+        // A word longer than the line is broken after the last glyph that fits
+        { "ABCDEFGHIJ",                      12,  2, 10 },
+        { "ABCDEFGHIJ",                      50, 10, 49 },
+        { "ABCDEFGHIJ",                       4,  0,  0 },
+        // It goes to the next line, when a word fits before it
+        { "I ABCDEFGHIJKLMN",                30,  1,  4 },
+        { "  ABCDEFGHIJ",                    12,  3, 11 },
+        // The multi-byte glyphs are never cut
+        { "\xE2\x82\xAC\xE2\x82\xAC\xE2\x82\xAC", 12, 6, 10 },
+        { "\xC2\xB0\xC2\xB0 \xC2\xB0",       10,  4,  8 },
+        { "\xFF\xFF\xFF",                    11,  2, 10 },
+        { "AB\nCD",                          30,  2, 10 },
+    };
+
+    for (uint32_t i = 0; i < (sizeof(cases) / sizeof(cases[0])); ++i)
+    {
+        uint16_t width = 0xFFFF;
+        uint16_t length = SSD1306_fitString(&SSD1306_FONT_SMALL, cases[i].text, cases[i].maxWidth, &width);
+        TEST_CHECK((length == cases[i].length) && (width == cases[i].width),
+                   "fitString case %u: %u bytes with width %u, expected %u with width %u",
+                   (unsigned)i, length, width, cases[i].length, cases[i].width);
+    }
+}
+
+/*!
+ * The function fits a line of tokens like the documentation of
+ * SSD1306_fitString, without decode the text.
+ *
+ * \return The token after the fitting part.
+ */
+static int32_t fitTokens (int32_t first, int32_t maxWidth)
+{
+    int32_t current = 0, fit = first;
+    bool isWord = FALSE;
+    int32_t i = first;
+
+    for (; (i < mCount) && (mCodes[i] != '\n'); ++i)
+    {
+        int32_t advance = getAdvance(mCodes[i]);
+        if (mCodes[i] == ' ')
+        {
+            if (isWord) fit = i;
+            isWord = FALSE;
+        }
+        else
+        {
+            if ((current + advance) > maxWidth)
+                return (fit == first) ? i : fit;
+            isWord = TRUE;
+        }
+        current += advance;
+    }
+    return isWord ? i : fit;
+}
+
+static void testDrawText (void)
+{
+    char operation [64];
+
+    for (uint32_t step = 0; step < FONT_STEPS; ++step)
+    {
+        buildText();
+        beginCase();
+
+        int32_t x = Test_range(-40, mScreen.width + 4);
+        int32_t y = Test_range(0, mScreen.height + 4);
+        bool color = Test_range(0, 1);
+
+        // The text ends at the new line, or after a random number of tokens
+        int32_t count = Test_range(0, mCount);
+        for (int32_t i = 0; i < count; ++i)
+        {
+            if (mCodes[i] == '\n')
+            {
+                count = i;
+                break;
+            }
+        }
+        uint16_t length = (count < mCount) ? mPositions[count] : (mPositions[mCount] + 4);
+
+        snprintf(operation, sizeof(operation), "step %u, drawText(%d,%d,%u bytes)", (unsigned)step, x, y, length);
+        uint16_t width = SSD1306_drawText(&mDevice, &SSD1306_FONT_SMALL, x, y, mText, length, color);
+        int32_t expected = Reference_drawText(&mScreen, &SSD1306_FONT_SMALL, x, y, mCodes, count, color);
+        TEST_CHECK(width == expected, "%s: width %u, expected %d", operation, width, expected);
+        endCase(operation);
+    }
+}
+
+static void testDrawTextBox (void)
+{
+    char operation [64];
+
+    for (uint32_t step = 0; step < FONT_STEPS; ++step)
+    {
+        buildText();
+        beginCase();
+
+        int32_t x = Test_range(0, mScreen.width - 1);
+        int32_t y = Test_range(0, mScreen.height - 1);
+        int32_t width  = (Test_range(0, 3) == 0) ? Test_range(0, 8) : Test_range(0, 140);
+        int32_t height = Test_range(0, 70);
+        bool color = Test_range(0, 1);
+
+        snprintf(operation, sizeof(operation), "step %u, drawTextBox(%d,%d,%d,%d)", (unsigned)step, x, y, width, height);
+        uint16_t length = SSD1306_drawTextBox(&mDevice, &SSD1306_FONT_SMALL, x, y, width, height, mText, color);
+
+        Reference_setClip(&mScreen, x, y,
+                          (x + width < mScreen.width)   ? (x + width)  : mScreen.width,
+                          (y + height < mScreen.height) ? (y + height) : mScreen.height);
+        int32_t i = 0;
+        for (int32_t line = y; (i < mCount) && ((line + SSD1306_FONT_SMALL.height) <= (y + height));
+             line += SSD1306_FONT_SMALL.lineHeight)
+        {
+            int32_t fit = fitTokens(i, width);
+            Reference_drawText(&mScreen, &SSD1306_FONT_SMALL, x, line, &mCodes[i], fit - i, color);
+
+            bool isEmpty = (fit == i);
+            i = fit;
+            while ((i < mCount) && (mCodes[i] == ' ')) i++;
+            if ((i < mCount) && (mCodes[i] == '\n'))
+                i++;
+            else if (isEmpty && (i < mCount))
+                i++;
+        }
+
+        TEST_CHECK(length == mPositions[i], "%s: %u bytes drawn, expected %u", operation, length, mPositions[i]);
+        endCase(operation);
+    }
+}
+
+static void testProduct (uint16_t product, uint32_t seed)
+{
+    Test_initDevice(&mDevice, product);
+    Reference_init(&mScreen, mDevice.gdl.width, mDevice.gdl.height);
+    Test_seed(seed);
+
+    testDrawText();
+    testDrawTextBox();
+}
+
+int main (void)
+{
+    testGlyphs();
+    testMeasure();
+    testFit();
+
+    testProduct(SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1, 0xF0E7);
+    testProduct(SSD1306_PRODUCT_ADAFRUIT_931, 0x5A11);
+
+    return Test_end("font");
+}
@@ -0,0 +1,1156 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+/*!
+ * \file  /tests/test_modules.c
+ * \brief Random differential checks of the modules over the core.
+ *
+ * Every module is driven with random operations, and the result is compared
+ * with a plain model updated one pixel at time: the internal buffer after
+ * every operation, and the display of the simulated controller after every
+ * update sent. The fade engine does not draw: it is compared with a model
+ * of the contrast, of the display ON state and of the charge pump.
+ */
+
+#include <math.h>
+
+#include "harness.h"
+#include "reference.h"
+#include "ssd1306canvas.h"
+#include "ssd1306console.h"
+#include "ssd1306fade.h"
+#include "ssd1306plot.h"
+#include "ssd1306sprite.h"
+#include "ssd1306widget.h"
+
+#define MODULES_STEPS                            4000
+
+#define CANVAS_WIDTH                             300
+#define CANVAS_HEIGHT                            80
+
+#define SPRITE_MAX_SIDE                          24
+#define WIDGET_COUNT                             5
+#define ICON_COUNT                               4
+#define ICON_MAX_WIDTH                           38
+#define ICON_MAX_HEIGHT                          20
+#define PLOT_MAX_SAMPLES                         (3 * SSD1306_MAX_DISPLAY_WIDTH)
+
+static SSD1306_Device_t mDevices [2];
+static Reference_Screen_t mScreen;
+static char mOperation [128];
+
+/*!
+ * The function compares an area of the buffer of a device with the
+ * reference screen.
+ */
+static void compareBuffer (SSD1306_DeviceHandle_t dev, int32_t width, int32_t height)
+{
+    for (int32_t y = 0; y < height; ++y)
+    {
+        for (int32_t x = 0; x < width; ++x)
+        {
+            if (Reference_getPixel(&mScreen, x, y) != Test_getBufferPixel(dev, x, y))
+            {
+                TEST_CHECK(FALSE, "%s, start line %u: pixel %d,%d is %d",
+                           mOperation, dev->startLine, x, y, !Reference_getPixel(&mScreen, x, y));
+                return;
+            }
+        }
+    }
+}
+
+/*!
+ * The function compares an area of the display with the reference screen.
+ */
+static void compareDisplay (int32_t width, int32_t height)
+{
+    TEST_CHECK(Simulator_get()->errors == 0, "%s: %u transactions rejected",
+               mOperation, (unsigned)Simulator_get()->errors);
+    Simulator_get()->errors = 0;
+
+    for (int32_t y = 0; y < height; ++y)
+    {
+        for (int32_t x = 0; x < width; ++x)
+        {
+            if (Reference_getPixel(&mScreen, x, y) != Simulator_getPixel(x, y))
+            {
+                TEST_CHECK(FALSE, "%s: display pixel %d,%d is %d",
+                           mOperation, x, y, !Reference_getPixel(&mScreen, x, y));
+                return;
+            }
+        }
+    }
+}
+
+/*!
+ * The function fills the buffer of a device with random pixels, sends it,
+ * and copies it into the reference screen.
+ */
+static void fillBackground (SSD1306_DeviceHandle_t dev)
+{
+    for (uint32_t i = 0; i < SSD1306_BUFFER_DIMENSION; ++i)
+        dev->buffer[i] = Test_random();
+    SSD1306_flush(dev);
+
+    Reference_init(&mScreen, dev->gdl.width, dev->gdl.height);
+    for (int32_t y = 0; y < dev->gdl.height; ++y)
+        for (int32_t x = 0; x < dev->gdl.width; ++x)
+            mScreen.pixels[y][x] = Test_getBufferPixel(dev, x, y);
+}
+
+/*!
+ * The canvas model: the pixels of the canvas, and the viewport.
+ */
+static bool mCanvasPixels [CANVAS_HEIGHT][CANVAS_WIDTH];
+
+static void checkCanvas (SSD1306_CanvasHandle_t canvas, bool isSent)
+{
+    int32_t offset = 0;
+    for (uint8_t i = 0; i < canvas->panelCount; ++i)
+    {
+        SSD1306_DeviceHandle_t dev = canvas->panels[i];
+        for (int32_t y = 0; y < canvas->viewHeight; ++y)
+            for (int32_t x = 0; x < dev->gdl.width; ++x)
+                mScreen.pixels[y][x] = mCanvasPixels[canvas->yView + y][(canvas->xView + offset + x) % CANVAS_WIDTH];
+
+        compareBuffer(dev, dev->gdl.width, canvas->viewHeight);
+        // All the panels send to the same simulated controller
+        if (isSent && (canvas->panelCount == 1))
+            compareDisplay(dev->gdl.width, canvas->viewHeight);
+        offset += dev->gdl.width;
+    }
+}
+
+static void testCanvas (uint8_t panelCount, uint32_t seed)
+{
+    static uint8_t buffer [SSD1306_CANVAS_SIZE(CANVAS_WIDTH, CANVAS_HEIGHT)];
+    SSD1306_Canvas_t canvas;
+
+    Test_seed(seed);
+    Test_initDevice(&mDevices[0], SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1);
+    SSD1306_scrollLines(&mDevices[0], Test_range(0, 63));
+    SSD1306_canvasInit(&canvas, buffer, CANVAS_WIDTH, CANVAS_HEIGHT);
+    SSD1306_canvasAddPanel(&canvas, &mDevices[0]);
+    if (panelCount > 1)
+    {
+        Test_initDevice(&mDevices[1], SSD1306_PRODUCT_ADAFRUIT_931);
+        SSD1306_scrollLines(&mDevices[1], Test_range(0, 63));
+        SSD1306_canvasAddPanel(&canvas, &mDevices[1]);
+    }
+    Reference_init(&mScreen, SSD1306_MAX_DISPLAY_WIDTH, SSD1306_MAX_DISPLAY_HEIGHT);
+    memset(mCanvasPixels, 0, sizeof(mCanvasPixels));
+
+    for (uint32_t step = 0; step < MODULES_STEPS; ++step)
+    {
+        switch (Test_range(0, 5))
+        {
+        case 0:
+            {
+                uint16_t x = Test_range(0, 2 * CANVAS_WIDTH);
+                uint8_t y = Test_range(0, CANVAS_HEIGHT + 2);
+                bool color = Test_range(0, 1);
+                SSD1306_canvasDrawPixel(&canvas, x, y, color);
+                if (y < CANVAS_HEIGHT)
+                    mCanvasPixels[y][x % CANVAS_WIDTH] = color;
+            }
+            break;
+        case 1:
+            {
+                uint16_t x = Test_range(0, CANVAS_WIDTH), width = Test_range(0, 40);
+                uint8_t y = Test_range(0, CANVAS_HEIGHT), height = Test_range(0, 30);
+                bool color = Test_range(0, 1);
+                SSD1306_canvasFillRectangle(&canvas, x, y, width, height, color);
+                for (int32_t j = y; (j < (y + height)) && (j < CANVAS_HEIGHT); ++j)
+                    for (int32_t i = x; i < (x + width); ++i)
+                        mCanvasPixels[j][i % CANVAS_WIDTH] = color;
+            }
+            break;
+        case 2:
+            {
+                // Short movements, in both directions and across the wrap
+                int32_t shift = (Test_range(0, 3) == 0) ? Test_range(-300, 300) : Test_range(-9, 9);
+                uint16_t x = (canvas.xView + CANVAS_WIDTH + shift) % CANVAS_WIDTH;
+                uint8_t y = (Test_range(0, 4) == 0) ? Test_range(0, CANVAS_HEIGHT) : canvas.yView;
+                SSD1306_canvasPan(&canvas, x, y);
+            }
+            break;
+        default:
+            {
+                snprintf(mOperation, sizeof(mOperation), "step %u, %u panels, update at %u,%u",
+                         (unsigned)step, panelCount, canvas.xView, canvas.yView);
+                bool isSent = SSD1306_canvasUpdate(&canvas);
+                checkCanvas(&canvas, isSent);
+            }
+            break;
+        }
+    }
+}
+
+/*!
+ * The function sets the clip area of the device and of the reference screen:
+ * the whole display, or a random area.
+ */
+static void setRandomClip (SSD1306_DeviceHandle_t dev)
+{
+    SSD1306_resetClip(dev);
+    Reference_setClip(&mScreen, 0, 0, dev->gdl.width, dev->gdl.height);
+    if (Test_range(0, 1) == 0)
+        return;
+
+    int32_t x = Test_range(0, dev->gdl.width - 1), width  = Test_range(0, dev->gdl.width);
+    int32_t y = Test_range(0, dev->gdl.height - 1), height = Test_range(0, dev->gdl.height);
+    SSD1306_pushClip(dev, x, y, width, height);
+    Reference_setClip(&mScreen, x, y,
+                      ((x + width) < dev->gdl.width) ? (x + width) : dev->gdl.width,
+                      ((y + height) < dev->gdl.height) ? (y + height) : dev->gdl.height);
+}
+
+/*!
+ * The sprite model: the background saved under the sprite.
+ */
+static bool mSpriteSaved [SPRITE_MAX_SIDE][SPRITE_MAX_SIDE];
+
+static bool getImagePixel (const uint8_t* image, uint8_t width, int32_t x, int32_t y)
+{
+    return (image[(y / 8) * width + x] >> (y % 8)) & 0x01;
+}
+
+static void drawModelSprite (const SSD1306_Sprite_t* sprite, int32_t xPos, int32_t yPos, SSD1306_Blend_t blend)
+{
+    for (int32_t j = 0; j < sprite->height; ++j)
+    {
+        for (int32_t i = 0; i < sprite->width; ++i)
+        {
+            if ((sprite->mask != NULL) && !getImagePixel(sprite->mask, sprite->width, i, j))
+                continue;
+
+            bool bit = getImagePixel(sprite->bitmap, sprite->width, i, j);
+            switch (blend)
+            {
+            case SSD1306_BLEND_OR:
+                if (bit) Reference_drawPixel(&mScreen, xPos + i, yPos + j, TRUE);
+                break;
+            case SSD1306_BLEND_AND_NOT:
+                if (bit) Reference_drawPixel(&mScreen, xPos + i, yPos + j, FALSE);
+                break;
+            case SSD1306_BLEND_XOR:
+                if (bit) Reference_drawPixel(&mScreen, xPos + i, yPos + j,
+                                             !Reference_getPixel(&mScreen, xPos + i, yPos + j));
+                break;
+            case SSD1306_BLEND_MASKED:
+                Reference_drawPixel(&mScreen, xPos + i, yPos + j, bit);
+                break;
+            }
+        }
+    }
+}
+
+static void saveModelSprite (const SSD1306_Sprite_t* sprite, int32_t xPos, int32_t yPos)
+{
+    for (int32_t j = 0; j < sprite->height; ++j)
+        for (int32_t i = 0; i < sprite->width; ++i)
+            mSpriteSaved[j][i] = Reference_getPixel(&mScreen, xPos + i, yPos + j);
+}
+
+static void restoreModelSprite (const SSD1306_Sprite_t* sprite, int32_t xPos, int32_t yPos)
+{
+    for (int32_t j = 0; j < sprite->height; ++j)
+        for (int32_t i = 0; i < sprite->width; ++i)
+            Reference_drawPixel(&mScreen, xPos + i, yPos + j, mSpriteSaved[j][i]);
+}
+
+static void checkSpriteSaved (const SSD1306_Sprite_t* sprite, const uint8_t* background)
+{
+    for (int32_t j = 0; j < sprite->height; ++j)
+    {
+        for (int32_t i = 0; i < sprite->width; ++i)
+        {
+            if (getImagePixel(background, sprite->width, i, j) != mSpriteSaved[j][i])
+            {
+                TEST_CHECK(FALSE, "%s: saved pixel %d,%d is %d", mOperation, i, j, !mSpriteSaved[j][i]);
+                return;
+            }
+        }
+    }
+}
+
+static void testSprite (uint32_t seed)
+{
+    static uint8_t bitmap [SSD1306_SPRITE_SIZE(SPRITE_MAX_SIDE, SPRITE_MAX_SIDE)];
+    static uint8_t mask [SSD1306_SPRITE_SIZE(SPRITE_MAX_SIDE, SPRITE_MAX_SIDE)];
+    static uint8_t background [SSD1306_SPRITE_SIZE(SPRITE_MAX_SIDE, SPRITE_MAX_SIDE)];
+    static const char* blendNames [] = { "OR", "AND_NOT", "XOR", "MASKED" };
+    SSD1306_DeviceHandle_t dev = &mDevices[0];
+    SSD1306_Sprite_t sprite = { 1, 1, bitmap, NULL };
+    int16_t xSaved = 0, ySaved = 0;
+    bool isSaved = FALSE;
+
+    Test_seed(seed);
+    Test_initDevice(dev, SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1);
+    SSD1306_scrollLines(dev, Test_range(0, 63));
+    fillBackground(dev);
+
+    for (uint32_t step = 0; step < MODULES_STEPS; ++step)
+    {
+        int16_t x = Test_range(-SPRITE_MAX_SIDE - 4, dev->gdl.width + 4);
+        int16_t y = Test_range(-SPRITE_MAX_SIDE - 4, dev->gdl.height + 4);
+        SSD1306_Blend_t blend = (SSD1306_Blend_t)Test_range(SSD1306_BLEND_OR, SSD1306_BLEND_MASKED);
+
+        switch (Test_range(0, 7))
+        {
+        case 0:
+            sprite.width  = Test_range(1, SPRITE_MAX_SIDE);
+            sprite.height = Test_range(1, SPRITE_MAX_SIDE);
+            sprite.mask   = (Test_range(0, 1) == 0) ? NULL : mask;
+            for (uint16_t i = 0; i < sizeof(bitmap); ++i)
+            {
+                bitmap[i] = Test_random();
+                mask[i]   = Test_random();
+            }
+            isSaved = FALSE;
+            snprintf(mOperation, sizeof(mOperation), "step %u, new sprite %ux%u",
+                     (unsigned)step, sprite.width, sprite.height);
+            break;
+        case 1:
+        case 2:
+            snprintf(mOperation, sizeof(mOperation), "step %u, sprite %ux%u drawn at %d,%d with %s",
+                     (unsigned)step, sprite.width, sprite.height, x, y, blendNames[blend]);
+            SSD1306_drawSprite(dev, &sprite, x, y, blend);
+            SSD1306_flushSprite(dev, &sprite, x, y);
+            drawModelSprite(&sprite, x, y, blend);
+            break;
+        case 3:
+            snprintf(mOperation, sizeof(mOperation), "step %u, sprite %ux%u saved at %d,%d",
+                     (unsigned)step, sprite.width, sprite.height, x, y);
+            SSD1306_saveSprite(dev, &sprite, x, y, background);
+            saveModelSprite(&sprite, x, y);
+            checkSpriteSaved(&sprite, background);
+            xSaved  = x;
+            ySaved  = y;
+            isSaved = TRUE;
+            break;
+        case 4:
+            if (!isSaved)
+                continue;
+            snprintf(mOperation, sizeof(mOperation), "step %u, sprite %ux%u restored at %d,%d",
+                     (unsigned)step, sprite.width, sprite.height, xSaved, ySaved);
+            SSD1306_restoreSprite(dev, &sprite, xSaved, ySaved, background);
+            SSD1306_flushSprite(dev, &sprite, xSaved, ySaved);
+            restoreModelSprite(&sprite, xSaved, ySaved);
+            break;
+        case 5:
+            if (!isSaved)
+                continue;
+            snprintf(mOperation, sizeof(mOperation), "step %u, sprite %ux%u moved from %d,%d to %d,%d with %s",
+                     (unsigned)step, sprite.width, sprite.height, xSaved, ySaved, x, y, blendNames[blend]);
+            SSD1306_moveSprite(dev, &sprite, xSaved, ySaved, x, y, blend, background);
+            restoreModelSprite(&sprite, xSaved, ySaved);
+            saveModelSprite(&sprite, x, y);
+            drawModelSprite(&sprite, x, y, blend);
+            checkSpriteSaved(&sprite, background);
+            xSaved = x;
+            ySaved = y;
+            break;
+        case 6:
+            {
+                // Without background the old position is erased with a XOR
+                int16_t xOld = Test_range(-SPRITE_MAX_SIDE - 4, dev->gdl.width + 4);
+                int16_t yOld = Test_range(-SPRITE_MAX_SIDE - 4, dev->gdl.height + 4);
+                snprintf(mOperation, sizeof(mOperation), "step %u, sprite %ux%u moved from %d,%d to %d,%d with XOR",
+                         (unsigned)step, sprite.width, sprite.height, xOld, yOld, x, y);
+                SSD1306_moveSprite(dev, &sprite, xOld, yOld, x, y, SSD1306_BLEND_XOR, NULL);
+                drawModelSprite(&sprite, xOld, yOld, SSD1306_BLEND_XOR);
+                drawModelSprite(&sprite, x, y, SSD1306_BLEND_XOR);
+            }
+            break;
+        default:
+            snprintf(mOperation, sizeof(mOperation), "step %u, new clip area", (unsigned)step);
+            setRandomClip(dev);
+            break;
+        }
+
+        compareBuffer(dev, dev->gdl.width, dev->gdl.height);
+        compareDisplay(dev->gdl.width, dev->gdl.height);
+    }
+    SSD1306_resetClip(dev);
+}
+
+/*!
+ * The widget model: the content shown by every widget.
+ */
+static int32_t mWidgetValues [WIDGET_COUNT];
+static char mWidgetText [WIDGET_COUNT][SSD1306_WIDGET_MAX_CHARS];
+static char mWidgetShownText [WIDGET_COUNT][SSD1306_WIDGET_MAX_CHARS];
+static int32_t mWidgetShownLevel [WIDGET_COUNT];
+static bool mWidgetDrawn [WIDGET_COUNT];
+
+static int32_t getModelLevel (const SSD1306_Widget_t* widget, int32_t value, int32_t steps)
+{
+    if (value <= widget->minimum) return 0;
+    if (value >= widget->maximum) return steps;
+
+    return ((int64_t)(value - widget->minimum) * steps) / (widget->maximum - widget->minimum);
+}
+
+/*!
+ * The function returns the level of the content shown by a widget: the
+ * width of a bar, the angle of a needle or the icon.
+ */
+static int32_t getModelWidgetLevel (const SSD1306_Widget_t* widget, uint8_t index)
+{
+    int32_t value = mWidgetValues[index];
+
+    switch (widget->type)
+    {
+    case SSD1306_WIDGETTYPE_PROGRESS:
+        return getModelLevel(widget, value, widget->width - 2);
+    case SSD1306_WIDGETTYPE_GAUGE:
+        return getModelLevel(widget, value, 64);
+    case SSD1306_WIDGETTYPE_ICON:
+        return (value < 0) ? 0 : (value >= widget->iconCount) ? (widget->iconCount - 1) : value;
+    default:
+        return 0;
+    }
+}
+
+static void formatModelNumber (char* text, uint8_t chars, int32_t value)
+{
+    char digits [16];
+    int32_t length = snprintf(digits, sizeof(digits), "%ld", (long)value);
+
+    if (length > chars)
+    {
+        memset(text, '#', chars);
+    }
+    else
+    {
+        memset(text, ' ', chars - length);
+        memcpy(&text[chars - length], digits, length);
+    }
+}
+
+/*!
+ * The function draws the whole widget into the reference screen, from the
+ * content of the model.
+ */
+static void drawModelWidget (const SSD1306_Widget_t* widget, uint8_t index, int32_t level)
+{
+    int32_t x = widget->xPos, y = widget->yPos;
+
+    switch (widget->type)
+    {
+    case SSD1306_WIDGETTYPE_LABEL:
+    case SSD1306_WIDGETTYPE_NUMBER:
+        for (uint8_t i = 0; i < widget->chars; ++i)
+            Reference_drawChar(&mScreen, x + i * SSD1306_WIDGET_CHAR_WIDTH, y, mWidgetText[index][i], TRUE, 1);
+        break;
+    case SSD1306_WIDGETTYPE_PROGRESS:
+        Reference_fillRectangle(&mScreen, x, y, widget->width, widget->height, FALSE);
+        Reference_drawRectangle(&mScreen, x, y, widget->width, widget->height, TRUE);
+        Reference_fillRectangle(&mScreen, x + 1, y + 1, level, widget->height - 2, TRUE);
+        break;
+    case SSD1306_WIDGETTYPE_GAUGE:
+        {
+            int32_t radius = widget->height - 1;
+            int32_t length = (radius > 2) ? (radius - 2) : 1;
+            double angle = M_PI * (1.0 - level / 64.0);
+            double xNeedle = x + radius + cos(angle) * length;
+            double yNeedle = y + radius - sin(angle) * length;
+
+            TEST_CHECK((fabs(widget->xNeedle - xNeedle) <= 1.0) && (fabs(widget->yNeedle - yNeedle) <= 1.0),
+                       "%s: needle at %u,%u, expected %.1f,%.1f",
+                       mOperation, widget->xNeedle, widget->yNeedle, xNeedle, yNeedle);
+
+            Reference_setClip(&mScreen, x, y, x + widget->width, y + widget->height);
+            Reference_fillEllipse(&mScreen, x + radius, y + radius, radius, radius, TRUE);
+            Reference_fillEllipse(&mScreen, x + radius, y + radius, radius - 1, radius - 1, FALSE);
+            Reference_drawLine(&mScreen, x + radius, y + radius, widget->xNeedle, widget->yNeedle, TRUE);
+            Reference_fillEllipse(&mScreen, x + radius, y + radius, 1, 1, TRUE);
+            Reference_setClip(&mScreen, 0, 0, mScreen.width, mScreen.height);
+        }
+        break;
+    case SSD1306_WIDGETTYPE_ICON:
+        for (uint8_t page = 0; page < ((widget->height + 7) / 8); ++page)
+        {
+            uint8_t lines = widget->height - page * 8;
+            uint8_t mask  = (lines < 8) ? (uint8_t)((1u << lines) - 1) : 0xFF;
+            for (uint8_t i = 0; i < widget->width; ++i)
+                Reference_writeColumn(&mScreen, x + i, y + page * 8,
+                                      widget->icons[level][page * widget->width + i], mask);
+        }
+        break;
+    }
+}
+
+static void testWidgets (uint32_t seed)
+{
+    static uint8_t icons [ICON_COUNT][SSD1306_SPRITE_SIZE(ICON_MAX_WIDTH, ICON_MAX_HEIGHT)];
+    static const uint8_t* const iconSet [ICON_COUNT] = { icons[0], icons[1], icons[2], icons[3] };
+    static SSD1306_Widget_t widgets [WIDGET_COUNT];
+    SSD1306_DeviceHandle_t dev = &mDevices[0];
+
+    Test_seed(seed);
+    Test_initDevice(dev, SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1);
+    SSD1306_scrollLines(dev, Test_range(0, 63));
+    fillBackground(dev);
+    for (uint8_t i = 0; i < ICON_COUNT; ++i)
+        for (uint16_t j = 0; j < sizeof(icons[i]); ++j)
+            icons[i][j] = Test_random();
+
+    // The widgets do not overlap, and they are not aligned to the pages
+    int32_t minimum = Test_range(-1000, 1000);
+    int32_t maximum = minimum + Test_range(1, 2000);
+    SSD1306_widgetLabel(&widgets[0], dev, Test_range(0, 20), Test_range(0, 3), Test_range(1, 10));
+    SSD1306_widgetNumber(&widgets[1], dev, Test_range(0, 30), Test_range(12, 14), Test_range(1, 8));
+    SSD1306_widgetProgress(&widgets[2], dev, Test_range(0, 10), Test_range(24, 26),
+                           Test_range(3, 60), Test_range(3, 10), minimum, maximum);
+    uint8_t radius = Test_range(2, 20);
+    SSD1306_widgetGauge(&widgets[3], dev, Test_range(70, 127 - 2 * radius), Test_range(38, 63 - radius),
+                        radius, minimum, maximum);
+    SSD1306_widgetIcon(&widgets[4], dev, Test_range(80, 90), Test_range(0, 4),
+                       Test_range(1, ICON_MAX_WIDTH), Test_range(1, ICON_MAX_HEIGHT), iconSet, ICON_COUNT);
+
+    memset(mWidgetDrawn, 0, sizeof(mWidgetDrawn));
+    for (uint8_t i = 0; i < WIDGET_COUNT; ++i)
+    {
+        mWidgetValues[i] = widgets[i].value;
+        memset(mWidgetText[i], ' ', SSD1306_WIDGET_MAX_CHARS);
+    }
+    formatModelNumber(mWidgetText[1], widgets[1].chars, 0);
+
+    for (uint32_t step = 0; step < MODULES_STEPS; ++step)
+    {
+        uint8_t index = Test_range(0, WIDGET_COUNT - 1);
+        SSD1306_WidgetHandle_t widget = &widgets[index];
+
+        switch (Test_range(0, 5))
+        {
+        case 0:
+            if (index == 0)
+            {
+                // Only spaces and boxes can be told apart with the stub font
+                char text [SSD1306_WIDGET_MAX_CHARS + 4];
+                uint8_t length = Test_range(0, widget->chars + 3);
+                for (uint8_t i = 0; i < length; ++i)
+                    text[i] = (Test_range(0, 2) == 0) ? ' ' : 'A' + Test_range(0, 25);
+                text[length] = '\0';
+
+                SSD1306_widgetSetText(widget, text);
+                memset(mWidgetText[0], ' ', widget->chars);
+                memcpy(mWidgetText[0], text, (length < widget->chars) ? length : widget->chars);
+            }
+            else
+            {
+                int32_t value = (Test_range(0, 3) == 0) ? Test_range(-2000000, 2000000) :
+                                Test_range(minimum - 100, maximum + 100);
+                if (index == 4)
+                    value = Test_range(-2, ICON_COUNT + 2);
+
+                SSD1306_widgetSetValue(widget, value);
+                mWidgetValues[index] = value;
+                if (index == 1)
+                    formatModelNumber(mWidgetText[1], widget->chars, value);
+            }
+            continue;
+        case 1:
+            SSD1306_widgetInvalidate(widget);
+            mWidgetDrawn[index] = FALSE;
+            continue;
+        default:
+            {
+                int32_t level = getModelWidgetLevel(widget, index);
+                bool isChanged = !mWidgetDrawn[index] ||
+                                 (memcmp(mWidgetText[index], mWidgetShownText[index], SSD1306_WIDGET_MAX_CHARS) != 0) ||
+                                 (level != mWidgetShownLevel[index]);
+
+                snprintf(mOperation, sizeof(mOperation), "step %u, widget %u updated with value %ld, level %ld",
+                         (unsigned)step, index, (long)mWidgetValues[index], (long)level);
+                bool result = SSD1306_widgetUpdate(widget);
+                TEST_CHECK(result == isChanged, "%s: the update returns %d", mOperation, result);
+
+                if (isChanged)
+                    drawModelWidget(widget, index, level);
+                memcpy(mWidgetShownText[index], mWidgetText[index], SSD1306_WIDGET_MAX_CHARS);
+                mWidgetShownLevel[index] = level;
+                mWidgetDrawn[index] = TRUE;
+            }
+            break;
+        }
+
+        compareBuffer(dev, dev->gdl.width, dev->gdl.height);
+        compareDisplay(dev->gdl.width, dev->gdl.height);
+    }
+}
+
+/*!
+ * The plot model: the geometry and the state of the sweep.
+ */
+typedef struct _Model_Plot_t
+{
+    int32_t xPos;
+    int32_t yPos;
+    int32_t width;
+    int32_t height;
+    int32_t minimum;
+    int32_t maximum;
+    int32_t gap;
+    int32_t cursor;
+    int32_t lastLine;
+    bool isFirst;
+} Model_Plot_t;
+
+static int32_t getModelLine (const Model_Plot_t* plot, int32_t value)
+{
+    if (value <= plot->minimum) return plot->yPos + plot->height - 1;
+    if (value >= plot->maximum) return plot->yPos;
+
+    return plot->yPos + plot->height - 1 - ((value - plot->minimum) * (plot->height - 1)) / (plot->maximum - plot->minimum);
+}
+
+static void drawModelColumn (Model_Plot_t* plot, int32_t column, const int16_t* samples, int32_t count)
+{
+    int32_t top = plot->yPos + plot->height, bottom = -1;
+
+    for (int32_t i = 0; i < count; ++i)
+    {
+        int32_t line = getModelLine(plot, samples[i]);
+        if (line < top)    top    = line;
+        if (line > bottom) bottom = line;
+    }
+    if (!plot->isFirst)
+    {
+        if (plot->lastLine < top)    top    = plot->lastLine;
+        if (plot->lastLine > bottom) bottom = plot->lastLine;
+    }
+    plot->lastLine = getModelLine(plot, samples[count - 1]);
+    plot->isFirst  = FALSE;
+
+    Reference_fillRectangle(&mScreen, plot->xPos + column, plot->yPos, 1, plot->height, FALSE);
+    Reference_fillRectangle(&mScreen, plot->xPos + column, top, 1, bottom - top + 1, TRUE);
+}
+
+static void testPlot (uint32_t seed)
+{
+    static int16_t samples [PLOT_MAX_SAMPLES];
+    SSD1306_DeviceHandle_t dev = &mDevices[0];
+    SSD1306_Plot_t plot;
+    Model_Plot_t model;
+
+    Test_seed(seed);
+    Test_initDevice(dev, SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1);
+    SSD1306_scrollLines(dev, Test_range(0, 63));
+    fillBackground(dev);
+
+    for (uint32_t step = 0; step < MODULES_STEPS; ++step)
+    {
+        // A new plot, from time to time
+        if ((step % 500) == 0)
+        {
+            memset(&model, 0, sizeof(model));
+            model.xPos    = Test_range(0, 100);
+            model.yPos    = Test_range(0, 50);
+            model.width   = Test_range(1, dev->gdl.width - model.xPos);
+            model.height  = Test_range(1, dev->gdl.height - model.yPos);
+            model.minimum = Test_range(-1000, 0);
+            model.maximum = model.minimum + Test_range(1, 2000);
+            model.gap     = Test_range(0, model.width + 2);
+            SSD1306_plotInit(&plot, dev, model.xPos, model.yPos, model.width, model.height,
+                             model.minimum, model.maximum, model.gap);
+            SSD1306_flush(dev);
+
+            model.gap     = (model.gap < model.width) ? model.gap : (model.width - 1);
+            model.isFirst = TRUE;
+            Reference_fillRectangle(&mScreen, model.xPos, model.yPos, model.width, model.height, FALSE);
+        }
+
+        uint16_t count = 1;
+        int32_t operation = Test_range(0, 9);
+        if (operation == 8)
+            count = Test_range(1, 8);
+        else if (operation == 9)
+            count = Test_range(1, PLOT_MAX_SAMPLES);
+        for (uint16_t i = 0; i < count; ++i)
+            samples[i] = Test_range(model.minimum - 50, model.maximum + 50);
+
+        snprintf(mOperation, sizeof(mOperation), "step %u, plot %ldx%ld at %ld,%ld, %s of %u samples at %ld",
+                 (unsigned)step, (long)model.width, (long)model.height, (long)model.xPos, (long)model.yPos,
+                 (operation == 9) ? "draw" : "push", count, (long)model.cursor);
+
+        if (operation == 9)
+        {
+            SSD1306_plotDraw(&plot, samples, count);
+
+            Reference_fillRectangle(&mScreen, model.xPos, model.yPos, model.width, model.height, FALSE);
+            model.isFirst = TRUE;
+            if (count <= model.width)
+            {
+                for (int32_t i = 0; i < count; ++i)
+                    drawModelColumn(&model, i, &samples[i], 1);
+                model.cursor = (count < model.width) ? count : 0;
+            }
+            else
+            {
+                for (int32_t column = 0; column < model.width; ++column)
+                {
+                    int32_t first = (column * count) / model.width;
+                    int32_t last  = ((column + 1) * count) / model.width;
+                    drawModelColumn(&model, column, &samples[first], last - first);
+                }
+                model.cursor = 0;
+            }
+        }
+        else
+        {
+            if (count == 1)
+                SSD1306_plotPush(&plot, samples[0]);
+            else
+                SSD1306_plotPushBlock(&plot, samples, count);
+
+            if (model.gap > 0)
+                Reference_fillRectangle(&mScreen, model.xPos + (model.cursor + model.gap) % model.width,
+                                        model.yPos, 1, model.height, FALSE);
+            drawModelColumn(&model, model.cursor, samples, count);
+            model.cursor = (model.cursor + 1) % model.width;
+        }
+        if (model.cursor == 0)
+            model.isFirst = TRUE;
+
+        compareBuffer(dev, dev->gdl.width, dev->gdl.height);
+        compareDisplay(dev->gdl.width, dev->gdl.height);
+    }
+}
+
+/*!
+ * The console model: the grid of chars and the cursor.
+ */
+static char mConsoleText [SSD1306_CONSOLE_MAX_ROWS][SSD1306_CONSOLE_MAX_COLUMNS];
+static uint8_t mConsoleColumn;
+static uint8_t mConsoleRow;
+
+static void newModelLine (const SSD1306_Console_t* console)
+{
+    mConsoleColumn = 0;
+    if ((mConsoleRow + 1) < console->rows)
+    {
+        mConsoleRow++;
+        return;
+    }
+
+    memmove(mConsoleText[0], mConsoleText[1], (console->rows - 1) * SSD1306_CONSOLE_MAX_COLUMNS);
+    memset(mConsoleText[console->rows - 1], ' ', SSD1306_CONSOLE_MAX_COLUMNS);
+}
+
+static void putModelChar (const SSD1306_Console_t* console, char c)
+{
+    switch (c)
+    {
+    case '\n':
+        newModelLine(console);
+        break;
+    case '\r':
+        mConsoleColumn = 0;
+        break;
+    case '\b':
+        if (mConsoleColumn > 0)
+            mConsoleText[mConsoleRow][--mConsoleColumn] = ' ';
+        break;
+    default:
+        if (mConsoleColumn >= console->columns)
+        {
+            if (!console->isWrap)
+                break;
+            newModelLine(console);
+        }
+        mConsoleText[mConsoleRow][mConsoleColumn++] = c;
+        break;
+    }
+}
+
+static char getConsoleChar (void)
+{
+    switch (Test_range(0, 19))
+    {
+    case 0:  return '\n';
+    case 1:  return '\r';
+    case 2:  return '\b';
+    case 3:
+    case 4:
+    case 5:  return ' ';
+    default: return (char)Test_range('!', '~');
+    }
+}
+
+static void testConsole (uint16_t product, bool isWrap, uint32_t seed)
+{
+    static SSD1306_Console_t console;
+    SSD1306_DeviceHandle_t dev = &mDevices[0];
+
+    Test_seed(seed);
+    Test_initDevice(dev, product);
+    SSD1306_scrollLines(dev, Test_range(0, 63));
+    SSD1306_consoleInit(&console, dev, isWrap);
+    Reference_init(&mScreen, dev->gdl.width, dev->gdl.height);
+    memset(mConsoleText, ' ', sizeof(mConsoleText));
+    mConsoleColumn = 0;
+    mConsoleRow    = 0;
+
+    for (uint32_t step = 0; step < MODULES_STEPS; ++step)
+    {
+        switch (Test_range(0, 9))
+        {
+        case 0:
+            {
+                char text [32];
+                uint8_t length = Test_range(1, sizeof(text) - 1);
+                for (uint8_t i = 0; i < length; ++i)
+                    text[i] = getConsoleChar();
+                text[length] = '\0';
+                SSD1306_consolePrint(&console, text);
+                for (uint8_t i = 0; i < length; ++i)
+                    putModelChar(&console, text[i]);
+            }
+            break;
+        case 1:
+            {
+                uint8_t column = Test_range(0, console.columns + 3);
+                uint8_t row = Test_range(0, console.rows + 3);
+                SSD1306_consoleSetCursor(&console, column, row);
+                mConsoleColumn = (column < console.columns) ? column : (console.columns - 1);
+                mConsoleRow    = (row < console.rows) ? row : (console.rows - 1);
+            }
+            break;
+        case 2:
+            if (Test_range(0, 20) == 0)
+            {
+                SSD1306_consoleClear(&console);
+                memset(mConsoleText, ' ', sizeof(mConsoleText));
+                mConsoleColumn = 0;
+                mConsoleRow    = 0;
+            }
+            break;
+        case 3:
+        case 4:
+            {
+                snprintf(mOperation, sizeof(mOperation), "step %u, console %ux%u flushed",
+                         (unsigned)step, console.columns, console.rows);
+                SSD1306_consoleFlush(&console);
+
+                for (uint8_t row = 0; row < console.rows; ++row)
+                    for (uint8_t column = 0; column < console.columns; ++column)
+                        Reference_drawChar(&mScreen, column * SSD1306_CONSOLE_CHAR_WIDTH,
+                                           row * SSD1306_CONSOLE_CHAR_HEIGHT, mConsoleText[row][column], TRUE, 1);
+                compareBuffer(dev, dev->gdl.width, dev->gdl.height);
+                compareDisplay(dev->gdl.width, dev->gdl.height);
+                TEST_CHECK((console.cursorColumn == mConsoleColumn) && (console.cursorRow == mConsoleRow),
+                           "%s: cursor at %u,%u, expected %u,%u", mOperation,
+                           console.cursorColumn, console.cursorRow, mConsoleColumn, mConsoleRow);
+            }
+            break;
+        default:
+            {
+                char c = getConsoleChar();
+                SSD1306_consolePutChar(&console, c);
+                putModelChar(&console, c);
+            }
+            break;
+        }
+    }
+}
+
+/*!
+ * The fade model: the engine, and the state of the controller.
+ */
+typedef struct _Model_Fade_t
+{
+    SSD1306_FadeMode_t mode;
+    int32_t from;
+    int32_t to;
+    uint32_t startTime;
+    uint32_t duration;
+    uint32_t stepTime;
+    uint32_t lastStep;
+    bool isOffAtEnd;
+
+    int32_t activeContrast;
+    int32_t idleContrast;
+    uint32_t idleTimeout;
+    uint32_t idleDuration;
+    uint32_t lastActivity;
+    bool isDimmed;
+
+    int32_t contrast;
+    bool isOn;
+    bool isChargePump;
+} Model_Fade_t;
+
+static int32_t interpolateModel (int32_t from, int32_t to, uint32_t elapsed, uint32_t duration)
+{
+    if ((duration == 0) || (elapsed >= duration)) return to;
+
+    return from + (int32_t)(((int64_t)(to - from) * elapsed) / duration);
+}
+
+static void startModelFade (Model_Fade_t* model, int32_t contrast, uint32_t duration)
+{
+    model->mode       = SSD1306_FADEMODE_FADE;
+    model->from       = model->contrast;
+    model->to         = contrast;
+    model->duration   = duration;
+    model->startTime  = System_currentTick();
+    model->isOffAtEnd = FALSE;
+}
+
+static void processModelFade (Model_Fade_t* model)
+{
+    uint32_t now = System_currentTick();
+    int32_t contrast;
+
+    if ((model->idleTimeout > 0) && !model->isDimmed && (model->mode == SSD1306_FADEMODE_NONE) &&
+        ((now - model->lastActivity) >= model->idleTimeout))
+    {
+        model->isDimmed = TRUE;
+        startModelFade(model, model->idleContrast, model->idleDuration);
+    }
+
+    uint32_t elapsed = now - model->startTime;
+    if (model->mode == SSD1306_FADEMODE_FADE)
+    {
+        contrast = interpolateModel(model->from, model->to, elapsed, model->duration);
+        if (contrast == model->to)
+        {
+            // The last step is sent at once
+            model->contrast = contrast;
+            if (model->isOffAtEnd)
+                model->isOn = FALSE;
+            model->mode = SSD1306_FADEMODE_NONE;
+            return;
+        }
+    }
+    else if (model->mode == SSD1306_FADEMODE_PULSE)
+    {
+        uint32_t half  = model->duration / 2;
+        uint32_t phase = (model->duration > 0) ? (elapsed % model->duration) : 0;
+        if (phase < half)
+            contrast = interpolateModel(model->from, model->to, phase, half);
+        else
+            contrast = interpolateModel(model->to, model->from, phase - half, model->duration - half);
+    }
+    else
+    {
+        return;
+    }
+
+    if ((contrast != model->contrast) && ((now - model->lastStep) >= model->stepTime))
+    {
+        model->contrast = contrast;
+        model->lastStep = now;
+    }
+}
+
+static void testFade (uint16_t product, uint32_t seed)
+{
+    static SSD1306_Fade_t fade;
+    SSD1306_DeviceHandle_t dev = &mDevices[0];
+    Simulator_Controller_t* controller = Simulator_get();
+    Model_Fade_t model;
+
+    Test_seed(seed);
+    Test_initDevice(dev, product);
+    SSD1306_scrollLines(dev, Test_range(0, 63));
+    fillBackground(dev);
+    // The initialization does not send the charge pump setting: running
+    controller->isChargePump = dev->isChargePump;
+
+    memset(&model, 0, sizeof(model));
+    model.stepTime       = Test_range(0, 40);
+    model.contrast       = dev->contrast;
+    model.activeContrast = dev->contrast;
+    model.lastActivity   = System_currentTick();
+    model.isOn           = TRUE;
+    model.isChargePump   = dev->isChargePump;
+    SSD1306_fadeInit(&fade, dev, model.stepTime);
+
+    for (uint32_t step = 0; step < MODULES_STEPS; ++step)
+    {
+        uint8_t contrast = Test_range(0, 255);
+        uint32_t duration = Test_range(0, 400);
+        bool isRestored = FALSE;
+
+        Simulator_resetCounters();
+        switch (Test_range(0, 19))
+        {
+        case 0:
+            snprintf(mOperation, sizeof(mOperation), "step %u, fade to %u in %u ms",
+                     (unsigned)step, contrast, (unsigned)duration);
+            SSD1306_fadeTo(&fade, contrast, duration);
+            startModelFade(&model, contrast, duration);
+            break;
+        case 1:
+            snprintf(mOperation, sizeof(mOperation), "step %u, fade in %u ms", (unsigned)step, (unsigned)duration);
+            SSD1306_fadeIn(&fade, duration);
+            model.contrast     = 0;
+            model.isOn         = TRUE;
+            model.isChargePump = dev->isChargePump;
+            startModelFade(&model, model.activeContrast, duration);
+            model.isDimmed     = FALSE;
+            model.lastActivity = model.startTime;
+            break;
+        case 2:
+            snprintf(mOperation, sizeof(mOperation), "step %u, fade out %u ms", (unsigned)step, (unsigned)duration);
+            SSD1306_fadeOut(&fade, duration);
+            startModelFade(&model, 0, duration);
+            model.isOffAtEnd = TRUE;
+            break;
+        case 3:
+            {
+                uint8_t high = Test_range(contrast, 255);
+                snprintf(mOperation, sizeof(mOperation), "step %u, pulse from %u to %u in %u ms",
+                         (unsigned)step, contrast, high, (unsigned)duration);
+                SSD1306_fadePulse(&fade, contrast, high, duration);
+                model.mode       = SSD1306_FADEMODE_PULSE;
+                model.from       = contrast;
+                model.to         = high;
+                model.duration   = duration;
+                model.startTime  = System_currentTick();
+                model.isOffAtEnd = FALSE;
+            }
+            break;
+        case 4:
+            snprintf(mOperation, sizeof(mOperation), "step %u, fade stopped", (unsigned)step);
+            SSD1306_fadeStop(&fade);
+            model.mode = SSD1306_FADEMODE_NONE;
+            break;
+        case 5:
+            {
+                uint32_t timeout = (Test_range(0, 3) == 0) ? 0 : Test_range(1, 300);
+                snprintf(mOperation, sizeof(mOperation), "step %u, idle after %u ms to %u",
+                         (unsigned)step, (unsigned)timeout, contrast);
+                SSD1306_fadeSetIdle(&fade, timeout, contrast, duration);
+                model.idleTimeout  = timeout;
+                model.idleContrast = contrast;
+                model.idleDuration = duration;
+                model.lastActivity = System_currentTick();
+            }
+            break;
+        case 6:
+            snprintf(mOperation, sizeof(mOperation), "step %u, activity", (unsigned)step);
+            SSD1306_fadeActivity(&fade);
+            model.lastActivity = System_currentTick();
+            if (model.isDimmed)
+            {
+                model.isDimmed = FALSE;
+                startModelFade(&model, model.activeContrast, model.idleDuration);
+            }
+            break;
+        case 7:
+            snprintf(mOperation, sizeof(mOperation), "step %u, suspend", (unsigned)step);
+            SSD1306_suspend(dev);
+            model.isOn         = FALSE;
+            model.isChargePump = FALSE;
+            break;
+        case 8:
+            snprintf(mOperation, sizeof(mOperation), "step %u, resume", (unsigned)step);
+            SSD1306_resume(dev);
+            model.isOn         = TRUE;
+            model.isChargePump = dev->isChargePump;
+            break;
+        case 9:
+            {
+                // The power supply of the display was removed: the controller
+                // is reset, and its RAM holds random pixels
+                bool isPowerLost = Test_range(0, 1);
+                snprintf(mOperation, sizeof(mOperation), "step %u, restore%s",
+                         (unsigned)step, isPowerLost ? " after a power loss" : "");
+                if (isPowerLost)
+                {
+                    Simulator_reset();
+                    for (uint32_t i = 0; i < sizeof(controller->ram); ++i)
+                        ((uint8_t*)controller->ram)[i] = Test_random();
+                    model.isChargePump = FALSE;
+                }
+                SSD1306_restore(dev);
+                if (model.isOn)
+                    model.isChargePump = dev->isChargePump;
+                isRestored = TRUE;
+            }
+            break;
+        case 10:
+            snprintf(mOperation, sizeof(mOperation), "step %u, contrast %u", (unsigned)step, contrast);
+            SSD1306_setContrast(dev, contrast);
+            model.contrast = contrast;
+            break;
+        default:
+            {
+                uint32_t elapsed = Test_range(0, 60);
+                Simulator_advance(elapsed);
+                snprintf(mOperation, sizeof(mOperation), "step %u, process after %u ms",
+                         (unsigned)step, (unsigned)elapsed);
+                bool isRunning = SSD1306_fadeProcess(&fade);
+                processModelFade(&model);
+                TEST_CHECK(isRunning == (model.mode != SSD1306_FADEMODE_NONE),
+                           "%s: the process returns %d", mOperation, isRunning);
+            }
+            break;
+        }
+
+        TEST_CHECK(controller->errors == 0, "%s: %u transactions rejected", mOperation, (unsigned)controller->errors);
+        TEST_CHECK((controller->contrast == model.contrast) && (dev->contrast == model.contrast),
+                   "%s: contrast %u, device %u, expected %ld",
+                   mOperation, controller->contrast, dev->contrast, (long)model.contrast);
+        TEST_CHECK((controller->isOn == model.isOn) && (dev->isSuspended == !model.isOn),
+                   "%s: display on %d, suspended %d, expected on %d",
+                   mOperation, controller->isOn, dev->isSuspended, model.isOn);
+        TEST_CHECK(controller->isChargePump == model.isChargePump, "%s: charge pump %d, expected %d",
+                   mOperation, controller->isChargePump, model.isChargePump);
+        TEST_CHECK(!controller->isOn || (controller->isChargePump == dev->isChargePump),
+                   "%s: display on, charge pump %d", mOperation, controller->isChargePump);
+
+        // Only the restore sends the buffer, and the display shows it again
+        if (isRestored)
+            compareDisplay(dev->gdl.width, dev->gdl.height);
+        else
+            TEST_CHECK(controller->dataBytes == 0, "%s: %u data bytes sent", mOperation, (unsigned)controller->dataBytes);
+        compareBuffer(dev, dev->gdl.width, dev->gdl.height);
+    }
+}
+
+int main (void)
+{
+    testCanvas(1, 0xCA1);
+    testCanvas(2, 0xCA2);
+    testSprite(0x5A1);
+    testSprite(0x5A2);
+    testWidgets(0x3D1);
+    testWidgets(0x3D2);
+    testPlot(0x9101);
+    testConsole(SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1, TRUE, 0xC01);
+    testConsole(SSD1306_PRODUCT_ADAFRUIT_931, FALSE, 0xC02);
+    testFade(SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1, 0xFAD1);
+    testFade(SSD1306_PRODUCT_ADAFRUIT_931, 0xFAD2);
+
+    return Test_end("modules");
+}
@@ -0,0 +1,387 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+/*!
+ * \file  /tests/test_planner.c
+ * \brief Flush planner against the simulated controller.
+ *
+ * Random sets of regions are flushed with random start lines, on both
+ * products and with several cost models. For every flush the test checks
+ * that:
+ *
+ * - the regions on the display show the buffer, and the rest of the display
+ *   RAM is unchanged or shows the buffer too;
+ * - the controller accepts every transaction;
+ * - a single block costs, on the bus, the cheapest of the three addressing
+ *   modes, mode change included;
+ * - the whole flush costs no more than sending each block by itself with
+ *   the horizontal mode, and stays close to the optimum found by trying
+ *   every grouping of the blocks.
+ *
+ * Every cost model must use all three addressing modes.
+ */
+
+#include "harness.h"
+
+#define PLANNER_CASES                            1500
+#define PLANNER_MAX_REGIONS                      6
+#define PLANNER_MAX_BLOCKS                       (2 * PLANNER_MAX_REGIONS)
+#define PLANNER_OPTIMUM_BLOCKS                   8
+
+/*! Total cost over the optimum, in per mille */
+#define PLANNER_OPTIMUM_MARGIN                   1100
+
+static SSD1306_Device_t mDevice;
+
+typedef struct _Planner_Block_t
+{
+    uint8_t pageStart;
+    uint8_t pageEnd;
+    uint8_t colStart;
+    uint8_t colEnd;
+} Planner_Block_t;
+
+typedef struct _Planner_Model_t
+{
+    const char* name;
+    SSD1306_CostModel_t cost;
+} Planner_Model_t;
+
+static uint64_t mPlannerTotal;
+static uint64_t mOptimumTotal;
+static uint64_t mHorizontalTotal;
+
+/*!
+ * The function returns the bus cost of a block with an addressing mode: the
+ * command sequences that the controller needs to write the block.
+ */
+static uint32_t getCost (const SSD1306_CostModel_t* cost, const Planner_Block_t* block, uint8_t mode)
+{
+    uint32_t pages = block->pageEnd - block->pageStart + 1;
+    uint32_t bytes = pages * (block->colEnd - block->colStart + 1);
+    uint32_t transactions, commands;
+
+    switch (mode)
+    {
+    case 0:
+        // Window, then one transaction for each page
+        transactions = 1 + pages;
+        commands     = 6;
+        break;
+    case 1:
+        // Window, then the columns in transactions of 128 bytes at most
+        transactions = 1 + (bytes + 127) / 128;
+        commands     = 6;
+        break;
+    default:
+        // Page and column, then the data, for each page
+        transactions = 2 * pages;
+        commands     = 3 * pages;
+        break;
+    }
+    return transactions * cost->transaction + commands * cost->command + bytes * cost->data;
+}
+
+static uint32_t getBestCost (const SSD1306_CostModel_t* cost, const Planner_Block_t* block)
+{
+    uint32_t best = getCost(cost, block, 0);
+    for (uint8_t mode = 1; mode < 3; ++mode)
+    {
+        uint32_t value = getCost(cost, block, mode);
+        if (value < best) best = value;
+    }
+    return best;
+}
+
+/*!
+ * The function returns the cheapest cost of the blocks, trying every
+ * grouping: each group is sent as its bounding box. The mode changes are
+ * not counted.
+ */
+static uint32_t getOptimum (const SSD1306_CostModel_t* cost, const Planner_Block_t* blocks, uint8_t count)
+{
+    uint8_t group [PLANNER_OPTIMUM_BLOCKS] = {0};
+    uint8_t highest [PLANNER_OPTIMUM_BLOCKS] = {0};
+    uint32_t best = UINT32_MAX;
+
+    // Restricted growth strings: every partition once
+    while (TRUE)
+    {
+        uint8_t groups = 0;
+        for (uint8_t i = 0; i < count; ++i)
+            if ((group[i] + 1) > groups) groups = group[i] + 1;
+
+        uint32_t total = 0;
+        for (uint8_t g = 0; g < groups; ++g)
+        {
+            Planner_Block_t box = { 0xFF, 0, 0xFF, 0 };
+            for (uint8_t i = 0; i < count; ++i)
+            {
+                if (group[i] != g) continue;
+                if (blocks[i].pageStart < box.pageStart) box.pageStart = blocks[i].pageStart;
+                if (blocks[i].pageEnd > box.pageEnd)     box.pageEnd   = blocks[i].pageEnd;
+                if (blocks[i].colStart < box.colStart)   box.colStart  = blocks[i].colStart;
+                if (blocks[i].colEnd > box.colEnd)       box.colEnd    = blocks[i].colEnd;
+            }
+            total += getBestCost(cost, &box);
+        }
+        if (total < best) best = total;
+
+        // Next string
+        int8_t i = count - 1;
+        while ((i > 0) && (group[i] > highest[i - 1])) i--;
+        if (i <= 0) break;
+        group[i]++;
+        highest[i] = (group[i] > highest[i - 1]) ? group[i] : highest[i - 1];
+        for (uint8_t j = i + 1; j < count; ++j)
+        {
+            group[j]   = 0;
+            highest[j] = highest[i];
+        }
+    }
+    return best;
+}
+
+/*!
+ * The function splits the regions into blocks of display RAM, like the
+ * driver: clipped, and divided where they wrap around the end of the RAM.
+ */
+static uint8_t getBlocks (const SSD1306_Region_t* regions, uint8_t count, Planner_Block_t* blocks)
+{
+    uint8_t blockCount = 0;
+
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        uint16_t xPos = regions[i].xPos, yPos = regions[i].yPos;
+        uint16_t width = regions[i].width, height = regions[i].height;
+
+        if ((xPos >= mDevice.gdl.width) || (yPos >= mDevice.gdl.height) || (width == 0) || (height == 0))
+            continue;
+        if (width > (mDevice.gdl.width - xPos))   width  = mDevice.gdl.width - xPos;
+        if (height > (mDevice.gdl.height - yPos)) height = mDevice.gdl.height - yPos;
+
+        uint16_t rowStart = (yPos + mDevice.startLine) % 64;
+        uint16_t rowEnd   = rowStart + height - 1;
+        Planner_Block_t block = { rowStart / 8, 0, xPos, xPos + width - 1 };
+        if (rowEnd < 64)
+        {
+            block.pageEnd = rowEnd / 8;
+            blocks[blockCount++] = block;
+        }
+        else
+        {
+            block.pageEnd = 7;
+            blocks[blockCount++] = block;
+            block.pageStart = 0;
+            block.pageEnd   = (rowEnd - 64) / 8;
+            blocks[blockCount++] = block;
+        }
+    }
+    return blockCount;
+}
+
+static uint16_t getSize (uint16_t limit)
+{
+    switch (Test_range(0, 4))
+    {
+    case 0:  return Test_range(1, 3);
+    case 1:  return Test_range(1, 12);
+    case 2:  return Test_range(limit - 8, limit + 20);
+    default: return Test_range(0, limit);
+    }
+}
+
+static void checkCase (const Planner_Model_t* model, uint16_t product, uint32_t index)
+{
+    static uint8_t before [8][128];
+    SSD1306_Region_t regions [PLANNER_MAX_REGIONS];
+    Planner_Block_t blocks [PLANNER_MAX_BLOCKS];
+    Simulator_Controller_t* c = Simulator_get();
+    const SSD1306_CostModel_t* cost = &model->cost;
+
+    Test_initDevice(&mDevice, product);
+    SSD1306_setCostModel(&mDevice, cost);
+
+    // The start line is sent before the test, the mode is a random one
+    SSD1306_scrollLines(&mDevice, Test_range(0, 63));
+    SSD1306_flushRegions(&mDevice, NULL, 0);
+    SSD1306_Region_t first = { Test_range(0, 127), Test_range(0, 63), Test_range(1, 128), Test_range(1, 64) };
+    SSD1306_flushRegions(&mDevice, &first, 1);
+
+    for (uint32_t i = 0; i < SSD1306_BUFFER_DIMENSION; ++i)
+        mDevice.buffer[i] = Test_random();
+    for (uint8_t page = 0; page < 8; ++page)
+        for (uint8_t column = 0; column < 128; ++column)
+            c->ram[page][column] = Test_random();
+    memcpy(before, c->ram, sizeof(before));
+
+    uint8_t count = Test_range(1, PLANNER_MAX_REGIONS);
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        regions[i].xPos   = Test_range(0, 4) ? Test_range(0, 127) : Test_range(120, 140);
+        regions[i].yPos   = Test_range(0, 4) ? Test_range(0, mDevice.gdl.height - 1) : Test_range(0, 70);
+        regions[i].width  = getSize(mDevice.gdl.width);
+        regions[i].height = getSize(mDevice.gdl.height);
+    }
+    uint8_t blockCount = getBlocks(regions, count, blocks);
+    uint8_t mode = c->addressingMode;
+
+    Simulator_resetCounters();
+    SSD1306_flushRegions(&mDevice, regions, count);
+    uint32_t measured = c->transactions * cost->transaction +
+                        c->commandBytes * cost->command +
+                        c->dataBytes * cost->data;
+
+    TEST_CHECK(c->errors == 0, "%s %u: transactions rejected", model->name, index);
+
+    // The regions show the buffer
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        for (uint16_t y = regions[i].yPos; (y < (regions[i].yPos + regions[i].height)) && (y < mDevice.gdl.height); ++y)
+        {
+            for (uint16_t x = regions[i].xPos; (x < (regions[i].xPos + regions[i].width)) && (x < mDevice.gdl.width); ++x)
+            {
+                if (Simulator_getPixel(x, y) != Test_getBufferPixel(&mDevice, x, y))
+                {
+                    TEST_CHECK(FALSE, "%s %u: display pixel %u,%u", model->name, index, x, y);
+                    i = count;
+                    y = 0xFFFF - 1;
+                    break;
+                }
+            }
+        }
+    }
+
+    // The rest of the RAM is unchanged, or it shows the buffer
+    for (uint8_t page = 0; page < 8; ++page)
+    {
+        for (uint8_t column = 0; column < 128; ++column)
+        {
+            uint8_t value = c->ram[page][column];
+            if ((value != before[page][column]) && (value != mDevice.buffer[page * 128 + column]))
+            {
+                TEST_CHECK(FALSE, "%s %u: RAM page %u column %u is garbage", model->name, index, page, column);
+                page = 8;
+                break;
+            }
+        }
+    }
+
+    // A single block: the cheapest mode, on the bus too
+    if (blockCount == 1)
+    {
+        uint32_t best = UINT32_MAX;
+        for (uint8_t m = 0; m < 3; ++m)
+        {
+            uint32_t value = getCost(cost, &blocks[0], m) + ((m != mode) ? (2 * cost->command) : 0);
+            if (value < best) best = value;
+        }
+        TEST_CHECK(measured == best, "%s %u: one block costs %u, cheapest %u",
+                   model->name, index, (unsigned)measured, (unsigned)best);
+    }
+
+    // Never worse than a horizontal window for each block; the mode
+    // changes are free for the alternative, so they are not counted
+    uint32_t horizontal = 0;
+    for (uint8_t i = 0; i < blockCount; ++i)
+        horizontal += getCost(cost, &blocks[i], 0);
+
+    TEST_CHECK(measured <= horizontal + (blockCount * 2 * cost->command),
+               "%s %u: %u blocks cost %u, horizontal windows %u",
+               model->name, index, blockCount, (unsigned)measured, (unsigned)horizontal);
+
+    if ((blockCount > 0) && (blockCount <= PLANNER_OPTIMUM_BLOCKS))
+    {
+        uint32_t optimum = getOptimum(cost, blocks, blockCount);
+        TEST_CHECK(measured >= optimum, "%s %u: cost %u under the optimum %u",
+                   model->name, index, (unsigned)measured, (unsigned)optimum);
+        mPlannerTotal    += measured;
+        mOptimumTotal    += optimum;
+        mHorizontalTotal += horizontal;
+    }
+}
+
+static void testModel (const Planner_Model_t* model, bool isModesChecked)
+{
+    uint32_t modeBytes [3] = {0};
+
+    mPlannerTotal    = 0;
+    mOptimumTotal    = 0;
+    mHorizontalTotal = 0;
+
+    for (uint32_t i = 0; i < PLANNER_CASES; ++i)
+    {
+        uint16_t product = (i & 1) ? SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1 : SSD1306_PRODUCT_ADAFRUIT_931;
+        checkCase(model, product, i);
+        for (uint8_t m = 0; m < 3; ++m) modeBytes[m] += Simulator_get()->modeBytes[m];
+    }
+
+    printf("%-24s horizontal %5.1f%%   vertical %5.1f%%   page %5.1f%%   cost over optimum %+5.1f%%   over horizontal windows %+5.1f%%\n",
+           model->name,
+           100.0 * modeBytes[0] / (modeBytes[0] + modeBytes[1] + modeBytes[2]),
+           100.0 * modeBytes[1] / (modeBytes[0] + modeBytes[1] + modeBytes[2]),
+           100.0 * modeBytes[2] / (modeBytes[0] + modeBytes[1] + modeBytes[2]),
+           100.0 * mPlannerTotal / mOptimumTotal - 100.0,
+           100.0 * mPlannerTotal / mHorizontalTotal - 100.0);
+
+    if (isModesChecked)
+    {
+        TEST_CHECK((modeBytes[0] > 0) && (modeBytes[1] > 0) && (modeBytes[2] > 0),
+                   "%s: the modes used are %u %u %u bytes", model->name,
+                   (unsigned)modeBytes[0], (unsigned)modeBytes[1], (unsigned)modeBytes[2]);
+    }
+    TEST_CHECK((mPlannerTotal * 1000) <= (mOptimumTotal * PLANNER_OPTIMUM_MARGIN),
+               "%s: total cost %llu, optimum %llu", model->name,
+               (unsigned long long)mPlannerTotal, (unsigned long long)mOptimumTotal);
+    TEST_CHECK(mPlannerTotal <= mHorizontalTotal, "%s: total cost %llu, horizontal windows %llu",
+               model->name, (unsigned long long)mPlannerTotal, (unsigned long long)mHorizontalTotal);
+}
+
+int main (void)
+{
+    static const Planner_Model_t models[] =
+    {
+        { "I2C",      { 20, 9, 9 } },
+        { "SPI",      { 2, 8, 8 } },
+        { "parallel", { 1, 1, 1 } },
+    };
+
+    Test_seed(0x39);
+    for (uint8_t i = 0; i < (sizeof(models) / sizeof(models[0])); ++i)
+        testModel(&models[i], TRUE);
+
+    // Random models: the invariants hold whatever the weights are
+    for (uint8_t i = 0; i < 6; ++i)
+    {
+        char name [32];
+        Planner_Model_t model = { name, { Test_range(0, 100), Test_range(0, 20), Test_range(1, 20) } };
+        snprintf(name, sizeof(name), "random %u/%u/%u", model.cost.transaction, model.cost.command, model.cost.data);
+        testModel(&model, FALSE);
+    }
+
+    return Test_end("planner");
+}
@@ -0,0 +1,460 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+/*!
+ * \file  /tests/test_render.c
+ * \brief Randomized comparison of the drawing functions and of the flush
+ *        with the reference rasterizers and the simulated controller.
+ *
+ * Every step draws a random primitive, with the positions concentrated on
+ * the edges of the display and of the clip area, and compares the whole
+ * internal buffer with the reference screen. The clip areas, the scrolls,
+ * which move the display start line to unaligned rows, and the flushes of
+ * random regions are mixed with the drawing.
+ */
+
+#include "harness.h"
+#include "reference.h"
+
+#define RENDER_STEPS                             6000
+#define RENDER_MAX_POINTS                        8
+#define RENDER_MAX_REGIONS                       8
+
+static SSD1306_Device_t mDevice;
+static Reference_Screen_t mScreen;
+static char mOperation [96];
+
+/*!
+ * Clip areas pushed on the device, computed again by the test.
+ */
+static int32_t mClip [SSD1306_CLIP_STACK_DIMENSION + 1][4];
+static uint8_t mClipDepth;
+
+/*!
+ * The function returns a random position, often near to zero, near to the
+ * limit or near to the edges of the clip area.
+ */
+static int32_t getPosition (int32_t limit, int32_t clipStart, int32_t clipStop)
+{
+    switch (Test_range(0, 5))
+    {
+    case 0:  return Test_range(-2, 2);
+    case 1:  return limit + Test_range(-2, 2);
+    case 2:  return clipStart + Test_range(-2, 2);
+    case 3:  return clipStop + Test_range(-2, 2);
+    default: return Test_range(-limit / 4, limit + limit / 4);
+    }
+}
+
+static int32_t getX (void)
+{
+    return getPosition(mScreen.width, mScreen.xStart, mScreen.xStop);
+}
+
+static int32_t getY (void)
+{
+    return getPosition(mScreen.height, mScreen.yStart, mScreen.yStop);
+}
+
+/*!
+ * The function returns a random length, often small.
+ */
+static int32_t getLength (int32_t limit)
+{
+    return (Test_range(0, 2) == 0) ? Test_range(0, 3) : Test_range(0, limit);
+}
+
+static void compareBuffer (uint32_t step)
+{
+    for (int32_t y = 0; y < mScreen.height; ++y)
+    {
+        for (int32_t x = 0; x < mScreen.width; ++x)
+        {
+            bool expected = Reference_getPixel(&mScreen, x, y);
+            bool actual   = Test_getBufferPixel(&mDevice, x, y);
+            if (expected != actual)
+            {
+                TEST_CHECK(FALSE, "step %u, %s, start line %u: pixel %d,%d is %d, expected %d",
+                           (unsigned)step, mOperation, mDevice.startLine, x, y, actual, expected);
+
+                // Go on from the buffer of the library
+                for (y = 0; y < mScreen.height; ++y)
+                    for (x = 0; x < mScreen.width; ++x)
+                        mScreen.pixels[y][x] = Test_getBufferPixel(&mDevice, x, y);
+                return;
+            }
+        }
+    }
+}
+
+static void compareDisplay (uint32_t step, const SSD1306_Region_t* region)
+{
+    TEST_CHECK(Simulator_get()->errors == 0, "step %u, %s: %u transactions rejected",
+               (unsigned)step, mOperation, (unsigned)Simulator_get()->errors);
+    TEST_CHECK(Simulator_get()->startLine == mDevice.startLine,
+               "step %u, %s: display start line %u, expected %u",
+               (unsigned)step, mOperation, Simulator_get()->startLine, mDevice.startLine);
+    Simulator_get()->errors = 0;
+
+    for (int32_t y = region->yPos; (y < (region->yPos + region->height)) && (y < mScreen.height); ++y)
+    {
+        for (int32_t x = region->xPos; (x < (region->xPos + region->width)) && (x < mScreen.width); ++x)
+        {
+            bool expected = Reference_getPixel(&mScreen, x, y);
+            if (Simulator_getPixel(x, y) != expected)
+            {
+                TEST_CHECK(FALSE, "step %u, %s, start line %u: display pixel %d,%d, expected %d",
+                           (unsigned)step, mOperation, mDevice.startLine, x, y, expected);
+                return;
+            }
+        }
+    }
+}
+
+static void setClip (void)
+{
+    int32_t* clip = mClip[mClipDepth];
+    Reference_setClip(&mScreen, clip[0], clip[1], clip[2], clip[3]);
+}
+
+static void drawClip (void)
+{
+    int32_t operation = Test_range(0, 4);
+
+    if ((operation < 3) && (mClipDepth < SSD1306_CLIP_STACK_DIMENSION))
+    {
+        int32_t x = Test_range(0, mScreen.width + 8);
+        int32_t y = Test_range(0, mScreen.height + 8);
+        int32_t w = getLength(mScreen.width);
+        int32_t h = getLength(mScreen.height);
+        snprintf(mOperation, sizeof(mOperation), "pushClip(%d,%d,%d,%d)", x, y, w, h);
+        SSD1306_pushClip(&mDevice, x, y, w, h);
+
+        // Intersection with the current area, empty when they do not overlap
+        int32_t* old = mClip[mClipDepth];
+        int32_t* clip = mClip[++mClipDepth];
+        clip[0] = (x > old[0]) ? x : old[0];
+        clip[1] = (y > old[1]) ? y : old[1];
+        clip[2] = ((x + w) < old[2]) ? (x + w) : old[2];
+        clip[3] = ((y + h) < old[3]) ? (y + h) : old[3];
+        if ((clip[0] >= clip[2]) || (clip[1] >= clip[3]))
+        {
+            clip[0] = old[0];
+            clip[1] = old[1];
+            clip[2] = old[0];
+            clip[3] = old[1];
+        }
+    }
+    else if ((operation < 4) && (mClipDepth > 0))
+    {
+        snprintf(mOperation, sizeof(mOperation), "popClip()");
+        SSD1306_popClip(&mDevice);
+        mClipDepth--;
+    }
+    else
+    {
+        snprintf(mOperation, sizeof(mOperation), "resetClip()");
+        SSD1306_resetClip(&mDevice);
+        mClipDepth = 0;
+    }
+    setClip();
+}
+
+static void drawPrimitive (void)
+{
+    bool color = Test_range(0, 1);
+
+    switch (Test_range(0, 12))
+    {
+    case 0:
+        {
+            int32_t x = Test_range(0, 255);
+            int32_t y = Test_range(0, 255);
+            if (Test_range(0, 1)) { x = getX() & 0xFF; y = getY() & 0xFF; }
+            snprintf(mOperation, sizeof(mOperation), "drawPixel(%d,%d,%d)", x, y, color);
+            SSD1306_drawPixel(&mDevice, x, y, color);
+            Reference_drawPixel(&mScreen, x, y, color);
+        }
+        break;
+    case 1:
+        {
+            // Horizontal, vertical or diagonal
+            int32_t x0 = getX() & 0xFF, y0 = getY() & 0xFF;
+            int32_t x1 = getX() & 0xFF, y1 = getY() & 0xFF;
+            if (Test_range(0, 2) == 0) y1 = y0;
+            else if (Test_range(0, 1) == 0) x1 = x0;
+            snprintf(mOperation, sizeof(mOperation), "drawLine(%d,%d,%d,%d,%d)", x0, y0, x1, y1, color);
+            SSD1306_drawLine(&mDevice, x0, y0, x1, y1, color);
+            Reference_drawLine(&mScreen, x0, y0, x1, y1, color);
+        }
+        break;
+    case 2:
+        {
+            int32_t x = Test_range(0, mScreen.width + 4), y = Test_range(0, mScreen.height + 4);
+            int32_t w = getLength(mScreen.width + 8), h = getLength(mScreen.height + 8);
+            bool isFill = Test_range(0, 1);
+            snprintf(mOperation, sizeof(mOperation), "drawRectangle(%d,%d,%d,%d,%d,%d)", x, y, w, h, color, isFill);
+            SSD1306_drawRectangle(&mDevice, x, y, w, h, color, isFill);
+            if (isFill) Reference_fillRectangle(&mScreen, x, y, w, h, color);
+            else        Reference_drawRectangle(&mScreen, x, y, w, h, color);
+        }
+        break;
+    case 3:
+        {
+            int32_t x = getX(), y = getY();
+            int32_t a = getLength(60), b = getLength(40);
+            if (Test_range(0, 1))
+            {
+                snprintf(mOperation, sizeof(mOperation), "fillCircle(%d,%d,%d,%d)", x, y, a, color);
+                SSD1306_fillCircle(&mDevice, x, y, a, color);
+                Reference_fillEllipse(&mScreen, x, y, a, a, color);
+            }
+            else
+            {
+                snprintf(mOperation, sizeof(mOperation), "fillEllipse(%d,%d,%d,%d,%d)", x, y, a, b, color);
+                SSD1306_fillEllipse(&mDevice, x, y, a, b, color);
+                Reference_fillEllipse(&mScreen, x, y, a, b, color);
+            }
+        }
+        break;
+    case 4:
+        {
+            int32_t x = getX(), y = getY();
+            int32_t w = getLength(mScreen.width), h = getLength(mScreen.height);
+            int32_t r = getLength(40);
+            snprintf(mOperation, sizeof(mOperation), "fillRoundRectangle(%d,%d,%d,%d,%d,%d)", x, y, w, h, r, color);
+            SSD1306_fillRoundRectangle(&mDevice, x, y, w, h, r, color);
+            Reference_fillRoundRectangle(&mScreen, x, y, w, h, r, color);
+        }
+        break;
+    case 5:
+        {
+            SSD1306_Point_t points [RENDER_MAX_POINTS];
+            uint8_t count = Test_range(1, RENDER_MAX_POINTS);
+            int32_t length = snprintf(mOperation, sizeof(mOperation), "fillPolygon(%d:", color);
+            for (uint8_t i = 0; i < count; ++i)
+            {
+                points[i].x = getX() + Test_range(-40, 40);
+                points[i].y = getY() + Test_range(-20, 20);
+                if (length < (int32_t)sizeof(mOperation))
+                    length += snprintf(&mOperation[length], sizeof(mOperation) - length, " %d,%d", points[i].x, points[i].y);
+            }
+            if (count == 3)
+                SSD1306_fillTriangle(&mDevice, points[0].x, points[0].y, points[1].x, points[1].y,
+                                     points[2].x, points[2].y, color);
+            else
+                SSD1306_fillPolygon(&mDevice, points, count, color);
+            Reference_fillPolygon(&mScreen, points, count, color);
+        }
+        break;
+    case 6:
+        {
+            int32_t x = getX() & 0xFF, y = (getY() - Test_range(0, 7)) & 0xFF;
+            uint8_t bits = Test_random(), mask = Test_random();
+            snprintf(mOperation, sizeof(mOperation), "writeColumn(%d,%d,0x%02X,0x%02X)", x, y, bits, mask);
+            SSD1306_writeColumn(&mDevice, x, y, bits, mask);
+            Reference_writeColumn(&mScreen, x, y, bits, mask);
+        }
+        break;
+    case 7:
+        {
+            uint8_t picture [6 * 40];
+            int32_t x = Test_range(0, mScreen.width + 2), y = Test_range(0, mScreen.height + 2);
+            int32_t w = Test_range(1, 40), h = Test_range(1, 40);
+            for (uint32_t i = 0; i < sizeof(picture); ++i) picture[i] = Test_random();
+            snprintf(mOperation, sizeof(mOperation), "drawPicture(%d,%d,%d,%d)", x, y, w, h);
+            SSD1306_drawPicture(&mDevice, x, y, w, h, picture);
+            Reference_drawPicture(&mScreen, x, y, w, h, picture);
+        }
+        break;
+    case 8:
+        {
+            int32_t x = Test_range(0, mScreen.width + 2), y = Test_range(0, mScreen.height + 2);
+            uint8_t size = Test_range(1, 3);
+            const char* text = (Test_range(0, 1)) ? "A b" : "0";
+            snprintf(mOperation, sizeof(mOperation), "drawString(%d,%d,\"%s\",%d,%d)", x, y, text, color, size);
+            SSD1306_drawString(&mDevice, x, y, text, color, size);
+            for (int32_t i = 0; text[i] != '\0'; ++i)
+                Reference_drawChar(&mScreen, x + i * 6 * size, y, text[i], color, size);
+        }
+        break;
+    case 9:
+        {
+            uint8_t lines = (Test_range(0, 3) == 0) ? Test_range(0, 70) : Test_range(1, 9);
+            snprintf(mOperation, sizeof(mOperation), "scrollLines(%d)", lines);
+            SSD1306_scrollLines(&mDevice, lines);
+            Reference_scroll(&mScreen, lines);
+        }
+        break;
+    case 10:
+        {
+            // The area must be inside the display, otherwise nothing changes
+            int32_t size = 8 * Test_range(1, mScreen.height / 8);
+            int32_t x = Test_range(0, mScreen.width - size), y = Test_range(0, mScreen.height - size);
+            int32_t turns = Test_range(1, 3);
+            if (Test_range(0, 7) == 0) x = mScreen.width - size + Test_range(1, 8);
+            snprintf(mOperation, sizeof(mOperation), "rotateArea(%d,%d,%d,%d)", x, y, size, turns * 90);
+            GDL_Errors_t error = SSD1306_rotateArea(&mDevice, x, y, size, (SSD1306_Rotation_t)(SSD1306_ROTATION_90 + turns - 1));
+            if ((x + size) <= mScreen.width)
+                Reference_rotate(&mScreen, x, y, size, turns);
+            TEST_CHECK((error == GDL_ERRORS_SUCCESS) == ((x + size) <= mScreen.width), "%s: error %d", mOperation, error);
+        }
+        break;
+    case 11:
+        {
+            SSD1306_Orientation_t orientation = (SSD1306_Orientation_t)Test_range(0, 3);
+            bool isRemapChanged = ((mDevice.orientation ^ orientation) & SSD1306_ORIENTATION_MIRROR_X) != 0;
+            bool isMirrorX = (orientation & SSD1306_ORIENTATION_MIRROR_X) != 0;
+            bool isMirrorY = (orientation & SSD1306_ORIENTATION_MIRROR_Y) != 0;
+            uint32_t dataBytes = Simulator_get()->dataBytes;
+            snprintf(mOperation, sizeof(mOperation), "setOrientation(%d)", orientation);
+            SSD1306_setOrientation(&mDevice, orientation);
+
+            TEST_CHECK(Simulator_get()->isSegmentRemap == (mDevice.isSegmentRemap != isMirrorX),
+                       "%s: segment re-map %d", mOperation, Simulator_get()->isSegmentRemap);
+            TEST_CHECK(Simulator_get()->isComScanDown == (mDevice.isComScanDown != isMirrorY),
+                       "%s: COM scan down %d", mOperation, Simulator_get()->isComScanDown);
+            // The data must be written again with the new segment re-map
+            if (isRemapChanged)
+            {
+                TEST_CHECK((Simulator_get()->dataBytes - dataBytes) >= (uint32_t)(mScreen.width * mScreen.height / 8),
+                           "%s: %u data bytes sent", mOperation, (unsigned)(Simulator_get()->dataBytes - dataBytes));
+                SSD1306_Region_t all = { 0, 0, mScreen.width, mScreen.height };
+                compareDisplay(0, &all);
+            }
+            else
+            {
+                TEST_CHECK(Simulator_get()->dataBytes == dataBytes, "%s: data sent", mOperation);
+            }
+        }
+        break;
+    default:
+        drawClip();
+        break;
+    }
+}
+
+static void flushRandom (uint32_t step)
+{
+    SSD1306_Region_t regions [RENDER_MAX_REGIONS];
+    uint8_t count = Test_range(1, RENDER_MAX_REGIONS);
+
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        regions[i].xPos   = Test_range(0, mScreen.width + 4);
+        regions[i].yPos   = Test_range(0, mScreen.height + 4);
+        regions[i].width  = getLength(mScreen.width);
+        regions[i].height = getLength(mScreen.height);
+    }
+
+    switch (Test_range(0, 3))
+    {
+    case 0:
+        snprintf(mOperation, sizeof(mOperation), "flush()");
+        SSD1306_flush(&mDevice);
+        regions[0].xPos   = 0;
+        regions[0].yPos   = 0;
+        regions[0].width  = mScreen.width;
+        regions[0].height = mScreen.height;
+        count = 1;
+        break;
+    case 1:
+        snprintf(mOperation, sizeof(mOperation), "flushArea(%u,%u,%u,%u)",
+                 regions[0].xPos, regions[0].yPos, regions[0].width, regions[0].height);
+        SSD1306_flushArea(&mDevice, regions[0].xPos, regions[0].yPos, regions[0].width, regions[0].height);
+        count = 1;
+        break;
+    default:
+        snprintf(mOperation, sizeof(mOperation), "flushRegions(%u regions)", count);
+        SSD1306_flushRegions(&mDevice, regions, count);
+        break;
+    }
+
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        compareDisplay(step, &regions[i]);
+    }
+}
+
+static void testProduct (uint16_t product, uint32_t seed)
+{
+    Test_initDevice(&mDevice, product);
+    Reference_init(&mScreen, mDevice.gdl.width, mDevice.gdl.height);
+    mClipDepth = 0;
+    mClip[0][0] = 0;
+    mClip[0][1] = 0;
+    mClip[0][2] = mScreen.width;
+    mClip[0][3] = mScreen.height;
+    Test_seed(seed);
+
+    // The display RAM has random content after the power up
+    for (int32_t i = 0; i < SIMULATOR_PAGES * SIMULATOR_COLUMNS; ++i)
+        Simulator_get()->ram[i / SIMULATOR_COLUMNS][i % SIMULATOR_COLUMNS] = Test_random();
+
+    for (uint32_t step = 0; step < RENDER_STEPS; ++step)
+    {
+        if (Test_range(0, 7) == 0)
+        {
+            flushRandom(step);
+        }
+        else if (Test_range(0, 150) == 0)
+        {
+            snprintf(mOperation, sizeof(mOperation), "clear()");
+            SSD1306_clear(&mDevice);
+            Reference_setClip(&mScreen, 0, 0, mScreen.width, mScreen.height);
+            Reference_fillRectangle(&mScreen, 0, 0, mScreen.width, mScreen.height, FALSE);
+            setClip();
+
+            SSD1306_Region_t all = { 0, 0, mScreen.width, mScreen.height };
+            compareDisplay(step, &all);
+        }
+        else
+        {
+            drawPrimitive();
+        }
+        compareBuffer(step);
+    }
+
+    // At the end, the whole display must show the reference screen
+    SSD1306_flush(&mDevice);
+    SSD1306_Region_t all = { 0, 0, mScreen.width, mScreen.height };
+    snprintf(mOperation, sizeof(mOperation), "final flush()");
+    compareDisplay(RENDER_STEPS, &all);
+}
+
+int main (void)
+{
+    testProduct(SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1, 0x5EED1306);
+    testProduct(SSD1306_PRODUCT_ADAFRUIT_931, 0x00931931);
+    testProduct(SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1, 0x0BADCAFE);
+
+#if defined (SSD1306_REFERENCE_RENDERER)
+    return Test_end("render (reference renderer)");
+#else
+    return Test_end("render");
+#endif
+}
@@ -0,0 +1,324 @@
+/*
+ * SSD1306 - Library for SSD1306 OLed Driver based on libohiboard
+ * Copyright (C) 2017-2019 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+/*!
+ * \file  /tests/test_shapes.c
+ * \brief Pixel-exact comparison of the shape rasterizers with the reference.
+ *
+ * The circles, ellipses, rounded rectangles, triangles and polygons are
+ * swept over their sizes and positions, degenerate cases and far away
+ * coordinates included, on a random background, with clip areas that cut
+ * every edge and with start lines that are not aligned to the pages.
+ */
+
+#include "harness.h"
+#include "reference.h"
+
+#include <math.h>
+#include <stdarg.h>
+
+#define SHAPES_CLIP_COUNT                        6
+#define SHAPES_START_LINE_COUNT                  3
+
+static SSD1306_Device_t mDevice;
+static Reference_Screen_t mScreen;
+static uint32_t mCases = 0;
+
+static const uint8_t mClips [SHAPES_CLIP_COUNT][4] =
+{
+    {   0,  0, 128, 64 },
+    {   1,  1, 126, 62 },
+    {   0,  0,  64, 32 },
+    {  37,  5,  50, 20 },
+    { 120, 27,   8,  4 },
+    {   0, 31, 128,  2 },
+};
+
+static const uint8_t mStartLines [SHAPES_START_LINE_COUNT] = { 0, 3, 61 };
+
+/*!
+ * The function prepares a case: random background, start line and clip
+ * area selected by the index.
+ */
+static void beginCase (uint32_t index)
+{
+    const uint8_t* clip = mClips[index % SHAPES_CLIP_COUNT];
+    uint8_t startLine = mStartLines[(index / SHAPES_CLIP_COUNT) % SHAPES_START_LINE_COUNT];
+
+    SSD1306_resetClip(&mDevice);
+    SSD1306_scrollLines(&mDevice, (startLine - mDevice.startLine) & (SIMULATOR_ROWS - 1));
+    for (uint32_t i = 0; i < SSD1306_BUFFER_DIMENSION; ++i)
+        mDevice.buffer[i] = Test_random();
+
+    Reference_setClip(&mScreen, 0, 0, mScreen.width, mScreen.height);
+    for (int32_t y = 0; y < mScreen.height; ++y)
+        for (int32_t x = 0; x < mScreen.width; ++x)
+            mScreen.pixels[y][x] = Test_getBufferPixel(&mDevice, x, y);
+
+    SSD1306_pushClip(&mDevice, clip[0], clip[1], clip[2], clip[3]);
+    Reference_setClip(&mScreen, clip[0], clip[1],
+                      (clip[0] + clip[2] < mScreen.width)  ? (clip[0] + clip[2]) : mScreen.width,
+                      (clip[1] + clip[3] < mScreen.height) ? (clip[1] + clip[3]) : mScreen.height);
+    mCases++;
+}
+
+static void endCase (const char* format, ...)
+{
+    for (int32_t y = 0; y < mScreen.height; ++y)
+    {
+        for (int32_t x = 0; x < mScreen.width; ++x)
+        {
+            if (Reference_getPixel(&mScreen, x, y) != Test_getBufferPixel(&mDevice, x, y))
+            {
+                char shape [96];
+                va_list args;
+                va_start(args, format);
+                vsnprintf(shape, sizeof(shape), format, args);
+                va_end(args);
+                TEST_CHECK(FALSE, "%s, clip %u,%u-%u,%u, start line %u: pixel %d,%d is %d",
+                           shape, mDevice.clip.xStart, mDevice.clip.yStart, mDevice.clip.xStop,
+                           mDevice.clip.yStop, mDevice.startLine, x, y, !Reference_getPixel(&mScreen, x, y));
+                return;
+            }
+        }
+    }
+}
+
+static void testEllipses (void)
+{
+    static const int16_t centers [][2] =
+    {
+        { 63, 31 }, { 0, 0 }, { 127, 63 }, { -7, 40 }, { 131, 66 }, { 90, -12 },
+    };
+    uint32_t index = 0;
+
+    for (uint32_t c = 0; c < (sizeof(centers) / sizeof(centers[0])); ++c)
+    {
+        for (int32_t a = 0; a <= 70; a += ((a < 12) ? 1 : 7))
+        {
+            for (int32_t b = 0; b <= 40; b += ((b < 12) ? 1 : 5))
+            {
+                bool color = index & 0x01;
+                beginCase(index++);
+                if (a == b)
+                {
+                    SSD1306_fillCircle(&mDevice, centers[c][0], centers[c][1], a, color);
+                    Reference_fillEllipse(&mScreen, centers[c][0], centers[c][1], a, a, color);
+                    endCase("fillCircle(%d,%d,%d)", centers[c][0], centers[c][1], a);
+                }
+                else
+                {
+                    SSD1306_fillEllipse(&mDevice, centers[c][0], centers[c][1], a, b, color);
+                    Reference_fillEllipse(&mScreen, centers[c][0], centers[c][1], a, b, color);
+                    endCase("fillEllipse(%d,%d,%d,%d)", centers[c][0], centers[c][1], a, b);
+                }
+            }
+        }
+    }
+
+    // The biggest radius, and centers far from the display
+    static const int16_t far [][2] =
+    {
+        { 64, 32 }, { -200, 32 }, { 64, 250 }, { -255, -255 }, { 382, 318 }, { -32768, 32767 },
+    };
+    for (uint32_t c = 0; c < (sizeof(far) / sizeof(far[0])); ++c)
+    {
+        beginCase(index++);
+        SSD1306_fillEllipse(&mDevice, far[c][0], far[c][1], 255, 255, TRUE);
+        Reference_fillEllipse(&mScreen, far[c][0], far[c][1], 255, 255, TRUE);
+        endCase("fillEllipse(%d,%d,255,255)", far[c][0], far[c][1]);
+
+        beginCase(index++);
+        SSD1306_fillEllipse(&mDevice, far[c][0], far[c][1], 255, 3, FALSE);
+        Reference_fillEllipse(&mScreen, far[c][0], far[c][1], 255, 3, FALSE);
+        endCase("fillEllipse(%d,%d,255,3)", far[c][0], far[c][1]);
+    }
+}
+
+static void testRoundRectangles (void)
+{
+    static const int16_t positions [][2] =
+    {
+        { 10, 5 }, { -3, -2 }, { 115, 55 }, { 0, 30 },
+    };
+    uint32_t index = 0;
+
+    for (uint32_t p = 0; p < (sizeof(positions) / sizeof(positions[0])); ++p)
+    {
+        for (int32_t w = 0; w <= 24; ++w)
+        {
+            for (int32_t h = 0; h <= 24; h += ((h < 10) ? 1 : 3))
+            {
+                for (int32_t r = 0; r <= 13; r += ((r < 4) ? 1 : 3))
+                {
+                    bool color = index & 0x01;
+                    beginCase(index++);
+                    SSD1306_fillRoundRectangle(&mDevice, positions[p][0], positions[p][1], w, h, r, color);
+                    Reference_fillRoundRectangle(&mScreen, positions[p][0], positions[p][1], w, h, r, color);
+                    endCase("fillRoundRectangle(%d,%d,%d,%d,%d)", positions[p][0], positions[p][1], w, h, r);
+                }
+            }
+        }
+    }
+
+    // Sides longer than the display, up to the biggest size
+    static const int32_t big [][4] =
+    {
+        { -20, -10, 170, 90 }, { 100, 40, 65535, 65535 }, { -30000, -30000, 60000, 60000 },
+        { 5, 5, 65535, 10 }, { 5, 5, 10, 65535 }, { -32768, 20, 65535, 20 },
+    };
+    for (uint32_t i = 0; i < (sizeof(big) / sizeof(big[0])); ++i)
+    {
+        for (int32_t r = 0; r <= 255; r += 85)
+        {
+            beginCase(index++);
+            SSD1306_fillRoundRectangle(&mDevice, big[i][0], big[i][1], big[i][2], big[i][3], r, TRUE);
+            Reference_fillRoundRectangle(&mScreen, big[i][0], big[i][1], big[i][2], big[i][3], r, TRUE);
+            endCase("fillRoundRectangle(%d,%d,%d,%d,%d)", big[i][0], big[i][1], big[i][2], big[i][3], r);
+        }
+    }
+}
+
+static void checkPolygon (uint32_t index, const SSD1306_Point_t* points, uint8_t count)
+{
+    bool color = index & 0x01;
+    char text [96];
+    int32_t length = snprintf(text, sizeof(text), "fillPolygon(");
+    for (uint8_t i = 0; (i < count) && (length < (int32_t)sizeof(text)); ++i)
+        length += snprintf(&text[length], sizeof(text) - length, " %d,%d", points[i].x, points[i].y);
+
+    beginCase(index);
+    if (count == 3)
+        SSD1306_fillTriangle(&mDevice, points[0].x, points[0].y, points[1].x, points[1].y,
+                             points[2].x, points[2].y, color);
+    else
+        SSD1306_fillPolygon(&mDevice, points, count, color);
+    Reference_fillPolygon(&mScreen, points, count, color);
+    endCase("%s)", text);
+}
+
+static void testPolygons (void)
+{
+    SSD1306_Point_t points [16];
+    uint32_t index = 0;
+
+    // Degenerate triangles: single point, horizontal, vertical and diagonal
+    // segments, in every order of the vertices
+    static const SSD1306_Point_t degenerate [][3] =
+    {
+        { { 20, 20 }, { 20, 20 }, { 20, 20 } },
+        { { 5, 10 }, { 90, 10 }, { 40, 10 } },
+        { { 33, -5 }, { 33, 70 }, { 33, 12 } },
+        { { 0, 0 }, { 127, 63 }, { 64, 32 } },
+        { { -40, 70 }, { 170, -9 }, { 65, 30 } },
+        { { 127, 0 }, { 127, 63 }, { 126, 31 } },
+    };
+    static const uint8_t orders [6][3] =
+    {
+        { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 }, { 2, 0, 1 }, { 2, 1, 0 },
+    };
+    for (uint32_t t = 0; t < (sizeof(degenerate) / sizeof(degenerate[0])); ++t)
+    {
+        for (uint32_t o = 0; o < 6; ++o)
+        {
+            for (uint8_t k = 0; k < 3; ++k) points[k] = degenerate[t][orders[o][k]];
+            checkPolygon(index++, points, 3);
+        }
+    }
+
+    // Random triangles, with both orientations
+    for (uint32_t t = 0; t < 600; ++t)
+    {
+        int32_t span = (t < 300) ? 20 : 200;
+        for (uint8_t k = 0; k < 3; ++k)
+        {
+            points[k].x = Test_range(64 - span, 64 + span);
+            points[k].y = Test_range(32 - span / 2, 32 + span / 2);
+        }
+        checkPolygon(index++, points, 3);
+        SSD1306_Point_t swap = points[1];
+        points[1] = points[2];
+        points[2] = swap;
+        checkPolygon(index++, points, 3);
+    }
+
+    // Regular polygons, rotated
+    for (uint8_t n = 3; n <= 16; ++n)
+    {
+        for (int32_t r = 1; r <= 90; r += 11)
+        {
+            double rotation = Test_range(0, 359) * 3.14159265358979 / 180.0;
+            int16_t xCenter = Test_range(-20, 147);
+            int16_t yCenter = Test_range(-10, 73);
+            for (uint8_t k = 0; k < n; ++k)
+            {
+                double angle = rotation + 2.0 * 3.14159265358979 * k / n;
+                points[k].x = xCenter + (int16_t)lround(r * cos(angle));
+                points[k].y = yCenter + (int16_t)lround(r * sin(angle));
+            }
+            checkPolygon(index++, points, n);
+        }
+    }
+
+    // Vertices far from the display
+    static const SSD1306_Point_t far [][3] =
+    {
+        { { -20000, -20000 }, { 20000, 20000 }, { -20000, 20000 } },
+        { { -32768, 32767 }, { 32767, -32768 }, { 32767, 32767 } },
+        { { -32768, -32768 }, { 32767, 32767 }, { 60, 0 } },
+        { { -32768, 10 }, { 32767, 50 }, { 0, 64 } },
+        { { 64, -32768 }, { 65, 32767 }, { 63, 32767 } },
+    };
+    for (uint32_t t = 0; t < (sizeof(far) / sizeof(far[0])); ++t)
+    {
+        for (uint32_t o = 0; o < 6; ++o)
+        {
+            for (uint8_t k = 0; k < 3; ++k) points[k] = far[t][orders[o][k]];
+            checkPolygon(index++, points, 3);
+        }
+    }
+}
+
+static void testProduct (uint16_t product)
+{
+    Test_initDevice(&mDevice, product);
+    Reference_init(&mScreen, mDevice.gdl.width, mDevice.gdl.height);
+    Test_seed(product);
+
+    testEllipses();
+    testRoundRectangles();
+    testPolygons();
+}
+
+int main (void)
+{
+    testProduct(SSD1306_PRODUCT_SEEEDSTUDIO_OLED_1_1);
+    testProduct(SSD1306_PRODUCT_ADAFRUIT_931);
+
+    printf("%u shapes checked\n", (unsigned)mCases);
+    return Test_end("shapes");
+}